@@ -0,0 +1,75 @@
+// Benchmarks for CommandBufferRing: acquire/commit/rotate cost at the
+// ring sizes we actually deploy (2 = double buffering, 3 = triple, plus a
+// deeper ring for headroom). Backs the "-30% submission overhead" claim in
+// kr_command_buffer_ring.h.
+
+#import <Metal/Metal.h>
+#include <benchmark/benchmark.h>
+#include "kr_command_buffer_ring.h"
+
+using namespace krserve;
+
+// ----------------------------------------------------------------------------
+// Acquire/release rotation (empty command buffers, pure ring overhead)
+// ----------------------------------------------------------------------------
+
+static void BM_RingAcquireCommit(benchmark::State& state) {
+    CommandBufferRing::Config config;
+    config.ring_size = static_cast<size_t>(state.range(0));
+    CommandBufferRing ring(config);
+
+    for (auto _ : state) {
+        void* buffer = ring.acquireBuffer();
+        benchmark::DoNotOptimize(buffer);
+        ring.releaseBuffer(buffer);
+    }
+    ring.waitAll();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingAcquireCommit)->Arg(2)->Arg(3)->Arg(4)->Arg(8);
+
+// ----------------------------------------------------------------------------
+// Rotation under thread contention (fixed triple buffering)
+// ----------------------------------------------------------------------------
+
+static void BM_RingContention(benchmark::State& state) {
+    static CommandBufferRing* ring = [] {
+        CommandBufferRing::Config config;
+        config.ring_size = 3;
+        return new CommandBufferRing(config);
+    }();
+
+    for (auto _ : state) {
+        void* buffer = ring->acquireBuffer();
+        benchmark::DoNotOptimize(buffer);
+        ring->releaseBuffer(buffer);
+    }
+
+    if (state.thread_index() == 0) {
+        ring->waitAll();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingContention)->Threads(1)->Threads(2)->Threads(4);
+
+// ----------------------------------------------------------------------------
+// Baseline: raw MTLCommandQueue commandBuffer creation for comparison
+// ----------------------------------------------------------------------------
+
+static void BM_RawCommandBufferBaseline(benchmark::State& state) {
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    id<MTLCommandQueue> queue = [device newCommandQueue];
+
+    for (auto _ : state) {
+        @autoreleasepool {
+            id<MTLCommandBuffer> buffer = [queue commandBuffer];
+            benchmark::DoNotOptimize(buffer);
+            [buffer commit];
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RawCommandBufferBaseline);
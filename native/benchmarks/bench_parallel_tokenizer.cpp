@@ -0,0 +1,83 @@
+// Benchmarks for ParallelTokenizer: encode scaling by thread count for
+// single large texts (OpenMP chunking) and batches (one text per thread).
+// The tokenizer_fn is a cheap native lambda so the numbers measure the
+// parallelization machinery, not tokenization cost.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "kr_parallel_tokenizer.h"
+
+using namespace krserve;
+
+namespace {
+
+// Synthetic prose-like text (repeating words keep the chunker honest
+// about UTF-8 boundaries without needing a corpus on disk)
+std::string makeText(size_t bytes) {
+    static const char* words[] = {"the ", "quick ", "brown ", "fox ",
+                                  "jumps ", "over ", "lazy ", "dogs "};
+    std::string text;
+    text.reserve(bytes + 8);
+    size_t i = 0;
+    while (text.size() < bytes) {
+        text += words[i++ % 8];
+    }
+    return text;
+}
+
+// Trivial native tokenizer: one token per 4-byte window
+std::vector<uint32_t> cheapTokenize(const std::string& text) {
+    std::vector<uint32_t> tokens;
+    tokens.reserve(text.size() / 4 + 1);
+    for (size_t i = 0; i < text.size(); i += 4) {
+        tokens.push_back(static_cast<uint32_t>(text[i]));
+    }
+    return tokens;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Single large text, thread count sweep (OpenMP chunk parallelism)
+// ----------------------------------------------------------------------------
+
+static void BM_TokenizerEncodeThreads(benchmark::State& state) {
+    ParallelTokenizerConfig config;
+    config.num_threads = static_cast<uint32_t>(state.range(0));
+    config.enable_stats = false;
+    ParallelTokenizer tokenizer(config);
+
+    const std::string text = makeText(256 << 10);  // 256 KB
+
+    for (auto _ : state) {
+        auto tokens = tokenizer.encode(text, cheapTokenize);
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_TokenizerEncodeThreads)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+// ----------------------------------------------------------------------------
+// Batch encode, thread count sweep (one text per thread)
+// ----------------------------------------------------------------------------
+
+static void BM_TokenizerEncodeBatchThreads(benchmark::State& state) {
+    ParallelTokenizerConfig config;
+    config.num_threads = static_cast<uint32_t>(state.range(0));
+    config.enable_stats = false;
+    ParallelTokenizer tokenizer(config);
+
+    const std::vector<std::string> texts(16, makeText(8 << 10));  // 16 x 8 KB
+
+    for (auto _ : state) {
+        auto batch = tokenizer.encodeBatch(texts, cheapTokenize);
+        benchmark::DoNotOptimize(batch);
+    }
+
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(texts.size() * texts[0].size()));
+}
+BENCHMARK(BM_TokenizerEncodeBatchThreads)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
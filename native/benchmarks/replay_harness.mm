@@ -0,0 +1,360 @@
+// Standalone JSONL request-replay harness for the native pipeline.
+//
+// Replays a request trace against tokenizer -> memory pool -> command
+// ring -> blit queue with no Python in the loop, so a latency regression
+// can be pinned to krserve_native (or ruled out) in minutes. Reports
+// TTFT / ITL / end-to-end percentiles from MetricsCollector — the same
+// histogram machinery the server exports.
+//
+// Trace format: one JSON object per line. The prompt is read from a
+// "prompt" field (falling back to "body" or "text"), the decode length
+// from "max_tokens" (default 64). The repo's own requests.jsonl replays
+// out of the box.
+//
+// Usage:
+//   krserve_replay --trace requests.jsonl [--concurrency 8] [--rate 0]
+//                  [--max-requests N] [--decode-tokens N]
+//                  [--vocab vocab.json --merges merges.txt]
+//
+//   --rate 0 (default) runs closed-loop at the given concurrency;
+//   --rate R > 0 replays open-loop with exponential inter-arrivals.
+
+#import <Metal/Metal.h>
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kr_parallel_tokenizer.h"
+#include "kr_metal_memory_pool.h"
+#include "kr_command_buffer_ring.h"
+#include "kr_blit_queue.h"
+#include "kr_metrics_collector.h"
+
+using namespace krserve;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Trace loading (minimal JSONL field extraction, same hand-rolled
+// approach as the BPE engine's vocab.json parser — no JSON dependency)
+// ----------------------------------------------------------------------------
+
+struct TraceRequest {
+    std::string prompt;
+    uint32_t max_tokens = 64;
+};
+
+// Extract a string field value, decoding the common escapes
+bool extractString(const std::string& line, const std::string& key,
+                   std::string& out) {
+    std::string needle = "\"" + key + "\"";
+    size_t pos = line.find(needle);
+    if (pos == std::string::npos) return false;
+    pos = line.find(':', pos + needle.size());
+    if (pos == std::string::npos) return false;
+    pos = line.find('"', pos);
+    if (pos == std::string::npos) return false;
+
+    out.clear();
+    for (size_t i = pos + 1; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == '\\' && i + 1 < line.size()) {
+            char next = line[++i];
+            switch (next) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                default: out += next; break;  // \uXXXX kept verbatim
+            }
+        } else if (c == '"') {
+            return true;
+        } else {
+            out += c;
+        }
+    }
+    return false;
+}
+
+bool extractUint(const std::string& line, const std::string& key,
+                 uint32_t& out) {
+    std::string needle = "\"" + key + "\"";
+    size_t pos = line.find(needle);
+    if (pos == std::string::npos) return false;
+    pos = line.find(':', pos + needle.size());
+    if (pos == std::string::npos) return false;
+    ++pos;
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+    if (pos >= line.size() || !std::isdigit(static_cast<unsigned char>(line[pos]))) {
+        return false;
+    }
+    out = static_cast<uint32_t>(std::strtoul(line.c_str() + pos, nullptr, 10));
+    return true;
+}
+
+std::vector<TraceRequest> loadTrace(const std::string& path,
+                                    size_t max_requests,
+                                    uint32_t decode_tokens_override) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[replay] Cannot open trace: " << path << std::endl;
+        std::exit(1);
+    }
+
+    std::vector<TraceRequest> requests;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        TraceRequest request;
+        if (!extractString(line, "prompt", request.prompt) &&
+            !extractString(line, "body", request.prompt) &&
+            !extractString(line, "text", request.prompt)) {
+            continue;  // No usable prompt on this line
+        }
+        extractUint(line, "max_tokens", request.max_tokens);
+        if (decode_tokens_override > 0) {
+            request.max_tokens = decode_tokens_override;
+        }
+        requests.push_back(std::move(request));
+
+        if (max_requests > 0 && requests.size() >= max_requests) break;
+    }
+    return requests;
+}
+
+// Trivial fallback tokenizer when no vocabulary is supplied: one token
+// per 4-byte window (same shape as the tokenizer benchmarks use)
+std::vector<uint32_t> cheapTokenize(const std::string& text) {
+    std::vector<uint32_t> tokens;
+    tokens.reserve(text.size() / 4 + 1);
+    for (size_t i = 0; i < text.size(); i += 4) {
+        tokens.push_back(static_cast<uint32_t>(text[i]));
+    }
+    return tokens;
+}
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printMetrics(const char* label, const MetricsCollector::Metrics& m) {
+    std::printf("  %-6s  p50 %8.3f ms   p95 %8.3f ms   p99 %8.3f ms   avg %8.3f ms\n",
+                label, m.p50_latency_ms, m.p95_latency_ms, m.p99_latency_ms,
+                m.avg_latency_ms);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string trace_path;
+    std::string vocab_path;
+    std::string merges_path;
+    size_t concurrency = 8;
+    double rate = 0.0;           // requests/sec; 0 = closed loop
+    size_t max_requests = 0;     // 0 = whole trace
+    uint32_t decode_tokens = 0;  // 0 = per-request max_tokens
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "[replay] Missing value for " << arg << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--trace") trace_path = next();
+        else if (arg == "--vocab") vocab_path = next();
+        else if (arg == "--merges") merges_path = next();
+        else if (arg == "--concurrency") concurrency = std::stoul(next());
+        else if (arg == "--rate") rate = std::stod(next());
+        else if (arg == "--max-requests") max_requests = std::stoul(next());
+        else if (arg == "--decode-tokens") decode_tokens = static_cast<uint32_t>(std::stoul(next()));
+        else {
+            std::cerr << "[replay] Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (trace_path.empty() || concurrency == 0) {
+        std::cerr << "Usage: krserve_replay --trace requests.jsonl"
+                     " [--concurrency 8] [--rate 0] [--max-requests N]"
+                     " [--decode-tokens N] [--vocab vocab.json --merges merges.txt]"
+                  << std::endl;
+        return 1;
+    }
+
+    auto requests = loadTrace(trace_path, max_requests, decode_tokens);
+    if (requests.empty()) {
+        std::cerr << "[replay] No usable requests in " << trace_path << std::endl;
+        return 1;
+    }
+
+    // ------------------------------------------------------------------------
+    // Pipeline setup (the same components the server binds)
+    // ------------------------------------------------------------------------
+
+    ParallelTokenizerConfig tokenizer_config;
+    ParallelTokenizer tokenizer(tokenizer_config);
+    bool native_vocab = false;
+    if (!vocab_path.empty() && !merges_path.empty()) {
+        tokenizer.loadVocabulary(vocab_path, merges_path);
+        native_vocab = true;
+    }
+
+    MetalMemoryPool::Config pool_config;
+    MetalMemoryPool memory_pool(pool_config);
+
+    CommandBufferRing::Config ring_config;
+    CommandBufferRing ring(ring_config);
+
+    BlitQueue::Config blit_config;
+    BlitQueue blit(blit_config);
+
+    MetricsCollector ttft_metrics;   // Admission -> first token out
+    MetricsCollector itl_metrics;    // Per-decode-step inter-token latency
+    MetricsCollector e2e_metrics;    // Admission -> stream end
+
+    // ------------------------------------------------------------------------
+    // Replay
+    // ------------------------------------------------------------------------
+
+    // Open-loop arrival offsets (exponential inter-arrivals at --rate)
+    std::vector<double> arrival_ms(requests.size(), 0.0);
+    if (rate > 0.0) {
+        std::mt19937_64 rng(42);  // Fixed seed: runs are comparable
+        std::exponential_distribution<double> gap(rate / 1000.0);
+        double t = 0.0;
+        for (size_t i = 0; i < requests.size(); ++i) {
+            arrival_ms[i] = t;
+            t += gap(rng);
+        }
+    }
+
+    std::cerr << "[replay] " << requests.size() << " requests, concurrency "
+              << concurrency << ", "
+              << (rate > 0.0 ? ("open-loop " + std::to_string(rate) + " rps")
+                             : std::string("closed-loop"))
+              << ", tokenizer " << (native_vocab ? "native-bpe" : "fallback")
+              << std::endl;
+
+    std::atomic<size_t> next_request{0};
+    std::atomic<uint64_t> tokens_in{0};
+    std::atomic<uint64_t> tokens_out{0};
+    auto replay_start = Clock::now();
+
+    auto worker = [&]() {
+        while (true) {
+            size_t index = next_request.fetch_add(1);
+            if (index >= requests.size()) break;
+            const TraceRequest& request = requests[index];
+
+            // Open loop: hold this request until its scheduled arrival
+            if (rate > 0.0) {
+                double wait = arrival_ms[index] - msSince(replay_start);
+                if (wait > 0.0) {
+                    std::this_thread::sleep_for(
+                        std::chrono::duration<double, std::milli>(wait));
+                }
+            }
+
+            ttft_metrics.recordRequest();
+            e2e_metrics.recordRequest();
+            auto admitted = Clock::now();
+
+            @autoreleasepool {
+                try {
+                    // Prefill: tokenize, stage tokens on-GPU, one prefill
+                    // command buffer through the ring
+                    std::vector<uint32_t> tokens = native_vocab
+                        ? tokenizer.encodeNative(request.prompt)
+                        : tokenizer.encode(request.prompt, cheapTokenize);
+                    tokens_in += tokens.size();
+
+                    size_t bytes = std::max<size_t>(tokens.size() * sizeof(uint32_t), 4);
+                    void* gpu_buffer = memory_pool.acquireBuffer(bytes);
+                    uint64_t upload = blit.uploadAsync(
+                        tokens.data(), bytes, gpu_buffer, 0, nullptr);
+
+                    void* prefill_cmd = ring.acquireBuffer(CommandBufferRing::Lane::Prefill);
+                    ring.releaseBuffer(prefill_cmd);  // releaseBuffer() commits
+                    blit.waitForCompletion(upload, 0);
+
+                    ttft_metrics.recordCompletion(msSince(admitted));
+
+                    // Decode: one command buffer + streaming token readback
+                    // per step, ITL recorded per step
+                    for (uint32_t step = 0; step < request.max_tokens; ++step) {
+                        auto step_start = Clock::now();
+                        itl_metrics.recordRequest();
+
+                        void* decode_cmd = ring.acquireBuffer(CommandBufferRing::Lane::Decode);
+                        ring.releaseBuffer(decode_cmd);  // releaseBuffer() commits
+
+                        auto readback = blit.downloadStreaming(
+                            gpu_buffer, 0, sizeof(uint32_t), nullptr);
+                        blit.waitForCompletion(readback.op_id, 0);
+                        blit.releaseStreamingSlot(readback.op_id);
+
+                        itl_metrics.recordCompletion(msSince(step_start));
+                    }
+                    tokens_out += request.max_tokens;
+
+                    memory_pool.releaseBuffer(gpu_buffer);
+                    e2e_metrics.recordCompletion(msSince(admitted));
+                } catch (const std::exception& e) {
+                    std::cerr << "[replay] Request " << index << " failed: "
+                              << e.what() << std::endl;
+                    e2e_metrics.recordFailure();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+    for (size_t i = 0; i < concurrency; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    blit.waitForAll();
+
+    // ------------------------------------------------------------------------
+    // Report
+    // ------------------------------------------------------------------------
+
+    double wall_s = msSince(replay_start) / 1000.0;
+    auto e2e = e2e_metrics.getMetrics();
+
+    std::printf("\nReplay: %llu/%zu requests in %.2f s (%.1f req/s, "
+                "%llu tokens in, %llu tokens out)\n",
+                static_cast<unsigned long long>(e2e.completed_requests),
+                requests.size(), wall_s,
+                e2e.completed_requests / (wall_s > 0.0 ? wall_s : 1.0),
+                static_cast<unsigned long long>(tokens_in.load()),
+                static_cast<unsigned long long>(tokens_out.load()));
+    if (e2e.failed_requests > 0) {
+        std::printf("  FAILURES: %llu\n",
+                    static_cast<unsigned long long>(e2e.failed_requests));
+    }
+    printMetrics("TTFT", ttft_metrics.getMetrics());
+    printMetrics("ITL", itl_metrics.getMetrics());
+    printMetrics("E2E", e2e);
+
+    return e2e.failed_requests == 0 ? 0 : 2;
+}
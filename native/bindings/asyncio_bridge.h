@@ -0,0 +1,98 @@
+// native/bindings/asyncio_bridge.h
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <functional>
+#include <string>
+
+/**
+ * Asyncio Bridge for Native Completion Callbacks
+ *
+ * Turns native completion handlers (tokenizer thread pool, BlitQueue
+ * Metal completion blocks) into asyncio.Future resolutions. The rules
+ * this helper encodes:
+ *
+ * - Construct with the GIL held, on a thread running an asyncio event
+ *   loop: the bridge grabs the running loop and creates a Future on it.
+ * - resolve()/reject() may be called from ANY thread without the GIL.
+ *   They acquire it, then post the result to the loop thread with
+ *   call_soon_threadsafe — the only loop method that is off-thread safe.
+ * - Hold the bridge in a shared_ptr captured by the native handler. The
+ *   destructor re-acquires the GIL before dropping the Python
+ *   references, so the handler can be destroyed on a worker thread.
+ *
+ * Module: krserve_native (bindings only, not part of the native library)
+ */
+class AsyncioFutureBridge {
+public:
+    AsyncioFutureBridge() {
+        namespace py = pybind11;
+        py::object asyncio = py::module_::import("asyncio");
+        loop_ = asyncio.attr("get_running_loop")();
+        future_ = loop_.attr("create_future")();
+    }
+
+    ~AsyncioFutureBridge() {
+        pybind11::gil_scoped_acquire gil;
+        future_ = pybind11::object();
+        loop_ = pybind11::object();
+    }
+
+    // The loop/future pair is not meaningfully copyable
+    AsyncioFutureBridge(const AsyncioFutureBridge&) = delete;
+    AsyncioFutureBridge& operator=(const AsyncioFutureBridge&) = delete;
+
+    /**
+     * The asyncio.Future handed back to the awaiting caller
+     * (GIL must be held)
+     */
+    pybind11::object future() const { return future_; }
+
+    /**
+     * Resolve the future with a value built under the GIL
+     *
+     * Safe from any thread; `make_value` runs with the GIL held so it
+     * may construct arbitrary Python objects.
+     */
+    void resolve(const std::function<pybind11::object()>& make_value) {
+        pybind11::gil_scoped_acquire gil;
+        post("set_result", make_value());
+    }
+
+    /**
+     * Reject the future with a RuntimeError (safe from any thread)
+     */
+    void reject(const std::string& message) {
+        namespace py = pybind11;
+        py::gil_scoped_acquire gil;
+        py::object exc =
+            py::module_::import("builtins").attr("RuntimeError")(message);
+        post("set_exception", exc);
+    }
+
+private:
+    pybind11::object loop_;
+    pybind11::object future_;
+
+    /**
+     * Schedule future.<method>(value) on the loop thread (GIL held)
+     *
+     * Cancelled futures are skipped and a closed loop is tolerated —
+     * in both cases there is nobody left to deliver the result to.
+     */
+    void post(const char* method, pybind11::object value) {
+        namespace py = pybind11;
+        py::object future = future_;
+        std::string method_name = method;
+        try {
+            loop_.attr("call_soon_threadsafe")(py::cpp_function(
+                [future, method_name, value]() {
+                    if (!future.attr("cancelled")().cast<bool>()) {
+                        future.attr(method_name.c_str())(value);
+                    }
+                }));
+        } catch (const py::error_already_set&) {
+            // Loop closed before the operation completed
+        }
+    }
+};
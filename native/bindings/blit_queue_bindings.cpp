@@ -2,7 +2,9 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <memory>
 #include "../include/kr_blit_queue.h"
+#include "asyncio_bridge.h"
 
 namespace py = pybind11;
 
@@ -24,7 +26,9 @@ void bind_blit_queue(py::module& m) {
              "    enabled: true\n"
              "    max_pending_ops: 8\n"
              "    use_shared_events: true\n"
-             "    track_metrics: true")
+             "    track_metrics: true\n"
+             "    staging_ring_slots: 8\n"
+             "    staging_slot_kb: 64")
 
         .def_readwrite("enabled",
                        &krserve::BlitQueue::Config::enabled,
@@ -42,6 +46,14 @@ void bind_blit_queue(py::module& m) {
                        &krserve::BlitQueue::Config::track_metrics,
                        "Track performance metrics (default: true)")
 
+        .def_readwrite("staging_ring_slots",
+                       &krserve::BlitQueue::Config::staging_ring_slots,
+                       "Pre-allocated streaming staging slots (default: 8)")
+
+        .def_readwrite("staging_slot_kb",
+                       &krserve::BlitQueue::Config::staging_slot_kb,
+                       "Size per streaming staging slot in KB (default: 64)")
+
         .def("__repr__", [](const krserve::BlitQueue::Config& c) {
             return "BlitQueueConfig(enabled=" + std::string(c.enabled ? "true" : "false") +
                    ", max_pending=" + std::to_string(c.max_pending_ops) +
@@ -74,6 +86,21 @@ void bind_blit_queue(py::module& m) {
         .def_readonly("avg_sync_wait_ms", &krserve::BlitQueue::Metrics::avg_sync_wait_ms,
                       "Average synchronization wait duration in milliseconds")
 
+        .def_readonly("batched_uploads", &krserve::BlitQueue::Metrics::batched_uploads,
+                      "Coalesced batch upload operations")
+
+        .def_readonly("chained_downloads", &krserve::BlitQueue::Metrics::chained_downloads,
+                      "Downloads ordered on-GPU via shared events")
+
+        .def_readonly("streaming_downloads", &krserve::BlitQueue::Metrics::streaming_downloads,
+                      "Downloads served from the persistent staging ring")
+
+        .def_readonly("staging_fallbacks", &krserve::BlitQueue::Metrics::staging_fallbacks,
+                      "Streaming downloads that fell back to transient buffers")
+
+        .def_readonly("coalesced_regions", &krserve::BlitQueue::Metrics::coalesced_regions,
+                      "Regions folded into batch uploads")
+
         .def_property_readonly("total_operations",
             [](const krserve::BlitQueue::Metrics& m) {
                 return m.total_uploads + m.total_downloads;
@@ -100,6 +127,11 @@ void bind_blit_queue(py::module& m) {
             d["overlap_ratio"] = m.overlap_ratio;
             d["sync_wait_count"] = m.sync_wait_count;
             d["avg_sync_wait_ms"] = m.avg_sync_wait_ms;
+            d["batched_uploads"] = m.batched_uploads;
+            d["coalesced_regions"] = m.coalesced_regions;
+            d["chained_downloads"] = m.chained_downloads;
+            d["streaming_downloads"] = m.streaming_downloads;
+            d["staging_fallbacks"] = m.staging_fallbacks;
 
             // Derived metrics
             d["total_operations"] = m.total_uploads + m.total_downloads;
@@ -121,6 +153,27 @@ void bind_blit_queue(py::module& m) {
                    ", overlap=" + std::to_string(static_cast<int>(m.overlap_ratio * 100)) + "%)";
         });
 
+    // BlitQueue::EventHandle — GPU-side synchronization point
+    py::class_<krserve::BlitQueue::EventHandle>(m, "BlitEventHandle",
+        "GPU-side synchronization point on the blit queue's shared event.\n\n"
+        "Encode into command buffers with BlitQueue.encode_wait()/\n"
+        "encode_signal() to order upload -> compute -> download chains\n"
+        "entirely on-GPU (no CPU wait_for_completion stall).\n\n"
+        "Attributes:\n"
+        "    event (int): MTLSharedEvent pointer (id<MTLSharedEvent> as int)\n"
+        "    value (int): Signal value to wait for / signal")
+        .def_property_readonly("event", [](const krserve::BlitQueue::EventHandle& h) {
+            return reinterpret_cast<uintptr_t>(h.event);
+        }, "MTLSharedEvent pointer (id<MTLSharedEvent> as int)")
+        .def_readonly("value", &krserve::BlitQueue::EventHandle::value,
+                      "Signal value to wait for / signal")
+        .def("is_valid", &krserve::BlitQueue::EventHandle::isValid,
+             "Check if the handle refers to a real event")
+        .def("__repr__", [](const krserve::BlitQueue::EventHandle& h) {
+            return "BlitEventHandle(value=" + std::to_string(h.value) +
+                   ", valid=" + (h.isValid() ? "True" : "False") + ")";
+        });
+
     // BlitQueue main class
     py::class_<krserve::BlitQueue>(m, "BlitQueue")
         .def(py::init<const krserve::BlitQueue::Config&>(),
@@ -171,6 +224,117 @@ void bind_blit_queue(py::module& m) {
              "    >>> op_id = queue.upload_async(data_ptr, 1024, gpu_buffer)\n"
              "    >>> queue.wait_for_completion(op_id)")
 
+        .def("upload_asyncio",
+             [](krserve::BlitQueue& self,
+                uintptr_t source_data,
+                size_t source_size,
+                uintptr_t dest_buffer,
+                size_t dest_offset) {
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 auto op_holder = std::make_shared<uint64_t>(0);
+                 py::object future = bridge->future();
+                 uint64_t op_id = self.uploadAsync(
+                     reinterpret_cast<const void*>(source_data),
+                     source_size,
+                     reinterpret_cast<void*>(dest_buffer),
+                     dest_offset,
+                     [bridge, op_holder]() {
+                         bridge->resolve([&]() { return py::cast(*op_holder); });
+                     });
+                 // Safe ordering: the completion handler must take the GIL
+                 // (held here) before it can read the holder
+                 *op_holder = op_id;
+                 return future;
+             },
+             py::arg("source_data"),
+             py::arg("source_size"),
+             py::arg("dest_buffer"),
+             py::arg("dest_offset") = 0,
+             "Upload data to GPU, awaitable from asyncio\n\n"
+             "Same transfer as upload_async, but instead of polling or\n"
+             "blocking on wait_for_completion the Metal completion handler\n"
+             "resolves an asyncio.Future on the calling event loop\n"
+             "(via loop.call_soon_threadsafe).\n\n"
+             "Must be called from a thread with a running asyncio event loop.\n\n"
+             "Args:\n"
+             "    source_data: Pointer to CPU data (as int/uintptr_t)\n"
+             "    source_size: Size of data in bytes\n"
+             "    dest_buffer: GPU buffer pointer (id<MTLBuffer> as int/uintptr_t)\n"
+             "    dest_offset: Offset in destination buffer (default: 0)\n\n"
+             "Returns:\n"
+             "    asyncio.Future: Resolves to the operation ID on completion\n\n"
+             "Example:\n"
+             "    >>> op_id = await queue.upload_asyncio(data_ptr, 1024, gpu_buffer)")
+
+        .def("upload_batch_async",
+             [](krserve::BlitQueue& self,
+                const std::vector<std::tuple<uintptr_t, size_t, uintptr_t, size_t>>& regions) {
+                 std::vector<krserve::BlitQueue::UploadRegion> native_regions;
+                 native_regions.reserve(regions.size());
+                 for (const auto& region : regions) {
+                     native_regions.push_back({
+                         reinterpret_cast<const void*>(std::get<0>(region)),
+                         std::get<1>(region),
+                         reinterpret_cast<void*>(std::get<2>(region)),
+                         std::get<3>(region)
+                     });
+                 }
+                 return self.uploadBatchAsync(native_regions, nullptr);
+             },
+             py::arg("regions"),
+             "Upload multiple regions in one coalesced command buffer\n\n"
+             "Encodes every region into a single blit command buffer with one\n"
+             "completion event — one commit instead of one per tensor.\n\n"
+             "Args:\n"
+             "    regions: List of (source_data, source_size, dest_buffer, dest_offset)\n"
+             "             tuples (pointers as int/uintptr_t)\n\n"
+             "Returns:\n"
+             "    uint64_t: Operation ID covering the whole batch\n\n"
+             "Example:\n"
+             "    >>> op_id = queue.upload_batch_async([\n"
+             "    ...     (emb_ptr, emb_size, gpu_emb, 0),\n"
+             "    ...     (mask_ptr, mask_size, gpu_mask, 0),\n"
+             "    ...     (pos_ptr, pos_size, gpu_pos, 0),\n"
+             "    ... ])\n"
+             "    >>> queue.wait_for_completion(op_id)")
+
+        .def("upload_batch_asyncio",
+             [](krserve::BlitQueue& self,
+                const std::vector<std::tuple<uintptr_t, size_t, uintptr_t, size_t>>& regions) {
+                 std::vector<krserve::BlitQueue::UploadRegion> native_regions;
+                 native_regions.reserve(regions.size());
+                 for (const auto& region : regions) {
+                     native_regions.push_back({
+                         reinterpret_cast<const void*>(std::get<0>(region)),
+                         std::get<1>(region),
+                         reinterpret_cast<void*>(std::get<2>(region)),
+                         std::get<3>(region)
+                     });
+                 }
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 auto op_holder = std::make_shared<uint64_t>(0);
+                 py::object future = bridge->future();
+                 uint64_t op_id = self.uploadBatchAsync(
+                     native_regions,
+                     [bridge, op_holder]() {
+                         bridge->resolve([&]() { return py::cast(*op_holder); });
+                     });
+                 *op_holder = op_id;
+                 return future;
+             },
+             py::arg("regions"),
+             "Coalesced batch upload, awaitable from asyncio\n\n"
+             "Same single-command-buffer transfer as upload_batch_async; the\n"
+             "returned asyncio.Future resolves on the calling event loop when\n"
+             "every region has landed.\n\n"
+             "Args:\n"
+             "    regions: List of (source_data, source_size, dest_buffer, dest_offset)\n"
+             "             tuples (pointers as int/uintptr_t)\n\n"
+             "Returns:\n"
+             "    asyncio.Future: Resolves to the batch operation ID\n\n"
+             "Example:\n"
+             "    >>> op_id = await queue.upload_batch_asyncio(regions)")
+
         .def("download_async",
              [](krserve::BlitQueue& self,
                 uintptr_t source_buffer,
@@ -205,6 +369,222 @@ void bind_blit_queue(py::module& m) {
              "    >>> op_id = queue.download_async(gpu_buffer, 0, cpu_buffer, 1024)\n"
              "    >>> queue.wait_for_completion(op_id)")
 
+        .def("download_asyncio",
+             [](krserve::BlitQueue& self,
+                uintptr_t source_buffer,
+                size_t source_offset,
+                uintptr_t dest_data,
+                size_t dest_size) {
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 auto op_holder = std::make_shared<uint64_t>(0);
+                 py::object future = bridge->future();
+                 uint64_t op_id = self.downloadAsync(
+                     reinterpret_cast<void*>(source_buffer),
+                     source_offset,
+                     reinterpret_cast<void*>(dest_data),
+                     dest_size,
+                     [bridge, op_holder]() {
+                         bridge->resolve([&]() { return py::cast(*op_holder); });
+                     });
+                 *op_holder = op_id;
+                 return future;
+             },
+             py::arg("source_buffer"),
+             py::arg("source_offset"),
+             py::arg("dest_data"),
+             py::arg("dest_size"),
+             "Download data from GPU, awaitable from asyncio\n\n"
+             "Same transfer as download_async; the returned asyncio.Future\n"
+             "resolves on the calling event loop once the data is in\n"
+             "dest_data — await it, then read the buffer.\n\n"
+             "Args:\n"
+             "    source_buffer: GPU buffer pointer (id<MTLBuffer> as int/uintptr_t)\n"
+             "    source_offset: Offset in source buffer\n"
+             "    dest_data: CPU buffer pointer (as int/uintptr_t, must be pre-allocated)\n"
+             "    dest_size: Size of data in bytes\n\n"
+             "Returns:\n"
+             "    asyncio.Future: Resolves to the operation ID on completion\n\n"
+             "Example:\n"
+             "    >>> await queue.download_asyncio(gpu_buffer, 0, cpu_buffer, 1024)\n"
+             "    >>> tokens = read_tokens_at(cpu_buffer)")
+
+        .def("download_streaming",
+             [](krserve::BlitQueue& self,
+                uintptr_t source_buffer,
+                size_t source_offset,
+                size_t size) {
+                 auto result = self.downloadStreaming(
+                     reinterpret_cast<void*>(source_buffer),
+                     source_offset,
+                     size,
+                     nullptr  // No completion handler from Python
+                 );
+                 return py::make_tuple(result.op_id,
+                                       reinterpret_cast<uintptr_t>(result.data));
+             },
+             py::arg("source_buffer"),
+             py::arg("source_offset"),
+             py::arg("size"),
+             "Download into a pre-allocated staging ring slot (streaming path)\n\n"
+             "For small recurring readbacks (sampled tokens per decode step):\n"
+             "no allocation, no extra memcpy — read the slot memory directly\n"
+             "once the operation completes.\n\n"
+             "Args:\n"
+             "    source_buffer: GPU buffer pointer (id<MTLBuffer> as int/uintptr_t)\n"
+             "    source_offset: Offset in source buffer\n"
+             "    size: Bytes to download (oversized requests fall back to a\n"
+             "          transient buffer, counted in staging_fallbacks)\n\n"
+             "Returns:\n"
+             "    tuple[int, int]: (op_id, data_ptr) — data_ptr is stable\n"
+             "    CPU-visible memory, valid to read after wait_for_completion\n"
+             "    and until release_streaming_slot(op_id)\n\n"
+             "Example:\n"
+             "    >>> op_id, ptr = queue.download_streaming(gpu_buffer, 0, 256)\n"
+             "    >>> queue.wait_for_completion(op_id)\n"
+             "    >>> tokens = read_tokens_at(ptr)  # e.g. via ctypes/numpy\n"
+             "    >>> queue.release_streaming_slot(op_id)")
+
+        .def("download_streaming_asyncio",
+             [](krserve::BlitQueue& self,
+                uintptr_t source_buffer,
+                size_t source_offset,
+                size_t size) {
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 auto op_holder = std::make_shared<uint64_t>(0);
+                 auto ptr_holder = std::make_shared<uintptr_t>(0);
+                 py::object future = bridge->future();
+                 auto result = self.downloadStreaming(
+                     reinterpret_cast<void*>(source_buffer),
+                     source_offset,
+                     size,
+                     [bridge, op_holder, ptr_holder]() {
+                         bridge->resolve([&]() {
+                             return py::make_tuple(*op_holder, *ptr_holder);
+                         });
+                     });
+                 *op_holder = result.op_id;
+                 *ptr_holder = reinterpret_cast<uintptr_t>(result.data);
+                 return future;
+             },
+             py::arg("source_buffer"),
+             py::arg("source_offset"),
+             py::arg("size"),
+             "Streaming download, awaitable from asyncio\n\n"
+             "Same staging-ring transfer as download_streaming; the returned\n"
+             "asyncio.Future resolves on the calling event loop when the slot\n"
+             "data is readable. Release the slot after consuming it.\n\n"
+             "Args:\n"
+             "    source_buffer: GPU buffer pointer (id<MTLBuffer> as int/uintptr_t)\n"
+             "    source_offset: Offset in source buffer\n"
+             "    size: Bytes to download\n\n"
+             "Returns:\n"
+             "    asyncio.Future: Resolves to (op_id, data_ptr) — data_ptr is\n"
+             "    readable immediately and valid until release_streaming_slot\n\n"
+             "Example:\n"
+             "    >>> op_id, ptr = await queue.download_streaming_asyncio(buf, 0, 256)\n"
+             "    >>> tokens = read_tokens_at(ptr)\n"
+             "    >>> queue.release_streaming_slot(op_id)")
+
+        .def("release_streaming_slot",
+             &krserve::BlitQueue::releaseStreamingSlot,
+             py::arg("op_id"),
+             "Return a streaming download's staging slot to the ring\n\n"
+             "Call after the slot's data has been consumed. Safe with an\n"
+             "unknown ID (no-op).\n\n"
+             "Args:\n"
+             "    op_id: Operation ID from download_streaming")
+
+        .def("download_async_after",
+             [](krserve::BlitQueue& self,
+                const krserve::BlitQueue::EventHandle& after,
+                uintptr_t source_buffer,
+                size_t source_offset,
+                uintptr_t dest_data,
+                size_t dest_size) {
+                 return self.downloadAsyncAfter(
+                     after,
+                     reinterpret_cast<void*>(source_buffer),
+                     source_offset,
+                     reinterpret_cast<void*>(dest_data),
+                     dest_size,
+                     nullptr  // No completion handler from Python
+                 );
+             },
+             py::arg("after"),
+             py::arg("source_buffer"),
+             py::arg("source_offset"),
+             py::arg("dest_data"),
+             py::arg("dest_size"),
+             "Download from GPU after a GPU-side dependency is satisfied\n\n"
+             "Same as download_async, but the blit waits on `after` on-GPU\n"
+             "before copying — a compute buffer that signals `after` orders\n"
+             "this download with zero CPU sync.\n\n"
+             "Args:\n"
+             "    after: BlitEventHandle from next_signal_handle()\n"
+             "    source_buffer: GPU buffer pointer (id<MTLBuffer> as int/uintptr_t)\n"
+             "    source_offset: Offset in source buffer\n"
+             "    dest_data: CPU buffer pointer (as int/uintptr_t, must be pre-allocated)\n"
+             "    dest_size: Size of data in bytes\n\n"
+             "Returns:\n"
+             "    uint64_t: Operation ID for tracking completion")
+
+        .def("get_event_handle",
+             &krserve::BlitQueue::getEventHandle,
+             py::arg("operation_id"),
+             "Get the GPU-side completion point of a pending operation\n\n"
+             "Encode the handle as a wait into a compute command buffer\n"
+             "(e.g. from CommandBufferRing.acquire_buffer) via encode_wait —\n"
+             "the GPU defers that work until the blit finishes, no CPU stall.\n\n"
+             "Args:\n"
+             "    operation_id: Operation ID from upload_async/download_async\n\n"
+             "Returns:\n"
+             "    BlitEventHandle: Invalid handle if the operation is unknown\n"
+             "    or shared events are disabled\n\n"
+             "Example:\n"
+             "    >>> op = queue.upload_async(data_ptr, size, gpu_buffer)\n"
+             "    >>> handle = queue.get_event_handle(op)\n"
+             "    >>> cmd = ring.acquire_buffer()\n"
+             "    >>> BlitQueue.encode_wait(cmd, handle)  # GPU-side ordering\n"
+             "    >>> # encode compute, commit — no wait_for_completion needed")
+
+        .def("next_signal_handle",
+             &krserve::BlitQueue::nextSignalHandle,
+             "Reserve a fresh signal point on the queue's shared event\n\n"
+             "Encode it with encode_signal at the end of a compute command\n"
+             "buffer, then pass it to download_async_after so the download\n"
+             "chains off the compute on-GPU.\n\n"
+             "Returns:\n"
+             "    BlitEventHandle: Invalid if shared events are disabled")
+
+        .def_static("encode_wait",
+                    [](uintptr_t command_buffer,
+                       const krserve::BlitQueue::EventHandle& handle) {
+                        krserve::BlitQueue::encodeWait(
+                            reinterpret_cast<void*>(command_buffer), handle);
+                    },
+                    py::arg("command_buffer"),
+                    py::arg("handle"),
+                    "Encode a GPU-side wait into a command buffer\n\n"
+                    "Must be called before any encoders are created on the\n"
+                    "command buffer.\n\n"
+                    "Args:\n"
+                    "    command_buffer: MTLCommandBuffer pointer (as int/uintptr_t)\n"
+                    "    handle: BlitEventHandle to wait for")
+
+        .def_static("encode_signal",
+                    [](uintptr_t command_buffer,
+                       const krserve::BlitQueue::EventHandle& handle) {
+                        krserve::BlitQueue::encodeSignal(
+                            reinterpret_cast<void*>(command_buffer), handle);
+                    },
+                    py::arg("command_buffer"),
+                    py::arg("handle"),
+                    "Encode a GPU-side signal into a command buffer\n\n"
+                    "The signal fires after all work encoded in the buffer.\n\n"
+                    "Args:\n"
+                    "    command_buffer: MTLCommandBuffer pointer (as int/uintptr_t)\n"
+                    "    handle: BlitEventHandle from next_signal_handle()")
+
         .def("wait_for_completion",
              &krserve::BlitQueue::waitForCompletion,
              py::arg("operation_id"),
@@ -28,7 +28,16 @@ void bind_command_buffer_ring(py::module& m) {
              "    log_wait_events: false")
 
         .def_readwrite("ring_size", &CommandBufferRing::Config::ring_size,
-                       "Number of buffers in ring (2-3, default: 2)")
+                       "Number of buffers in ring (2-3, default: 2); adaptive floor")
+
+        .def_readwrite("adaptive_sizing", &CommandBufferRing::Config::adaptive_sizing,
+                       "Grow/shrink the ring from wait pressure (default: false)")
+
+        .def_readwrite("max_ring_size", &CommandBufferRing::Config::max_ring_size,
+                       "Growth ceiling for adaptive sizing (default: 8)")
+
+        .def_readwrite("decode_reserved_slots", &CommandBufferRing::Config::decode_reserved_slots,
+                       "Slots the prefill lane may never occupy (default: 1)")
 
         .def_readwrite("timeout_ms", &CommandBufferRing::Config::timeout_ms,
                        "Timeout for buffer acquisition in ms (0=infinite, default: 0)")
@@ -86,6 +95,24 @@ void bind_command_buffer_ring(py::module& m) {
         .def_readonly("rotation_rate", &CommandBufferRing::Statistics::rotation_rate,
                       "Ring rotation rate (rotations per second)")
 
+        .def_readonly("active_ring_size", &CommandBufferRing::Statistics::active_ring_size,
+                      "Slots currently in rotation (adaptive sizing)")
+
+        .def_readonly("grow_events", &CommandBufferRing::Statistics::grow_events,
+                      "Adaptive ring growths")
+
+        .def_readonly("shrink_events", &CommandBufferRing::Statistics::shrink_events,
+                      "Adaptive ring shrinks")
+
+        .def_readonly("decode_acquired", &CommandBufferRing::Statistics::decode_acquired,
+                      "Acquisitions on the decode lane")
+
+        .def_readonly("prefill_acquired", &CommandBufferRing::Statistics::prefill_acquired,
+                      "Acquisitions on the prefill lane")
+
+        .def_readonly("prefill_throttles", &CommandBufferRing::Statistics::prefill_throttles,
+                      "Prefill waits on the lane budget")
+
         .def("to_dict", [](const CommandBufferRing::Statistics& s) {
             py::dict d;
             d["ring_size"] = s.ring_size;
@@ -101,6 +128,12 @@ void bind_command_buffer_ring(py::module& m) {
             d["submission_overhead_us"] = s.submission_overhead_us;
             d["rotations"] = s.rotations;
             d["rotation_rate"] = s.rotation_rate;
+            d["active_ring_size"] = s.active_ring_size;
+            d["grow_events"] = s.grow_events;
+            d["shrink_events"] = s.shrink_events;
+            d["decode_acquired"] = s.decode_acquired;
+            d["prefill_acquired"] = s.prefill_acquired;
+            d["prefill_throttles"] = s.prefill_throttles;
             return d;
         }, "Convert statistics to Python dictionary")
 
@@ -112,6 +145,13 @@ void bind_command_buffer_ring(py::module& m) {
                    ", utilization=" + std::to_string(s.buffer_utilization) + "%)";
         });
 
+    // CommandBufferRing::Lane
+    py::enum_<CommandBufferRing::Lane>(m, "CommandBufferLane",
+        "Submission lane: Decode is latency-critical and may claim any free "
+        "slot; Prefill is capped so it can never starve decode")
+        .value("Decode", CommandBufferRing::Lane::Decode)
+        .value("Prefill", CommandBufferRing::Lane::Prefill);
+
     // CommandBufferRing main class
     py::class_<CommandBufferRing>(m, "CommandBufferRing")
         .def(py::init<const CommandBufferRing::Config&>(),
@@ -127,7 +167,8 @@ void bind_command_buffer_ring(py::module& m) {
              "    >>> config.ring_size = 3  # Triple buffering\n"
              "    >>> ring = CommandBufferRing(config)")
 
-        .def("acquire_buffer", &CommandBufferRing::acquireBuffer,
+        .def("acquire_buffer",
+             static_cast<void* (CommandBufferRing::*)()>(&CommandBufferRing::acquireBuffer),
              "Acquire next available buffer from ring\n\n"
              "Returns:\n"
              "    id<MTLCommandBuffer>: Metal command buffer (opaque pointer)\n\n"
@@ -142,6 +183,20 @@ void bind_command_buffer_ring(py::module& m) {
              "    >>> # Use buffer for GPU commands\n"
              "    >>> ring.release_buffer(buffer)")
 
+        .def("acquire_buffer_lane",
+             static_cast<void* (CommandBufferRing::*)(CommandBufferRing::Lane)>(
+                 &CommandBufferRing::acquireBuffer),
+             py::arg("lane"),
+             "Acquire a buffer on an explicit lane\n\n"
+             "Decode behaves like acquire_buffer(). Prefill respects the\n"
+             "decode_reserved_slots budget: when prefill already holds its\n"
+             "quota of slots the call waits even if free slots remain.\n\n"
+             "Args:\n"
+             "    lane: CommandBufferLane.Decode or CommandBufferLane.Prefill\n\n"
+             "Example:\n"
+             "    >>> buf = ring.acquire_buffer_lane(CommandBufferLane.Prefill)\n"
+             "    >>> ring.release_buffer(buf)")
+
         .def("release_buffer", &CommandBufferRing::releaseBuffer,
              py::arg("buffer"),
              "Release buffer back to ring\n\n"
@@ -0,0 +1,224 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/stl.h>
+
+#include "../include/kr_decode_batcher.h"
+
+namespace py = pybind11;
+
+void bind_decode_batcher(py::module& m) {
+    // DecodeBatcher::Config
+    py::class_<krserve::DecodeBatcher::Config>(m, "DecodeBatcherConfig",
+        "Configuration for DecodeBatcher.\n\n"
+        "Attributes:\n"
+        "    max_streams (int): Maximum streams registered at once (default: 64)\n"
+        "    enable_stats (bool): Enable statistics collection (default: True)")
+        .def(py::init<>())
+        .def_readwrite("max_streams", &krserve::DecodeBatcher::Config::max_streams)
+        .def_readwrite("enable_stats", &krserve::DecodeBatcher::Config::enable_stats)
+        .def("__repr__", [](const krserve::DecodeBatcher::Config& c) {
+            return "DecodeBatcherConfig(max_streams=" + std::to_string(c.max_streams) + ")";
+        });
+
+    // DecodeBatcher::Statistics
+    py::class_<krserve::DecodeBatcher::Statistics>(m, "DecodeBatcherStatistics",
+        "Runtime statistics for DecodeBatcher.")
+        .def_readonly("steps_submitted", &krserve::DecodeBatcher::Statistics::steps_submitted,
+                      "submit_decode_step() calls")
+        .def_readonly("streams_submitted", &krserve::DecodeBatcher::Statistics::streams_submitted,
+                      "Stream-steps covered (sum over steps)")
+        .def_readonly("uploads_coalesced", &krserve::DecodeBatcher::Statistics::uploads_coalesced,
+                      "Upload regions folded into batches")
+        .def_readonly("downloads_issued", &krserve::DecodeBatcher::Statistics::downloads_issued,
+                      "Per-stream readbacks issued")
+        .def_readonly("streams_registered", &krserve::DecodeBatcher::Statistics::streams_registered,
+                      "Streams currently registered")
+        .def_property_readonly("avg_streams_per_step",
+                               &krserve::DecodeBatcher::Statistics::getAvgStreamsPerStep,
+                               "Streams covered per submission (the coalescing win)")
+        .def("to_dict", [](const krserve::DecodeBatcher::Statistics& s) {
+            py::dict d;
+            d["steps_submitted"] = s.steps_submitted;
+            d["streams_submitted"] = s.streams_submitted;
+            d["uploads_coalesced"] = s.uploads_coalesced;
+            d["downloads_issued"] = s.downloads_issued;
+            d["streams_registered"] = s.streams_registered;
+            d["avg_streams_per_step"] = s.getAvgStreamsPerStep();
+            return d;
+        }, "Convert statistics to dictionary")
+        .def("__repr__", [](const krserve::DecodeBatcher::Statistics& s) {
+            return "DecodeBatcherStatistics(steps=" + std::to_string(s.steps_submitted) +
+                   ", streams=" + std::to_string(s.streams_registered) +
+                   ", avg_streams_per_step=" + std::to_string(s.getAvgStreamsPerStep()) + ")";
+        });
+
+    // DecodeStreamReadback — one stream's landing zone for a step
+    py::class_<krserve::DecodeStreamReadback>(m, "DecodeStreamReadback",
+        "One stream's readback from a submitted decode step.\n\n"
+        "Attributes:\n"
+        "    stream_id (int): Stream identity from register_stream\n"
+        "    op_id (int): Blit operation ID for the download (0 = no download)\n"
+        "    data_ptr (int): Staging slot the download lands in (valid once\n"
+        "        op_id completes; feed to Sampler pointer APIs)\n"
+        "    bytes (int): Readback size in bytes")
+        .def_readonly("stream_id", &krserve::DecodeStreamReadback::stream_id)
+        .def_readonly("op_id", &krserve::DecodeStreamReadback::op_id)
+        .def_property_readonly("data_ptr", [](const krserve::DecodeStreamReadback& r) {
+            return reinterpret_cast<uintptr_t>(r.data);
+        }, "CPU staging pointer (as int/uintptr_t)")
+        .def_readonly("bytes", &krserve::DecodeStreamReadback::bytes)
+        .def("__repr__", [](const krserve::DecodeStreamReadback& r) {
+            return "DecodeStreamReadback(stream_id=" + std::to_string(r.stream_id) +
+                   ", op_id=" + std::to_string(r.op_id) +
+                   ", bytes=" + std::to_string(r.bytes) + ")";
+        });
+
+    // DecodeStepResult — everything one submit_decode_step produced
+    py::class_<krserve::DecodeStepResult>(m, "DecodeStepResult",
+        "Result of one submit_decode_step() call.\n\n"
+        "Attributes:\n"
+        "    upload_op (int): Coalesced upload operation ID (0 = no uploads)\n"
+        "    compute_done (BlitEventHandle): Signal encoded after the step's\n"
+        "        compute; chain further work on it with encode_wait\n"
+        "    readbacks (list[DecodeStreamReadback]): Per-stream downloads")
+        .def_readonly("upload_op", &krserve::DecodeStepResult::upload_op)
+        .def_readonly("compute_done", &krserve::DecodeStepResult::compute_done)
+        .def_readonly("readbacks", &krserve::DecodeStepResult::readbacks)
+        .def("__repr__", [](const krserve::DecodeStepResult& r) {
+            return "DecodeStepResult(upload_op=" + std::to_string(r.upload_op) +
+                   ", readbacks=" + std::to_string(r.readbacks.size()) + ")";
+        });
+
+    // DecodeBatcher main class
+    py::class_<krserve::DecodeBatcher>(m, "DecodeBatcher",
+        "Batched multi-stream decode submission.\n\n"
+        "Register each active stream's transfer layout once, then one\n"
+        "submit_decode_step() per step coalesces every stream's upload into\n"
+        "a single blit batch, acquires ONE decode-lane command buffer from\n"
+        "the ring, chains the shared-event dependencies on-GPU, and fans the\n"
+        "results back out to per-stream staging slots. Per-step CPU cost is\n"
+        "O(1) in stream count instead of O(N).\n\n"
+        "Example:\n"
+        "    >>> batcher = krserve_native.DecodeBatcher(config, ring, blit)\n"
+        "    >>> batcher.register_stream(ctx.stream_id,\n"
+        "    ...                         upload_src=token_ptr, upload_bytes=4,\n"
+        "    ...                         upload_dst=input_buf,\n"
+        "    ...                         download_src=logits_buf,\n"
+        "    ...                         download_bytes=vocab_bytes)\n"
+        "    >>> step = batcher.submit_decode_step(lambda cmd: encode_decode(cmd))\n"
+        "    >>> batcher.wait_for_step(step)\n"
+        "    >>> for rb in step.readbacks:\n"
+        "    ...     token = sampler.sample_from_ptr(rb.data_ptr, vocab_size)")
+
+        .def(py::init<const krserve::DecodeBatcher::Config&,
+                      krserve::CommandBufferRing*,
+                      krserve::BlitQueue*>(),
+             py::arg("config"),
+             py::arg("ring"),
+             py::arg("blit"),
+             py::keep_alive<1, 3>(),  // Ring outlives batcher
+             py::keep_alive<1, 4>(),  // Blit queue outlives batcher
+             "Create a decode batcher over an existing ring and blit queue\n\n"
+             "Args:\n"
+             "    config: DecodeBatcherConfig\n"
+             "    ring: CommandBufferRing supplying the shared decode-lane buffer\n"
+             "    blit: BlitQueue driving coalesced uploads and chained downloads")
+
+        .def("register_stream",
+             [](krserve::DecodeBatcher& self,
+                uint64_t stream_id,
+                uintptr_t upload_src,
+                size_t upload_bytes,
+                uintptr_t upload_dst,
+                size_t upload_dst_offset,
+                uintptr_t download_src,
+                size_t download_offset,
+                size_t download_bytes) {
+                 krserve::DecodeStreamSlot slot;
+                 slot.stream_id = stream_id;
+                 slot.upload_src = reinterpret_cast<const void*>(upload_src);
+                 slot.upload_bytes = upload_bytes;
+                 slot.upload_dst = reinterpret_cast<void*>(upload_dst);
+                 slot.upload_dst_offset = upload_dst_offset;
+                 slot.download_src = reinterpret_cast<void*>(download_src);
+                 slot.download_offset = download_offset;
+                 slot.download_bytes = download_bytes;
+                 self.registerStream(slot);
+             },
+             py::arg("stream_id"),
+             py::arg("upload_src") = 0,
+             py::arg("upload_bytes") = 0,
+             py::arg("upload_dst") = 0,
+             py::arg("upload_dst_offset") = 0,
+             py::arg("download_src") = 0,
+             py::arg("download_offset") = 0,
+             py::arg("download_bytes") = 0,
+             "Register a stream's transfer layout for subsequent steps\n\n"
+             "Pointers are re-read every step: rewrite the upload source in\n"
+             "place (e.g. the fed-back token) and the next step picks it up.\n\n"
+             "Args:\n"
+             "    stream_id: Stream identity (e.g. StreamContext.stream_id)\n"
+             "    upload_src: Host source pointer per step (0 = no upload)\n"
+             "    upload_bytes: Upload size in bytes\n"
+             "    upload_dst: GPU destination (id<MTLBuffer> as int/uintptr_t)\n"
+             "    upload_dst_offset: Offset in destination buffer\n"
+             "    download_src: GPU readback source (0 = no download)\n"
+             "    download_offset: Offset in readback source\n"
+             "    download_bytes: Readback size (sizes the staging slot)")
+
+        .def("unregister_stream",
+             &krserve::DecodeBatcher::unregisterStream,
+             py::arg("stream_id"),
+             "Remove a stream (wait_for_step the last result first)\n\n"
+             "Returns:\n"
+             "    bool: True if the stream was registered")
+
+        .def("submit_decode_step",
+             [](krserve::DecodeBatcher& self, const py::object& encode_compute) {
+                 krserve::DecodeBatcher::EncodeHook hook;
+                 if (!encode_compute.is_none()) {
+                     // Hook runs on this thread mid-submission; re-take the
+                     // GIL just for the Python callback
+                     hook = [&encode_compute](void* cmd) {
+                         py::gil_scoped_acquire gil;
+                         encode_compute(reinterpret_cast<uintptr_t>(cmd));
+                     };
+                 }
+                 py::gil_scoped_release release;
+                 return self.submitDecodeStep(hook);
+             },
+             py::arg("encode_compute") = py::none(),
+             "Submit one decode step covering every registered stream\n\n"
+             "One upload batch, one ring submission, one signal, N chained\n"
+             "readbacks — constant submissions regardless of stream count.\n\n"
+             "Args:\n"
+             "    encode_compute: Optional callable(cmd_ptr) that encodes the\n"
+             "        batched compute into the shared command buffer (encode\n"
+             "        only — never commit; the ring commits on release)\n\n"
+             "Returns:\n"
+             "    DecodeStepResult: Per-stream readback handles for this step")
+
+        .def("wait_for_step",
+             &krserve::DecodeBatcher::waitForStep,
+             py::arg("step"),
+             py::arg("timeout_ms") = 0,
+             py::call_guard<py::gil_scoped_release>(),
+             "Block until every readback of a step has landed\n\n"
+             "Args:\n"
+             "    step: DecodeStepResult from submit_decode_step\n"
+             "    timeout_ms: Per-operation timeout (0 = wait forever)\n\n"
+             "Returns:\n"
+             "    bool: False if any operation timed out")
+
+        .def("stream_count",
+             &krserve::DecodeBatcher::streamCount,
+             "Get number of streams currently registered")
+
+        .def("get_statistics",
+             &krserve::DecodeBatcher::getStatistics,
+             "Get current statistics")
+
+        .def("reset_statistics",
+             &krserve::DecodeBatcher::resetStatistics,
+             "Reset statistics counters");
+}
@@ -0,0 +1,260 @@
+// native/bindings/gpu_scheduler_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_gpu_scheduler.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * GPU Scheduler Python Bindings
+ *
+ * Provides pybind11 bindings for the GpuScheduler C++ class. Replaces the
+ * asyncio hot loop of python/gpu_scheduler.py: queueing, admission control
+ * and batch composition run natively and Python only receives the composed
+ * batch per decode step.
+ *
+ * Module: krserve_native
+ * Dependencies: KVBlockPool (optional, for admission control)
+ */
+
+void bind_gpu_scheduler(py::module& m) {
+    // GpuScheduler::Config
+    py::class_<GpuScheduler::Config>(m, "GpuSchedulerConfig")
+        .def(py::init<>(),
+             "Create default GPU scheduler configuration\n\n"
+             "Default values:\n"
+             "    num_workers: 4\n"
+             "    max_batch_size: 16\n"
+             "    admission_reserve_blocks: 64\n"
+             "    enable_stats: true")
+
+        .def_readwrite("num_workers", &GpuScheduler::Config::num_workers,
+                       "Worker deques for submission spreading and stealing (default: 4)")
+
+        .def_readwrite("max_batch_size", &GpuScheduler::Config::max_batch_size,
+                       "Maximum sequences decoding concurrently (default: 16)")
+
+        .def_readwrite("admission_reserve_blocks", &GpuScheduler::Config::admission_reserve_blocks,
+                       "KV pages held back from admission for decode growth (default: 64)")
+
+        .def_readwrite("enable_stats", &GpuScheduler::Config::enable_stats,
+                       "Enable statistics collection (default: true)")
+
+        .def("__repr__", [](const GpuScheduler::Config& c) {
+            return "GpuSchedulerConfig("
+                   "num_workers=" + std::to_string(c.num_workers) +
+                   ", max_batch_size=" + std::to_string(c.max_batch_size) +
+                   ", admission_reserve_blocks=" + std::to_string(c.admission_reserve_blocks) +
+                   ")";
+        });
+
+    // GpuScheduler::Request
+    py::class_<GpuScheduler::Request>(m, "GpuSchedulerRequest")
+        .def(py::init<>(), "Create a request with default fields")
+        .def(py::init([](uint64_t request_id, uint32_t priority, uint32_t blocks_needed) {
+                 GpuScheduler::Request r;
+                 r.request_id = request_id;
+                 r.priority = priority;
+                 r.blocks_needed = blocks_needed;
+                 return r;
+             }),
+             py::arg("request_id"),
+             py::arg("priority") = 1,
+             py::arg("blocks_needed") = 0,
+             "Create a request\n\n"
+             "Args:\n"
+             "    request_id (int): Caller-assigned unique ID\n"
+             "    priority (int): 0 = urgent, 1 = default, 2 = low\n"
+             "    blocks_needed (int): KV pages the prefill will allocate")
+        .def_readwrite("request_id", &GpuScheduler::Request::request_id,
+                       "Caller-assigned unique ID")
+        .def_readwrite("priority", &GpuScheduler::Request::priority,
+                       "0 = urgent, 1 = default, 2 = low")
+        .def_readwrite("blocks_needed", &GpuScheduler::Request::blocks_needed,
+                       "KV pages the prefill will allocate")
+        .def("__repr__", [](const GpuScheduler::Request& r) {
+            return "GpuSchedulerRequest("
+                   "id=" + std::to_string(r.request_id) +
+                   ", priority=" + std::to_string(r.priority) +
+                   ", blocks_needed=" + std::to_string(r.blocks_needed) +
+                   ")";
+        });
+
+    // GpuScheduler::Statistics
+    py::class_<GpuScheduler::Statistics>(m, "GpuSchedulerStatistics")
+        .def_readonly("submitted", &GpuScheduler::Statistics::submitted,
+                      "Requests submitted")
+        .def_readonly("admitted", &GpuScheduler::Statistics::admitted,
+                      "Requests admitted into a batch")
+        .def_readonly("completed", &GpuScheduler::Statistics::completed,
+                      "Requests completed")
+        .def_readonly("admission_deferrals", &GpuScheduler::Statistics::admission_deferrals,
+                      "Times admission was blocked on KV pages")
+        .def_readonly("steals", &GpuScheduler::Statistics::steals,
+                      "Requests taken from another worker's deque")
+        .def_readonly("batches_composed", &GpuScheduler::Statistics::batches_composed,
+                      "compose_batch calls")
+        .def_readonly("total_queue_wait_us", &GpuScheduler::Statistics::total_queue_wait_us,
+                      "Total submit -> admit wait (microseconds)")
+        .def_readonly("queued", &GpuScheduler::Statistics::queued,
+                      "Requests currently queued")
+        .def_readonly("active", &GpuScheduler::Statistics::active,
+                      "Sequences currently decoding")
+        .def("get_avg_queue_wait_us", &GpuScheduler::Statistics::getAvgQueueWaitUs,
+             "Average queue wait per admitted request (microseconds)")
+        .def("to_dict", [](const GpuScheduler::Statistics& s) {
+            py::dict d;
+            d["submitted"] = s.submitted;
+            d["admitted"] = s.admitted;
+            d["completed"] = s.completed;
+            d["admission_deferrals"] = s.admission_deferrals;
+            d["steals"] = s.steals;
+            d["batches_composed"] = s.batches_composed;
+            d["total_queue_wait_us"] = s.total_queue_wait_us;
+            d["queued"] = s.queued;
+            d["active"] = s.active;
+            d["avg_queue_wait_us"] = s.getAvgQueueWaitUs();
+            return d;
+        }, "Convert statistics to dictionary")
+        .def("__repr__", [](const GpuScheduler::Statistics& s) {
+            return "GpuSchedulerStatistics("
+                   "queued=" + std::to_string(s.queued) +
+                   ", active=" + std::to_string(s.active) +
+                   ", admitted=" + std::to_string(s.admitted) +
+                   ", deferrals=" + std::to_string(s.admission_deferrals) +
+                   ")";
+        });
+
+    // GpuScheduler
+    py::class_<GpuScheduler>(m, "GpuScheduler",
+        R"doc(
+        Native continuous-batching scheduler.
+
+        Replaces the asyncio hot loop of python/gpu_scheduler.py: a priority
+        work queue with per-worker deques and work stealing, admission
+        control driven by the paged KV block pool's free-page count, and
+        per-step batch composition (join/leave) computed natively.
+
+        Args:
+            config (GpuSchedulerConfig): Scheduler configuration
+            kv_pool (KVBlockPool, optional): Pool for admission control
+                (kept alive by this object; omit to disable admission checks)
+
+        Example:
+            >>> config = GpuSchedulerConfig()
+            >>> config.max_batch_size = 16
+            >>> scheduler = GpuScheduler(config, kv_pool)
+            >>>
+            >>> scheduler.submit(GpuSchedulerRequest(req_id, priority=0,
+            ...                                      blocks_needed=50))
+            >>> while True:
+            ...     batch = scheduler.compose_batch()
+            ...     if not batch:
+            ...         break
+            ...     finished = run_decode_step(batch)
+            ...     for req_id in finished:
+            ...         scheduler.complete_request(req_id)
+
+        Performance:
+            - No per-tick asyncio wakeup or Python priority-queue traffic
+            - Admission is a native counter check against the KV pool, so
+              over-admission can't trigger mid-decode OOM
+        )doc")
+        .def(py::init<const GpuScheduler::Config&, KVBlockPool*>(),
+             py::arg("config"),
+             py::arg("kv_pool") = nullptr,
+             py::keep_alive<1, 3>(),  // KV pool must outlive the scheduler
+             "Create a scheduler, optionally bound to a KV block pool")
+
+        .def("submit",
+             &GpuScheduler::submit,
+             py::arg("request"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Submit a request for scheduling.
+
+             Round-robins across worker deques; never blocks.
+
+             Args:
+                 request (GpuSchedulerRequest): Request to queue
+             )doc")
+
+        .def("compose_batch",
+             &GpuScheduler::composeBatch,
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Compose the batch for the next decode step.
+
+             Returns continuing sequences plus newly admitted requests,
+             admitting highest priority first while the batch has room and
+             the KV pool covers blocks_needed plus the configured reserve.
+
+             Returns:
+                 list[int]: Request IDs composing this step's batch
+             )doc")
+
+        .def("pop_request",
+             [](GpuScheduler& self, uint32_t worker_id) -> py::object {
+                 GpuScheduler::Request request;
+                 bool popped;
+                 {
+                     py::gil_scoped_release release;
+                     popped = self.popRequest(worker_id, request);
+                 }
+                 if (!popped) {
+                     return py::none();
+                 }
+                 return py::cast(request);
+             },
+             py::arg("worker_id"),
+             R"doc(
+             Pop one request for direct execution (worker-pool mode).
+
+             Tries the worker's own deques first, then steals from other
+             workers. No admission control — use compose_batch() for the
+             batched decode path.
+
+             Args:
+                 worker_id (int): Worker index (< num_workers)
+
+             Returns:
+                 GpuSchedulerRequest or None if all deques are empty
+             )doc")
+
+        .def("complete_request",
+             &GpuScheduler::completeRequest,
+             py::arg("request_id"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Mark a sequence finished (leaves the batch on the next compose)")
+
+        .def("queued_count",
+             &GpuScheduler::queuedCount,
+             "Requests currently queued across all workers")
+
+        .def("active_count",
+             &GpuScheduler::activeCount,
+             "Sequences currently in the decode batch")
+
+        .def("get_statistics",
+             &GpuScheduler::getStatistics,
+             "Get current scheduler statistics")
+
+        .def("reset_statistics",
+             &GpuScheduler::resetStatistics,
+             "Reset statistics counters to zero")
+
+        .def("get_config",
+             &GpuScheduler::getConfig,
+             py::return_value_policy::copy,
+             "Get current configuration")
+
+        .def("__repr__", [](const GpuScheduler& scheduler) {
+            auto stats = scheduler.getStatistics();
+            return "GpuScheduler("
+                   "queued=" + std::to_string(stats.queued) +
+                   ", active=" + std::to_string(stats.active) +
+                   "/" + std::to_string(scheduler.getConfig().max_batch_size) +
+                   ")";
+        });
+}
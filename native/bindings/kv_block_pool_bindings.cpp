@@ -0,0 +1,256 @@
+// native/bindings/kv_block_pool_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_kv_block_pool.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * KV Block Pool Python Bindings
+ *
+ * Provides pybind11 bindings for the KVBlockPool C++ class. Replaces the
+ * asyncio-locked hot path of python/kv_cache_pool.py with native paged
+ * allocation and reference-counted prefix sharing.
+ *
+ * Module: krserve_native
+ * Dependencies: MetalMemoryPool (backing page memory)
+ */
+
+void bind_kv_block_pool(py::module& m) {
+    // KVBlockPool::Config
+    py::class_<KVBlockPool::Config>(m, "KVBlockPoolConfig")
+        .def(py::init<>(),
+             "Create default KV block pool configuration\n\n"
+             "Default values:\n"
+             "    block_size_tokens: 16\n"
+             "    bytes_per_token: 0 (must be set)\n"
+             "    max_blocks: 4096\n"
+             "    num_shards: 8\n"
+             "    enable_stats: true")
+
+        .def_readwrite("block_size_tokens", &KVBlockPool::Config::block_size_tokens,
+                       "Tokens per KV page (default: 16)")
+
+        .def_readwrite("bytes_per_token", &KVBlockPool::Config::bytes_per_token,
+                       "KV bytes per token across all layers (required)")
+
+        .def_readwrite("max_blocks", &KVBlockPool::Config::max_blocks,
+                       "Maximum pages the pool will hold (default: 4096)")
+
+        .def_readwrite("num_shards", &KVBlockPool::Config::num_shards,
+                       "Prefix map shards, power of two (default: 8)")
+
+        .def_readwrite("enable_stats", &KVBlockPool::Config::enable_stats,
+                       "Enable statistics collection (default: true)")
+
+        .def("__repr__", [](const KVBlockPool::Config& c) {
+            return "KVBlockPoolConfig("
+                   "block_size_tokens=" + std::to_string(c.block_size_tokens) +
+                   ", bytes_per_token=" + std::to_string(c.bytes_per_token) +
+                   ", max_blocks=" + std::to_string(c.max_blocks) +
+                   ")";
+        });
+
+    // KVBlockPool::Statistics
+    py::class_<KVBlockPool::Statistics>(m, "KVBlockPoolStatistics")
+        .def_readonly("blocks_allocated", &KVBlockPool::Statistics::blocks_allocated,
+                      "Pages handed out via allocate_blocks")
+        .def_readonly("blocks_freed", &KVBlockPool::Statistics::blocks_freed,
+                      "Pages returned to the free list")
+        .def_readonly("prefix_hits", &KVBlockPool::Statistics::prefix_hits,
+                      "lookup_prefix found a cached chain")
+        .def_readonly("prefix_misses", &KVBlockPool::Statistics::prefix_misses,
+                      "lookup_prefix found nothing")
+        .def_readonly("blocks_shared", &KVBlockPool::Statistics::blocks_shared,
+                      "Refcount bumps from prefix sharing")
+        .def_readonly("evictions", &KVBlockPool::Statistics::evictions,
+                      "Cached chains evicted under pressure")
+        .def_readonly("allocation_failures", &KVBlockPool::Statistics::allocation_failures,
+                      "allocate_blocks could not satisfy a request")
+        .def_readonly("blocks_in_use", &KVBlockPool::Statistics::blocks_in_use,
+                      "Pages with refcount > 0")
+        .def_readonly("blocks_free", &KVBlockPool::Statistics::blocks_free,
+                      "Pages on the free list")
+        .def_readonly("cached_chains", &KVBlockPool::Statistics::cached_chains,
+                      "Registered chains (including zero-ref)")
+        .def_readonly("bytes_per_block", &KVBlockPool::Statistics::bytes_per_block,
+                      "Page size in bytes")
+        .def("get_hit_rate", &KVBlockPool::Statistics::getHitRate,
+             "Get prefix cache hit rate (0.0-1.0)")
+        .def("to_dict", [](const KVBlockPool::Statistics& s) {
+            py::dict d;
+            d["blocks_allocated"] = s.blocks_allocated;
+            d["blocks_freed"] = s.blocks_freed;
+            d["prefix_hits"] = s.prefix_hits;
+            d["prefix_misses"] = s.prefix_misses;
+            d["blocks_shared"] = s.blocks_shared;
+            d["evictions"] = s.evictions;
+            d["allocation_failures"] = s.allocation_failures;
+            d["blocks_in_use"] = s.blocks_in_use;
+            d["blocks_free"] = s.blocks_free;
+            d["cached_chains"] = s.cached_chains;
+            d["bytes_per_block"] = s.bytes_per_block;
+            d["hit_rate"] = s.getHitRate();
+            return d;
+        }, "Convert statistics to dictionary")
+        .def("__repr__", [](const KVBlockPool::Statistics& s) {
+            return "KVBlockPoolStatistics("
+                   "in_use=" + std::to_string(s.blocks_in_use) +
+                   ", free=" + std::to_string(s.blocks_free) +
+                   ", chains=" + std::to_string(s.cached_chains) +
+                   ", hit_rate=" + std::to_string(s.getHitRate() * 100) + "%" +
+                   ")";
+        });
+
+    // KVBlockPool
+    py::class_<KVBlockPool>(m, "KVBlockPool",
+        R"doc(
+        Paged KV-cache block pool (vLLM-style).
+
+        KV memory is managed as fixed-size pages carved from MetalMemoryPool
+        heaps, with a sharded prefix map and reference-counted pages so
+        sequences sharing a prompt prefix share blocks instead of duplicating
+        them. Replaces the asyncio-locked lookup/eviction hot path of
+        python/kv_cache_pool.py.
+
+        Args:
+            config (KVBlockPoolConfig): Pool configuration
+            memory_pool (MetalMemoryPool): Backing pool for page memory
+                (kept alive by this object)
+
+        Example:
+            >>> pool_config = MetalMemoryPoolConfig()
+            >>> memory_pool = MetalMemoryPool(pool_config)
+            >>>
+            >>> config = KVBlockPoolConfig()
+            >>> config.block_size_tokens = 16
+            >>> config.bytes_per_token = 2 * 32 * 8 * 128 * 2
+            >>> kv_pool = KVBlockPool(config, memory_pool)
+            >>>
+            >>> h = KVBlockPool.hash_tokens(prompt_tokens)
+            >>> blocks = kv_pool.lookup_prefix(h)
+            >>> if not blocks:
+            ...     blocks = kv_pool.allocate_blocks(num_blocks)
+            ...     # ... prefill ...
+            ...     kv_pool.register_prefix(h, blocks)
+            >>> # ... decode ...
+            >>> kv_pool.release_blocks(blocks)
+
+        Performance:
+            - No asyncio lock or Python dict traffic on the request path
+            - Memory scales with tokens used, not max sequence length
+            - Prefix sharing multiplies effective capacity under templated
+              prompts
+        )doc")
+        .def(py::init<const KVBlockPool::Config&, MetalMemoryPool*>(),
+             py::arg("config"),
+             py::arg("memory_pool"),
+             py::keep_alive<1, 3>(),  // pool must outlive the KV pool
+             "Create a KV block pool backed by a MetalMemoryPool")
+
+        .def_static("hash_tokens",
+                    [](const std::vector<uint32_t>& tokens) {
+                        return KVBlockPool::hashTokens(tokens.data(), tokens.size());
+                    },
+                    py::arg("tokens"),
+                    "Hash a token sequence for prefix lookup (FNV-1a 64-bit)")
+
+        .def("allocate_blocks",
+             &KVBlockPool::allocateBlocks,
+             py::arg("num_blocks"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Allocate fresh KV pages (refcount 1 each).
+
+             Reuses freed pages first, then carves new pages, then evicts
+             zero-ref cached chains LRU.
+
+             Args:
+                 num_blocks (int): Pages needed
+
+             Returns:
+                 list[int]: Block IDs, or empty if all pages are referenced
+             )doc")
+
+        .def("lookup_prefix",
+             &KVBlockPool::lookupPrefix,
+             py::arg("prefix_hash"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Look up a cached chain by prefix hash.
+
+             On hit, bumps refcounts — the caller owns one reference and
+             must eventually call release_blocks().
+
+             Args:
+                 prefix_hash (int): Hash from hash_tokens()
+
+             Returns:
+                 list[int]: Block IDs of the cached chain, or empty on miss
+             )doc")
+
+        .def("register_prefix",
+             &KVBlockPool::registerPrefix,
+             py::arg("prefix_hash"),
+             py::arg("blocks"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Publish a prefilled chain for sharing.
+
+             The caller keeps its reference; later lookup_prefix() calls
+             adopt the same pages. Re-registering an existing hash is a
+             no-op (first writer wins).
+
+             Args:
+                 prefix_hash (int): Hash from hash_tokens()
+                 blocks (list[int]): Chain from allocate_blocks()
+             )doc")
+
+        .def("release_blocks",
+             &KVBlockPool::releaseBlocks,
+             py::arg("blocks"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Release a chain (sequence finished).
+
+             Unregistered pages at zero refs return to the free list;
+             registered chains stay cached and become eviction candidates.
+
+             Args:
+                 blocks (list[int]): Chain to release
+             )doc")
+
+        .def("block_buffer",
+             [](const KVBlockPool& self, uint32_t block_id) {
+                 return reinterpret_cast<uintptr_t>(self.blockBuffer(block_id));
+             },
+             py::arg("block_id"),
+             "Get the Metal buffer backing a page (id<MTLBuffer> as int), 0 if invalid")
+
+        .def("block_bytes",
+             &KVBlockPool::blockBytes,
+             "Page size in bytes (block_size_tokens * bytes_per_token)")
+
+        .def("get_statistics",
+             &KVBlockPool::getStatistics,
+             "Get current pool statistics")
+
+        .def("reset_statistics",
+             &KVBlockPool::resetStatistics,
+             "Reset statistics counters to zero")
+
+        .def("get_config",
+             &KVBlockPool::getConfig,
+             py::return_value_policy::copy,
+             "Get current configuration")
+
+        .def("__repr__", [](const KVBlockPool& pool) {
+            auto stats = pool.getStatistics();
+            return "KVBlockPool("
+                   "in_use=" + std::to_string(stats.blocks_in_use) +
+                   ", free=" + std::to_string(stats.blocks_free) +
+                   ", block_kb=" + std::to_string(stats.bytes_per_block / 1024) +
+                   ")";
+        });
+}
@@ -43,6 +43,15 @@ void bind_metal_memory_pool(py::module& m) {
         .def_readwrite("log_exhaustion", &MetalMemoryPool::Config::log_exhaustion,
                        "Log warnings when pool is exhausted (default: true)")
 
+        .def_readwrite("min_buffer_class_kb", &MetalMemoryPool::Config::min_buffer_class_kb,
+                       "Smallest suballocation size class in KB, power of two (default: 64)")
+
+        .def_readwrite("elastic", &MetalMemoryPool::Config::elastic,
+                       "Respond to memory pressure and grow up to max_heaps (default: false)")
+
+        .def_readwrite("max_heaps", &MetalMemoryPool::Config::max_heaps,
+                       "Growth ceiling when elastic (default: 8)")
+
         .def("__repr__", [](const MetalMemoryPool::Config& c) {
             return "MetalMemoryPoolConfig(heap_size_mb=" + std::to_string(c.heap_size_mb) +
                    ", num_heaps=" + std::to_string(c.num_heaps) +
@@ -69,6 +78,36 @@ void bind_metal_memory_pool(py::module& m) {
         .def_readonly("available_count", &MetalMemoryPool::Statistics::available_count,
                       "Currently available heaps in pool")
 
+        .def_readonly("buffers_acquired", &MetalMemoryPool::Statistics::buffers_acquired,
+                      "Total buffers acquired via acquire_buffer()")
+
+        .def_readonly("buffers_released", &MetalMemoryPool::Statistics::buffers_released,
+                      "Total buffers released via release_buffer()")
+
+        .def_readonly("buffer_cache_hits", &MetalMemoryPool::Statistics::buffer_cache_hits,
+                      "Buffers reused from a size-class free list")
+
+        .def_readonly("buffer_fallbacks", &MetalMemoryPool::Statistics::buffer_fallbacks,
+                      "Buffers allocated outside pooled heaps (all heaps full)")
+
+        .def_readonly("buffers_in_use", &MetalMemoryPool::Statistics::buffers_in_use,
+                      "Currently outstanding suballocated buffers")
+
+        .def_readonly("bytes_in_use", &MetalMemoryPool::Statistics::bytes_in_use,
+                      "Bytes held by outstanding suballocated buffers")
+
+        .def_readonly("pressure_events", &MetalMemoryPool::Statistics::pressure_events,
+                      "Memory-pressure notifications handled")
+
+        .def_readonly("heaps_purged", &MetalMemoryPool::Statistics::heaps_purged,
+                      "Idle heaps marked purgeable under pressure")
+
+        .def_readonly("heaps_recommitted", &MetalMemoryPool::Statistics::heaps_recommitted,
+                      "Purged heaps brought back on demand")
+
+        .def_readonly("heaps_grown", &MetalMemoryPool::Statistics::heaps_grown,
+                      "Heaps added beyond the initial pool")
+
         .def_property_readonly("utilization",
             [](const MetalMemoryPool::Statistics& s) {
                 if (s.pool_size == 0) return 0.0;
@@ -91,6 +130,16 @@ void bind_metal_memory_pool(py::module& m) {
             d["fallback_events"] = s.fallback_events;
             d["pool_size"] = s.pool_size;
             d["available_count"] = s.available_count;
+            d["buffers_acquired"] = s.buffers_acquired;
+            d["buffers_released"] = s.buffers_released;
+            d["buffer_cache_hits"] = s.buffer_cache_hits;
+            d["buffer_fallbacks"] = s.buffer_fallbacks;
+            d["buffers_in_use"] = s.buffers_in_use;
+            d["bytes_in_use"] = s.bytes_in_use;
+            d["pressure_events"] = s.pressure_events;
+            d["heaps_purged"] = s.heaps_purged;
+            d["heaps_recommitted"] = s.heaps_recommitted;
+            d["heaps_grown"] = s.heaps_grown;
 
             // Calculate derived metrics
             double utilization = 0.0;
@@ -159,6 +208,31 @@ void bind_metal_memory_pool(py::module& m) {
              "    >>> heap = pool.acquire_heap()\n"
              "    >>> pool.release_heap(heap)")
 
+        .def("acquire_buffer", &MetalMemoryPool::acquireBuffer,
+             py::arg("size"),
+             "Acquire a buffer of at least `size` bytes, suballocated from\n"
+             "the pooled heaps\n\n"
+             "Sizes round up to power-of-two size classes and are recycled\n"
+             "through per-class free lists, so small transient buffers share\n"
+             "the heaps instead of each pinning a whole heap.\n\n"
+             "Args:\n"
+             "    size: Requested size in bytes (> 0)\n\n"
+             "Returns:\n"
+             "    id<MTLBuffer>: Metal buffer object (opaque pointer), or None\n"
+             "    if even the fallback allocation fails\n\n"
+             "Example:\n"
+             "    >>> buf = pool.acquire_buffer(4 * 1024 * 1024)  # 4 MB\n"
+             "    >>> # ... use buffer ...\n"
+             "    >>> pool.release_buffer(buf)")
+
+        .def("release_buffer", &MetalMemoryPool::releaseBuffer,
+             py::arg("buffer"),
+             "Release a buffer previously acquired via acquire_buffer()\n\n"
+             "Pool-backed buffers return to their size-class free list for\n"
+             "reuse; fallback buffers are auto-released.\n\n"
+             "Args:\n"
+             "    buffer: Buffer object from acquire_buffer()")
+
         .def("warmup", &MetalMemoryPool::warmup,
              "Pre-warm the pool by allocating common buffer sizes\n\n"
              "Pre-allocates buffers of sizes specified in config.warmup_sizes.\n"
@@ -1,8 +1,12 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+
+#include <cstring>
 
 #include "../include/kr_parallel_tokenizer.h"
+#include "asyncio_bridge.h"
 
 namespace py = pybind11;
 using namespace krserve;
@@ -92,6 +96,10 @@ void bind_parallel_tokenizer(py::module& m) {
             "Number of active OpenMP threads")
         .def_readonly("accelerate_ops", &ParallelTokenizerStatistics::accelerate_ops,
             "Number of Apple Accelerate operations used")
+        .def_readonly("native_encodes", &ParallelTokenizerStatistics::native_encodes,
+            "Encodes served by the native BPE engine (no Python callback)")
+        .def_readonly("stream_tokens", &ParallelTokenizerStatistics::stream_tokens,
+            "Tokens decoded through streaming decoders (returned to the pool)")
         .def("get_tokens_per_second", &ParallelTokenizerStatistics::getTokensPerSecond,
             "Get average tokens per second")
         .def("get_avg_encode_time_us", &ParallelTokenizerStatistics::getAvgEncodeTimeUs,
@@ -111,6 +119,8 @@ void bind_parallel_tokenizer(py::module& m) {
             d["speedup_ratio"] = s.speedup_ratio;
             d["active_threads"] = s.active_threads;
             d["accelerate_ops"] = s.accelerate_ops;
+            d["native_encodes"] = s.native_encodes;
+            d["stream_tokens"] = s.stream_tokens;
             return d;
         }, "Convert statistics to dictionary")
         .def("__repr__", [](const ParallelTokenizerStatistics& s) {
@@ -120,6 +130,102 @@ void bind_parallel_tokenizer(py::module& m) {
                    ", speedup_ratio=" + std::to_string(s.speedup_ratio) + "x)";
         });
 
+    // StreamingDecoder
+    py::class_<StreamingDecoder, std::shared_ptr<StreamingDecoder>>(m, "StreamingDecoder",
+        R"doc(
+        Incremental streaming detokenizer for one output stream.
+
+        Feed one token id at a time; each call returns only the bytes that
+        became safe to emit (everything up to the last complete UTF-8
+        character). BPE tokens can split a multi-byte character across
+        token boundaries, so up to 3 bytes are held back until the
+        continuation bytes arrive. Emission cost is O(bytes of this
+        token), independent of stream length.
+
+        Obtain instances from ParallelTokenizer.acquire_stream_decoder()
+        and return them with release_stream_decoder() so state is pooled
+        across requests.
+
+        Results are raw bytes: decode with errors="strict" safely, or
+        concatenate and decode at the client.
+
+        Example:
+            >>> decoder = tokenizer.acquire_stream_decoder()
+            >>> for token_id in generated:
+            ...     chunk = decoder.feed(token_id)
+            ...     if chunk:
+            ...         sse_emit(chunk.decode("utf-8"))
+            >>> tail = decoder.flush()
+            >>> tokenizer.release_stream_decoder(decoder)
+
+        Note:
+            Each instance serves one stream and is not thread-safe.
+        )doc")
+        .def("feed",
+             [](StreamingDecoder& self, uint32_t token_id) {
+                 return py::bytes(self.feed(token_id));
+             },
+             py::arg("token_id"),
+             R"doc(
+             Feed one token id and get the newly-safe bytes.
+
+             Args:
+                 token_id (int): Token to decode
+
+             Returns:
+                 bytes: Bytes safe to forward to the client (may be empty)
+             )doc")
+
+        .def("feed_many",
+             [](StreamingDecoder& self, const std::vector<uint32_t>& token_ids) {
+                 std::string out;
+                 for (uint32_t token_id : token_ids) {
+                     out += self.feed(token_id);
+                 }
+                 return py::bytes(out);
+             },
+             py::arg("token_ids"),
+             R"doc(
+             Feed several token ids at once (e.g. a speculative burst).
+
+             Args:
+                 token_ids (list[int]): Tokens to decode in order
+
+             Returns:
+                 bytes: Concatenated newly-safe bytes (may be empty)
+             )doc")
+
+        .def("flush",
+             [](StreamingDecoder& self) {
+                 return py::bytes(self.flush());
+             },
+             R"doc(
+             Emit whatever is still pending at end of stream.
+
+             Any trailing incomplete character is emitted as-is rather
+             than dropped.
+
+             Returns:
+                 bytes: Remaining pending bytes (may be empty)
+             )doc")
+
+        .def("reset",
+             &StreamingDecoder::reset,
+             "Clear all stream state for reuse on a new stream")
+
+        .def("pending_bytes",
+             &StreamingDecoder::pendingBytes,
+             "Bytes held back waiting for a UTF-8 continuation")
+
+        .def("tokens_fed",
+             &StreamingDecoder::tokensFed,
+             "Tokens fed since construction or the last reset")
+
+        .def("__repr__", [](const StreamingDecoder& d) {
+            return "StreamingDecoder(tokens_fed=" + std::to_string(d.tokensFed()) +
+                   ", pending_bytes=" + std::to_string(d.pendingBytes()) + ")";
+        });
+
     // ParallelTokenizer
     py::class_<ParallelTokenizer>(m, "ParallelTokenizer",
         R"doc(
@@ -262,6 +368,348 @@ void bind_parallel_tokenizer(py::module& m) {
                  >>> print(tokens)
              )doc")
 
+        .def("encode_asyncio",
+             [](ParallelTokenizer& self,
+                const std::string& text,
+                const std::function<std::vector<uint32_t>(const std::string&)>& tokenizer_fn) {
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 py::object future = bridge->future();
+                 self.encodeAsyncCallback(
+                     text, tokenizer_fn,
+                     [bridge](std::vector<uint32_t> tokens, std::exception_ptr error) {
+                         if (error) {
+                             try {
+                                 std::rethrow_exception(error);
+                             } catch (const std::exception& e) {
+                                 bridge->reject(e.what());
+                             } catch (...) {
+                                 bridge->reject("encode failed");
+                             }
+                             return;
+                         }
+                         bridge->resolve([&tokens]() { return py::cast(tokens); });
+                     });
+                 return future;
+             },
+             py::arg("text"),
+             py::arg("tokenizer_fn"),
+             R"doc(
+             Asynchronous encode returning an asyncio.Future.
+
+             The encode runs on the native thread pool; the returned future
+             resolves on the calling event loop when it finishes (the native
+             completion posts back via loop.call_soon_threadsafe). Nothing
+             blocks — this is the awaitable counterpart of encode_async().
+
+             Must be called from a thread with a running asyncio event loop.
+
+             Args:
+                 text (str): Input text to tokenize
+                 tokenizer_fn (callable): Tokenization function
+                     Signature: (str) -> list[int]
+
+             Returns:
+                 asyncio.Future: Resolves to list[int] of token IDs
+
+             Raises:
+                 RuntimeError: Via the future, if encoding fails
+
+             Example:
+                 >>> tokens = await tokenizer.encode_asyncio("Hello", my_tokenizer)
+             )doc")
+
+        .def("encode_native_asyncio",
+             [](ParallelTokenizer& self, const std::string& text) {
+                 auto bridge = std::make_shared<AsyncioFutureBridge>();
+                 py::object future = bridge->future();
+                 self.encodeNativeAsync(
+                     text,
+                     [bridge](std::vector<uint32_t> tokens, std::exception_ptr error) {
+                         if (error) {
+                             try {
+                                 std::rethrow_exception(error);
+                             } catch (const std::exception& e) {
+                                 bridge->reject(e.what());
+                             } catch (...) {
+                                 bridge->reject("native encode failed");
+                             }
+                             return;
+                         }
+                         bridge->resolve([&tokens]() { return py::cast(tokens); });
+                     });
+                 return future;
+             },
+             py::arg("text"),
+             R"doc(
+             Asynchronous native-engine encode returning an asyncio.Future.
+
+             Fully native BPE encode on the thread pool — no Python callback,
+             no GIL contention — with the result delivered to the calling
+             asyncio event loop. The natural encode path inside an async
+             server: the loop keeps serving other requests while C++ works.
+
+             Must be called from a thread with a running asyncio event loop,
+             after a vocabulary has been loaded.
+
+             Args:
+                 text (str): Input text to tokenize
+
+             Returns:
+                 asyncio.Future: Resolves to list[int] of token IDs
+
+             Raises:
+                 RuntimeError: Via the future, if no vocabulary is loaded
+
+             Example:
+                 >>> tokenizer.load_vocabulary("vocab.json", "merges.txt")
+                 >>> tokens = await tokenizer.encode_native_asyncio("Hello world")
+             )doc")
+
+        .def("load_vocabulary",
+             &ParallelTokenizer::loadVocabulary,
+             py::arg("vocab_path"),
+             py::arg("merges_path"),
+             R"doc(
+             Load a native BPE vocabulary from GPT-2 style files.
+
+             After loading, encode_native()/encode_batch_native() run entirely
+             in C++ — no Python callback, no GIL — so batches scale across all
+             configured OpenMP threads.
+
+             Args:
+                 vocab_path (str): Path to vocab.json (token -> id map)
+                 merges_path (str): Path to merges.txt (one pair per line, rank order)
+
+             Raises:
+                 RuntimeError: If the files cannot be read or parsed
+
+             Example:
+                 >>> tokenizer.load_vocabulary("vocab.json", "merges.txt")
+                 >>> tokens = tokenizer.encode_native("Hello world")
+             )doc")
+
+        .def("load_vocabulary_from_tables",
+             &ParallelTokenizer::loadVocabularyFromTables,
+             py::arg("vocab"),
+             py::arg("merges"),
+             R"doc(
+             Load a native BPE vocabulary from pre-parsed tables.
+
+             Useful when the tokenizer config is already in memory (e.g. from a
+             HuggingFace tokenizer.json) — hand it over once, then encode natively.
+
+             Args:
+                 vocab (dict[str, int]): Token string -> token id
+                 merges (list[tuple[str, str]]): Merge pairs in rank order
+             )doc")
+
+        .def("load_compiled_vocabulary",
+             &ParallelTokenizer::loadCompiledVocabulary,
+             py::arg("path"),
+             R"doc(
+             Load a compiled vocabulary by memory-mapping it (zero-copy).
+
+             Startup path for serving replicas: one map call instead of
+             the 1.5-2s JSON parse, and forked workers share the mapped
+             pages. Encode-path lookups probe a flat hash table in the
+             mapping instead of a pointer-heavy dict. Build the artifact
+             once with compile_vocabulary().
+
+             Args:
+                 path (str): Path to a compiled vocabulary file
+
+             Raises:
+                 RuntimeError: If the file is missing, truncated, or has
+                     the wrong magic/version
+
+             Example:
+                 >>> tokenizer.load_vocabulary("vocab.json", "merges.txt")
+                 >>> tokenizer.compile_vocabulary("vocab.krbpe")  # offline, once
+                 >>> # ... per replica at startup:
+                 >>> tokenizer.load_compiled_vocabulary("vocab.krbpe")
+             )doc")
+
+        .def("compile_vocabulary",
+             &ParallelTokenizer::compileVocabulary,
+             py::arg("output_path"),
+             R"doc(
+             Compile the loaded vocabulary into a flat mmap-able file.
+
+             One-time offline build after load_vocabulary(); ship the
+             artifact next to the model weights and load it with
+             load_compiled_vocabulary().
+
+             Args:
+                 output_path (str): Output path for the compiled vocabulary
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+             )doc")
+
+        .def("has_native_engine",
+             &ParallelTokenizer::hasNativeEngine,
+             "Check if a native BPE vocabulary is loaded")
+
+        .def("encode_native",
+             &ParallelTokenizer::encodeNative,
+             py::arg("text"),
+             py::call_guard<py::gil_scoped_release>(),  // Fully native — safe to drop GIL
+             R"doc(
+             Encode a single text with the native BPE engine (GIL released).
+
+             Requires a loaded vocabulary (see load_vocabulary). Large strings
+             are split on UTF-8 boundaries and encoded in parallel with OpenMP.
+
+             Args:
+                 text (str): Input text to tokenize
+
+             Returns:
+                 list[int]: Vector of token IDs
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+             )doc")
+
+        .def("encode_batch_native",
+             &ParallelTokenizer::encodeBatchNative,
+             py::arg("texts"),
+             py::call_guard<py::gil_scoped_release>(),  // Fully native — safe to drop GIL
+             R"doc(
+             Encode a batch of texts with the native BPE engine (GIL released).
+
+             One text per OpenMP thread with no Python in the loop — this is the
+             path that delivers the advertised batch speedup.
+
+             Args:
+                 texts (list[str]): Input texts to tokenize
+
+             Returns:
+                 list[list[int]]: List of token ID vectors (one per input text)
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+             )doc")
+
+        .def("encode_native_packed",
+             [](ParallelTokenizer& self, const std::string& text) {
+                 std::vector<uint32_t> tokens;
+                 {
+                     py::gil_scoped_release release;
+                     tokens = self.encodeNative(text);
+                 }
+
+                 py::array_t<uint32_t> out(static_cast<py::ssize_t>(tokens.size()));
+                 std::memcpy(out.mutable_data(), tokens.data(),
+                             tokens.size() * sizeof(uint32_t));
+                 return out;
+             },
+             py::arg("text"),
+             R"doc(
+             Encode a single text, returning a NumPy uint32 array.
+
+             Same as encode_native() but the result is one contiguous array
+             allocated in C++ instead of a Python list — no per-token
+             PyObject boxing.
+
+             Args:
+                 text (str): Input text to tokenize
+
+             Returns:
+                 numpy.ndarray[uint32]: Token IDs
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+             )doc")
+
+        .def("encode_batch_native_packed",
+             [](ParallelTokenizer& self, const std::vector<std::string>& texts) {
+                 std::vector<std::vector<uint32_t>> batch;
+                 {
+                     py::gil_scoped_release release;
+                     batch = self.encodeBatchNative(texts);
+                 }
+
+                 size_t total_tokens = 0;
+                 for (const auto& tokens : batch) {
+                     total_tokens += tokens.size();
+                 }
+
+                 // One flat token buffer + one offsets array, allocated once.
+                 // Text i's tokens are flat[offsets[i]:offsets[i+1]].
+                 py::array_t<uint32_t> flat(static_cast<py::ssize_t>(total_tokens));
+                 py::array_t<uint64_t> offsets(static_cast<py::ssize_t>(batch.size() + 1));
+
+                 uint32_t* flat_ptr = flat.mutable_data();
+                 uint64_t* offset_ptr = offsets.mutable_data();
+
+                 size_t cursor = 0;
+                 for (size_t i = 0; i < batch.size(); ++i) {
+                     offset_ptr[i] = cursor;
+                     if (!batch[i].empty()) {
+                         std::memcpy(flat_ptr + cursor, batch[i].data(),
+                                     batch[i].size() * sizeof(uint32_t));
+                         cursor += batch[i].size();
+                     }
+                 }
+                 offset_ptr[batch.size()] = cursor;
+
+                 return py::make_tuple(flat, offsets);
+             },
+             py::arg("texts"),
+             R"doc(
+             Encode a batch of texts into packed NumPy arrays (GIL released).
+
+             Avoids the list-of-lists conversion of encode_batch_native() —
+             one PyObject per token becomes two arrays total. Encoding runs
+             with the GIL released; the arrays are filled once in C++ and
+             handed to NumPy zero-copy.
+
+             Args:
+                 texts (list[str]): Input texts to tokenize
+
+             Returns:
+                 tuple[numpy.ndarray[uint32], numpy.ndarray[uint64]]:
+                     (flat_tokens, offsets) — text i's tokens are
+                     flat_tokens[offsets[i]:offsets[i+1]], with
+                     len(offsets) == len(texts) + 1
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+
+             Example:
+                 >>> flat, offsets = tokenizer.encode_batch_native_packed(texts)
+                 >>> first = flat[offsets[0]:offsets[1]]  # zero-copy view
+             )doc")
+
+        .def("acquire_stream_decoder",
+             &ParallelTokenizer::acquireStreamDecoder,
+             R"doc(
+             Acquire a pooled streaming decoder for one output stream.
+
+             Reuses a previously released decoder when available, so high
+             stream churn does not allocate per request. The decoder is
+             handed out reset and bound to the current native engine.
+
+             Returns:
+                 StreamingDecoder: Decoder ready for feed()/flush()
+
+             Raises:
+                 RuntimeError: If no vocabulary has been loaded
+             )doc")
+
+        .def("release_stream_decoder",
+             &ParallelTokenizer::releaseStreamDecoder,
+             py::arg("decoder"),
+             R"doc(
+             Return a streaming decoder to the pool.
+
+             Folds the decoder's token count into the statistics and parks
+             the instance for the next acquire_stream_decoder() call.
+
+             Args:
+                 decoder (StreamingDecoder): Decoder from acquire_stream_decoder()
+             )doc")
+
         .def("get_statistics",
              &ParallelTokenizer::getStatistics,
              "Get current performance statistics")
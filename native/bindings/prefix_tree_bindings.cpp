@@ -0,0 +1,175 @@
+// native/bindings/prefix_tree_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_prefix_tree.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * Prefix Tree Python Bindings
+ *
+ * Provides pybind11 bindings for the PrefixTree C++ class. Longest-prefix
+ * matching over token-ID sequences for KV-cache reuse, built on KVBlockPool.
+ *
+ * Module: krserve_native
+ * Dependencies: KVBlockPool (cached block chains)
+ */
+
+void bind_prefix_tree(py::module& m) {
+    // PrefixTree::MatchResult
+    py::class_<PrefixTree::MatchResult>(m, "PrefixMatchResult",
+        R"doc(
+        Result of a longest-prefix match.
+
+        Attributes:
+            blocks (list[int]): Cached chain covering matched_tokens; the
+                caller owns one reference per block and must call
+                KVBlockPool.release_blocks() when the sequence finishes
+            matched_tokens (int): Tokens covered by blocks (multiple of the
+                pool's block size; 0 on a complete miss)
+        )doc")
+        .def_readonly("blocks", &PrefixTree::MatchResult::blocks,
+                      "Cached chain covering matched_tokens")
+        .def_readonly("matched_tokens", &PrefixTree::MatchResult::matched_tokens,
+                      "Tokens covered by blocks (0 on miss)")
+        .def("__repr__", [](const PrefixTree::MatchResult& r) {
+            return "PrefixMatchResult(matched_tokens=" +
+                   std::to_string(r.matched_tokens) +
+                   ", blocks=" + std::to_string(r.blocks.size()) + ")";
+        });
+
+    // PrefixTree::Statistics
+    py::class_<PrefixTree::Statistics>(m, "PrefixTreeStatistics")
+        .def_readonly("inserts", &PrefixTree::Statistics::inserts,
+                      "Chains inserted")
+        .def_readonly("lookups", &PrefixTree::Statistics::lookups,
+                      "match_longest_prefix calls")
+        .def_readonly("hits", &PrefixTree::Statistics::hits,
+                      "Lookups that matched at least one block")
+        .def_readonly("tokens_matched", &PrefixTree::Statistics::tokens_matched,
+                      "Total tokens served from cache")
+        .def_readonly("leaf_evictions", &PrefixTree::Statistics::leaf_evictions,
+                      "Leaves evicted via evict_leaves")
+        .def_readonly("node_count", &PrefixTree::Statistics::node_count,
+                      "Nodes currently in the tree")
+        .def("get_hit_rate", &PrefixTree::Statistics::getHitRate,
+             "Get fraction of lookups that reused at least one block (0.0-1.0)")
+        .def("to_dict", [](const PrefixTree::Statistics& s) {
+            py::dict d;
+            d["inserts"] = s.inserts;
+            d["lookups"] = s.lookups;
+            d["hits"] = s.hits;
+            d["tokens_matched"] = s.tokens_matched;
+            d["leaf_evictions"] = s.leaf_evictions;
+            d["node_count"] = s.node_count;
+            d["hit_rate"] = s.getHitRate();
+            return d;
+        }, "Convert statistics to dictionary")
+        .def("__repr__", [](const PrefixTree::Statistics& s) {
+            return "PrefixTreeStatistics("
+                   "nodes=" + std::to_string(s.node_count) +
+                   ", hit_rate=" + std::to_string(s.getHitRate() * 100) + "%" +
+                   ", tokens_matched=" + std::to_string(s.tokens_matched) +
+                   ")";
+        });
+
+    // PrefixTree
+    py::class_<PrefixTree>(m, "PrefixTree",
+        R"doc(
+        Token-prefix radix tree for KV-cache reuse.
+
+        Indexes token-ID sequences with path compression and returns the
+        deepest cached block chain matching a new prompt, so prefill
+        restarts from the divergence point instead of token zero. Built on
+        KVBlockPool; the tree holds its own block references so cached
+        chains stay alive while any path needs them.
+
+        Args:
+            pool (KVBlockPool): Block pool backing the cached chains
+                (kept alive by this object)
+
+        Example:
+            >>> tree = PrefixTree(kv_pool)
+            >>>
+            >>> match = tree.match_longest_prefix(prompt_tokens)
+            >>> # Prefill resumes at match.matched_tokens
+            >>>
+            >>> # After prefilling the full prompt into `blocks`:
+            >>> tree.insert(prompt_tokens, blocks)
+
+        Performance:
+            - Longest-prefix match is a tree walk — microseconds against
+              seconds of prefill saved for system-prompt-heavy traffic
+            - Reuse is block-granular (whole blocks only)
+        )doc")
+        .def(py::init<KVBlockPool*>(),
+             py::arg("pool"),
+             py::keep_alive<1, 2>(),  // pool must outlive the tree
+             "Create a prefix tree over a KV block pool")
+
+        .def("insert",
+             &PrefixTree::insert,
+             py::arg("tokens"),
+             py::arg("blocks"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Insert a prefilled chain under its token sequence.
+
+             The tree takes its own block references; the caller keeps and
+             later releases its own. Trailing tokens that don't fill a
+             block are ignored.
+
+             Args:
+                 tokens (list[int]): Full token sequence that was prefilled
+                 blocks (list[int]): Chain covering those tokens
+             )doc")
+
+        .def("match_longest_prefix",
+             &PrefixTree::matchLongestPrefix,
+             py::arg("tokens"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+             Find the deepest cached chain matching a prompt prefix.
+
+             Returned blocks are retained for the caller — release via
+             KVBlockPool.release_blocks() when the sequence finishes.
+
+             Args:
+                 tokens (list[int]): Prompt token sequence
+
+             Returns:
+                 PrefixMatchResult: Deepest chain and tokens covered
+             )doc")
+
+        .def("evict_leaves",
+             &PrefixTree::evictLeaves,
+             py::arg("count"),
+             R"doc(
+             Evict least-recently-matched leaf chains.
+
+             Args:
+                 count (int): Maximum leaves to evict
+
+             Returns:
+                 int: Leaves actually evicted
+             )doc")
+
+        .def("clear",
+             &PrefixTree::clear,
+             "Remove everything from the tree, releasing all block references")
+
+        .def("get_statistics",
+             &PrefixTree::getStatistics,
+             "Get current tree statistics")
+
+        .def("reset_statistics",
+             &PrefixTree::resetStatistics,
+             "Reset statistics counters to zero")
+
+        .def("__repr__", [](const PrefixTree& tree) {
+            auto stats = tree.getStatistics();
+            return "PrefixTree(nodes=" + std::to_string(stats.node_count) +
+                   ", hits=" + std::to_string(stats.hits) + ")";
+        });
+}
@@ -17,6 +17,15 @@ void bind_blit_queue(py::module& m);
 void bind_command_buffer_ring(py::module& m);
 void bind_parallel_tokenizer(py::module& m);
 void bind_weight_manager(py::module& m);
+void bind_kv_block_pool(py::module& m);
+void bind_prefix_tree(py::module& m);
+void bind_gpu_scheduler(py::module& m);
+void bind_sampling(py::module& m);
+void bind_trace_ring(py::module& m);
+void bind_request_arena(py::module& m);
+void bind_shared_memory_channel(py::module& m);
+void bind_stream_context_pool(py::module& m);
+void bind_decode_batcher(py::module& m);
 
 PYBIND11_MODULE(krserve_native, m) {
     m.doc() = "KR-Serve-MLX native acceleration module (C++/ObjC++)";
@@ -26,11 +35,16 @@ PYBIND11_MODULE(krserve_native, m) {
 
     // CommandBufferPool
     py::class_<CommandBufferPool>(m, "CommandBufferPool")
-        .def(py::init<size_t>(),
+        .def(py::init<size_t, bool, size_t>(),
              py::arg("pool_size") = 16,
+             py::arg("warm") = false,
+             py::arg("thread_cache_size") = 4,
              "Create a command buffer pool\n\n"
              "Args:\n"
-             "    pool_size: Maximum number of buffers to cache (default: 16)")
+             "    pool_size: Maximum number of buffers in the global pool (default: 16)\n"
+             "    warm: Pre-create pool_size buffers at construction so first\n"
+             "          acquires are hits instead of ~0.5ms misses (default: False)\n"
+             "    thread_cache_size: Buffers cached per submitting thread (default: 4)")
 
         .def("acquire", &CommandBufferPool::acquire,
              "Acquire a command buffer from the pool")
@@ -53,6 +67,8 @@ PYBIND11_MODULE(krserve_native, m) {
         .def_readonly("total_released", &CommandBufferPool::Stats::total_released)
         .def_readonly("cache_hits", &CommandBufferPool::Stats::cache_hits)
         .def_readonly("cache_misses", &CommandBufferPool::Stats::cache_misses)
+        .def_readonly("thread_cache_hits", &CommandBufferPool::Stats::thread_cache_hits)
+        .def_readonly("thread_caches", &CommandBufferPool::Stats::thread_caches)
         .def("__repr__", [](const CommandBufferPool::Stats& s) {
             return "CommandBufferPoolStats(pool_size=" + std::to_string(s.pool_size) +
                    ", available=" + std::to_string(s.available_buffers) +
@@ -112,4 +128,31 @@ PYBIND11_MODULE(krserve_native, m) {
 
     // Weight Manager (Week 3 optimization - memory pinning & prefetching)
     bind_weight_manager(m);
+
+    // KV Block Pool (paged KV cache with prefix sharing)
+    bind_kv_block_pool(m);
+
+    // Prefix Tree (longest-prefix KV reuse)
+    bind_prefix_tree(m);
+
+    // GPU Scheduler (native continuous batching)
+    bind_gpu_scheduler(m);
+
+    // Sampler (vectorized temperature/top-k/top-p sampling)
+    bind_sampling(m);
+
+    // Trace Ring (cross-component timeline instrumentation)
+    bind_trace_ring(m);
+
+    // Request Arena (request-scoped bump allocation)
+    bind_request_arena(m);
+
+    // Shared Memory Channel (cross-process zero-copy tensor handoff)
+    bind_shared_memory_channel(m);
+
+    // Stream Context Pool (pooled per-stream generation state)
+    bind_stream_context_pool(m);
+
+    // Decode Batcher (single-submission multi-stream decode steps)
+    bind_decode_batcher(m);
 }
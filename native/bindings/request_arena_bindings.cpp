@@ -0,0 +1,171 @@
+// native/bindings/request_arena_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_request_arena.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * Request Arena Python Bindings
+ *
+ * Provides pybind11 bindings for ArenaPool and RequestArena. Python
+ * owns the pool and the per-request arena lifetimes; the allocations
+ * themselves happen on the native side (tokenizer scratch, per-op
+ * tracking records), so the Python surface is lifecycle + statistics.
+ *
+ * Module: krserve_native
+ * Dependencies: none
+ */
+
+void bind_request_arena(py::module& m) {
+    // ArenaPool::Config
+    py::class_<ArenaPool::Config>(m, "ArenaPoolConfig")
+        .def(py::init<>(),
+             "Create default arena pool configuration\n\n"
+             "Default values:\n"
+             "    block_size: 262144 (256KB)\n"
+             "    initial_blocks: 0\n"
+             "    max_pooled_blocks: 64\n"
+             "    enable_stats: True")
+
+        .def_readwrite("block_size", &ArenaPool::Config::block_size,
+                       "Bytes per arena block (default: 256KB)")
+
+        .def_readwrite("initial_blocks", &ArenaPool::Config::initial_blocks,
+                       "Blocks created eagerly at construction (default: 0)")
+
+        .def_readwrite("max_pooled_blocks", &ArenaPool::Config::max_pooled_blocks,
+                       "Blocks kept for reuse; beyond this, returns are freed (default: 64)")
+
+        .def_readwrite("enable_stats", &ArenaPool::Config::enable_stats,
+                       "Enable statistics collection (default: True)")
+
+        .def("__repr__", [](const ArenaPool::Config& c) {
+            return "ArenaPoolConfig(block_size=" + std::to_string(c.block_size) +
+                   ", initial_blocks=" + std::to_string(c.initial_blocks) +
+                   ", max_pooled_blocks=" + std::to_string(c.max_pooled_blocks) +
+                   ")";
+        });
+
+    // ArenaPool::Statistics
+    py::class_<ArenaPool::Statistics>(m, "ArenaPoolStatistics")
+        .def_readonly("blocks_created", &ArenaPool::Statistics::blocks_created,
+                      "Blocks malloc'd (pool misses + warm start)")
+        .def_readonly("blocks_recycled", &ArenaPool::Statistics::blocks_recycled,
+                      "Blocks served from the pool without malloc")
+        .def_readonly("blocks_dropped", &ArenaPool::Statistics::blocks_dropped,
+                      "Returned blocks freed because the pool was full")
+        .def_readonly("arenas_created", &ArenaPool::Statistics::arenas_created,
+                      "RequestArena instances constructed")
+        .def_readonly("bytes_allocated", &ArenaPool::Statistics::bytes_allocated,
+                      "Total bytes handed out by arenas")
+        .def_readonly("allocations", &ArenaPool::Statistics::allocations,
+                      "Total arena allocations")
+        .def_readonly("oversize_allocations", &ArenaPool::Statistics::oversize_allocations,
+                      "Allocations that needed dedicated blocks")
+        .def_readonly("blocks_pooled", &ArenaPool::Statistics::blocks_pooled,
+                      "Blocks currently idle in the pool")
+        .def("get_recycle_rate", &ArenaPool::Statistics::getRecycleRate,
+             "Fraction of block demand served without malloc")
+        .def("to_dict", [](const ArenaPool::Statistics& s) {
+            py::dict d;
+            d["blocks_created"] = s.blocks_created;
+            d["blocks_recycled"] = s.blocks_recycled;
+            d["blocks_dropped"] = s.blocks_dropped;
+            d["arenas_created"] = s.arenas_created;
+            d["bytes_allocated"] = s.bytes_allocated;
+            d["allocations"] = s.allocations;
+            d["oversize_allocations"] = s.oversize_allocations;
+            d["blocks_pooled"] = s.blocks_pooled;
+            d["recycle_rate"] = s.getRecycleRate();
+            return d;
+        }, "Convert statistics to dictionary")
+        .def("__repr__", [](const ArenaPool::Statistics& s) {
+            return "ArenaPoolStatistics(created=" + std::to_string(s.blocks_created) +
+                   ", recycled=" + std::to_string(s.blocks_recycled) +
+                   ", pooled=" + std::to_string(s.blocks_pooled) + ")";
+        });
+
+    // ArenaPool
+    py::class_<ArenaPool>(m, "ArenaPool",
+        R"doc(
+        Pool of recycled arena blocks.
+
+        Backing store for RequestArena: arenas draw fixed-size blocks
+        from here and return them wholesale at request completion, so
+        steady-state request traffic does zero mallocs.
+
+        Create one per process (or per engine) and pass it to every
+        RequestArena.
+
+        Example:
+            >>> config = ArenaPoolConfig()
+            >>> config.initial_blocks = 16   # warm start
+            >>> pool = ArenaPool(config)
+            >>> arena = RequestArena(pool)   # per request
+            >>> # ... native work draws from the arena ...
+            >>> del arena                    # blocks recycled
+        )doc")
+        .def(py::init<const ArenaPool::Config&>(),
+             py::arg("config") = ArenaPool::Config{},
+             "Create an arena pool with configuration")
+
+        .def("get_statistics",
+             &ArenaPool::getStatistics,
+             "Get current pool statistics")
+
+        .def("reset_statistics",
+             &ArenaPool::resetStatistics,
+             "Reset statistics counters to zero")
+
+        .def("get_config",
+             &ArenaPool::getConfig,
+             "Get current configuration")
+
+        .def("__repr__", [](const ArenaPool& pool) {
+            auto stats = pool.getStatistics();
+            return "ArenaPool(block_size=" + std::to_string(pool.getConfig().block_size) +
+                   ", pooled=" + std::to_string(stats.blocks_pooled) +
+                   ", recycle_rate=" + std::to_string(stats.getRecycleRate()) + ")";
+        });
+
+    // RequestArena
+    py::class_<RequestArena>(m, "RequestArena",
+        R"doc(
+        Request-scoped bump arena.
+
+        Create one per request against a shared ArenaPool; native
+        components allocate scratch from it and everything is freed en
+        masse when the arena is destroyed (or reset between uses).
+
+        Example:
+            >>> arena = RequestArena(pool)
+            >>> # ... request runs ...
+            >>> print(arena.bytes_allocated())
+            >>> arena.reset()   # reuse for the next request
+        )doc")
+        .def(py::init<ArenaPool*>(),
+             py::arg("pool"),
+             py::keep_alive<1, 2>(),  // Arena keeps the pool alive
+             "Create an arena drawing blocks from a pool")
+
+        .def("reset",
+             &RequestArena::reset,
+             "Free everything at once, keeping one block hot for reuse.\n"
+             "Must not race in-flight native work using the arena.")
+
+        .def("bytes_allocated",
+             &RequestArena::bytesAllocated,
+             "Bytes handed out since construction or the last reset")
+
+        .def("blocks_used",
+             &RequestArena::blocksUsed,
+             "Blocks currently held (standard + oversize)")
+
+        .def("__repr__", [](const RequestArena& arena) {
+            return "RequestArena(bytes_allocated=" +
+                   std::to_string(arena.bytesAllocated()) +
+                   ", blocks_used=" + std::to_string(arena.blocksUsed()) + ")";
+        });
+}
@@ -0,0 +1,321 @@
+// native/bindings/shared_memory_channel_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_shared_memory_channel.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * Python Bindings for SharedMemoryChannel
+ *
+ * Exposes the lock-free SPSC shared-memory transport for cross-process
+ * tensor handoff: prompts and logits move between replica processes as
+ * offset+length descriptors instead of serialized bytes.
+ *
+ * Module: krserve_native
+ */
+void bind_shared_memory_channel(py::module& m) {
+    // ShmDescriptor
+    py::class_<ShmDescriptor>(m, "ShmDescriptor",
+        R"doc(
+        Descriptor for one message in a shared-memory channel.
+
+        The payload never travels: map `offset` back into the shared
+        segment with SharedMemoryChannel.payload_at() and read in place.
+
+        Attributes:
+            offset (int): Absolute payload-space offset
+            length (int): Payload length in bytes
+            tag (int): Application message tag
+            flags (int): Application flags
+            sequence (int): Monotonic sequence number assigned on send
+        )doc")
+        .def(py::init<>())
+        .def_readonly("offset", &ShmDescriptor::offset,
+                      "Absolute payload-space offset")
+        .def_readonly("length", &ShmDescriptor::length,
+                      "Payload length in bytes")
+        .def_readonly("tag", &ShmDescriptor::tag,
+                      "Application message tag")
+        .def_readonly("flags", &ShmDescriptor::flags,
+                      "Application flags")
+        .def_readonly("sequence", &ShmDescriptor::sequence,
+                      "Monotonic sequence number assigned on send")
+        .def("__repr__", [](const ShmDescriptor& d) {
+            return "ShmDescriptor(seq=" + std::to_string(d.sequence) +
+                   ", offset=" + std::to_string(d.offset) +
+                   ", length=" + std::to_string(d.length) +
+                   ", tag=" + std::to_string(d.tag) + ")";
+        });
+
+    // SharedMemoryChannelConfig
+    py::class_<SharedMemoryChannelConfig>(m, "SharedMemoryChannelConfig")
+        .def(py::init<>(),
+             "Create default channel configuration\n\n"
+             "Default values:\n"
+             "    name: '/krserve_channel'\n"
+             "    payload_mb: 64\n"
+             "    ring_slots: 1024\n"
+             "    create: true\n"
+             "    unlink_on_close: true\n"
+             "    enable_stats: true")
+
+        .def_readwrite("name", &SharedMemoryChannelConfig::name,
+                       "POSIX shm name, leading '/' (default: '/krserve_channel')")
+
+        .def_readwrite("payload_mb", &SharedMemoryChannelConfig::payload_mb,
+                       "Payload region capacity in MB (default: 64)")
+
+        .def_readwrite("ring_slots", &SharedMemoryChannelConfig::ring_slots,
+                       "Descriptor ring slots, power of two (default: 1024)")
+
+        .def_readwrite("create", &SharedMemoryChannelConfig::create,
+                       "Create the segment vs attach to an existing one (default: true)")
+
+        .def_readwrite("unlink_on_close", &SharedMemoryChannelConfig::unlink_on_close,
+                       "Unlink the shm name on destruction, owner side (default: true)")
+
+        .def_readwrite("enable_stats", &SharedMemoryChannelConfig::enable_stats,
+                       "Enable statistics collection (default: true)")
+
+        .def("__repr__", [](const SharedMemoryChannelConfig& c) {
+            return "SharedMemoryChannelConfig(name='" + c.name +
+                   "', payload_mb=" + std::to_string(c.payload_mb) +
+                   ", ring_slots=" + std::to_string(c.ring_slots) +
+                   ", create=" + std::string(c.create ? "true" : "false") + ")";
+        });
+
+    // SharedMemoryChannelStatistics
+    py::class_<SharedMemoryChannelStatistics>(m, "SharedMemoryChannelStatistics")
+        .def_readonly("messages_sent", &SharedMemoryChannelStatistics::messages_sent,
+                      "Messages published into the ring")
+
+        .def_readonly("messages_received", &SharedMemoryChannelStatistics::messages_received,
+                      "Messages popped from the ring")
+
+        .def_readonly("bytes_sent", &SharedMemoryChannelStatistics::bytes_sent,
+                      "Payload bytes published")
+
+        .def_readonly("bytes_received", &SharedMemoryChannelStatistics::bytes_received,
+                      "Payload bytes consumed")
+
+        .def_readonly("ring_full", &SharedMemoryChannelStatistics::ring_full,
+                      "Sends that found the descriptor ring full")
+
+        .def_readonly("payload_full", &SharedMemoryChannelStatistics::payload_full,
+                      "Reservations that found the payload region full")
+
+        .def_readonly("zero_copy_sends", &SharedMemoryChannelStatistics::zero_copy_sends,
+                      "Sends published via reserve()/commit() (no channel memcpy)")
+
+        .def("get_avg_message_bytes", &SharedMemoryChannelStatistics::getAvgMessageBytes,
+             "Get average message size in bytes")
+
+        .def("to_dict", [](const SharedMemoryChannelStatistics& s) {
+            py::dict d;
+            d["messages_sent"] = s.messages_sent;
+            d["messages_received"] = s.messages_received;
+            d["bytes_sent"] = s.bytes_sent;
+            d["bytes_received"] = s.bytes_received;
+            d["ring_full"] = s.ring_full;
+            d["payload_full"] = s.payload_full;
+            d["zero_copy_sends"] = s.zero_copy_sends;
+            d["avg_message_bytes"] = s.getAvgMessageBytes();
+            return d;
+        }, "Convert statistics to Python dictionary")
+
+        .def("__repr__", [](const SharedMemoryChannelStatistics& s) {
+            return "SharedMemoryChannelStatistics(sent=" + std::to_string(s.messages_sent) +
+                   ", received=" + std::to_string(s.messages_received) +
+                   ", ring_full=" + std::to_string(s.ring_full) + ")";
+        });
+
+    // SharedMemoryChannel main class
+    py::class_<SharedMemoryChannel>(m, "SharedMemoryChannel",
+        R"doc(
+        Lock-free SPSC shared-memory channel for cross-process tensor handoff.
+
+        A named POSIX shared-memory segment holds a payload region plus a
+        single-producer/single-consumer descriptor ring; messages cross
+        process boundaries as offset+length descriptors instead of copied
+        bytes. One channel is one direction — use a pair for duplex.
+
+        Zero-copy producer path: reserve() space, write in place (e.g. a
+        BlitQueue download straight into payload_at(offset)), commit().
+        The consumer reads in place and release()s in receive order.
+
+        Example (producer process):
+            >>> config = SharedMemoryChannelConfig()
+            >>> config.name = "/krserve_logits"
+            >>> channel = SharedMemoryChannel(config)
+            >>> off = channel.reserve(logits_bytes)
+            >>> # write logits at channel.payload_at(off) via ctypes/numpy
+            >>> channel.commit(off, logits_bytes, TAG_LOGITS)
+
+        Example (consumer process):
+            >>> config.create = False
+            >>> channel = SharedMemoryChannel(config)
+            >>> desc = channel.try_receive()
+            >>> if desc is not None:
+            ...     read_logits_at(channel.payload_at(desc.offset), desc.length)
+            ...     channel.release(desc)
+        )doc")
+        .def(py::init<const SharedMemoryChannelConfig&>(),
+             py::arg("config") = SharedMemoryChannelConfig{},
+             "Create or attach a channel endpoint\n\n"
+             "Args:\n"
+             "    config: SharedMemoryChannelConfig (name/sizes must match\n"
+             "            the creator's when attaching)\n\n"
+             "Raises:\n"
+             "    ValueError: If the configuration is invalid\n"
+             "    RuntimeError: If the segment cannot be created/attached")
+
+        .def("reserve",
+             &SharedMemoryChannel::reserve,
+             py::arg("size"),
+             "Reserve contiguous payload space for in-place writing\n\n"
+             "Args:\n"
+             "    size: Bytes to reserve\n\n"
+             "Returns:\n"
+             "    int: Absolute offset, or INVALID_OFFSET if the region is\n"
+             "    full (consumer hasn't released enough yet)")
+
+        .def("commit",
+             &SharedMemoryChannel::commit,
+             py::arg("offset"),
+             py::arg("length"),
+             py::arg("tag"),
+             py::arg("flags") = 0,
+             "Publish a previously reserved region as one message\n\n"
+             "Args:\n"
+             "    offset: Offset returned by reserve()\n"
+             "    length: Bytes actually written (<= reserved size)\n"
+             "    tag: Application message tag\n"
+             "    flags: Application flags (default: 0)\n\n"
+             "Returns:\n"
+             "    bool: False if the descriptor ring is full (retry later)")
+
+        .def("try_send",
+             [](SharedMemoryChannel& self, py::buffer data, uint32_t tag,
+                uint32_t flags) {
+                 py::buffer_info info = data.request();
+                 size_t size = static_cast<size_t>(info.size) * info.itemsize;
+                 py::gil_scoped_release release;
+                 return self.trySend(info.ptr, size, tag, flags);
+             },
+             py::arg("data"),
+             py::arg("tag"),
+             py::arg("flags") = 0,
+             "Copy a message into the channel and publish it\n\n"
+             "Convenience path for small payloads (tokenized prompts): one\n"
+             "memcpy straight into shared memory, no serialization.\n\n"
+             "Args:\n"
+             "    data: Message bytes (any buffer-protocol object)\n"
+             "    tag: Application message tag\n"
+             "    flags: Application flags (default: 0)\n\n"
+             "Returns:\n"
+             "    bool: False if the ring or payload region is full")
+
+        .def("try_send_ptr",
+             [](SharedMemoryChannel& self, uintptr_t data, uint64_t size,
+                uint32_t tag, uint32_t flags) {
+                 py::gil_scoped_release release;
+                 return self.trySend(reinterpret_cast<const void*>(data), size,
+                                     tag, flags);
+             },
+             py::arg("data_ptr"),
+             py::arg("size"),
+             py::arg("tag"),
+             py::arg("flags") = 0,
+             "Copy a message from a raw pointer and publish it\n\n"
+             "Pointer variant of try_send for data already described by a\n"
+             "(pointer, size) pair, e.g. MTLBuffer contents.\n\n"
+             "Args:\n"
+             "    data_ptr: Source pointer (as int/uintptr_t)\n"
+             "    size: Message length in bytes\n"
+             "    tag: Application message tag\n"
+             "    flags: Application flags (default: 0)\n\n"
+             "Returns:\n"
+             "    bool: False if the ring or payload region is full")
+
+        .def("try_receive",
+             [](SharedMemoryChannel& self) -> py::object {
+                 ShmDescriptor descriptor;
+                 if (!self.tryReceive(descriptor)) {
+                     return py::none();
+                 }
+                 return py::cast(descriptor);
+             },
+             "Pop the next message descriptor if one is pending\n\n"
+             "Non-blocking. The payload at payload_at(descriptor.offset)\n"
+             "stays valid until release().\n\n"
+             "Returns:\n"
+             "    ShmDescriptor | None: Next message, or None if empty")
+
+        .def("release",
+             &SharedMemoryChannel::release,
+             py::arg("descriptor"),
+             "Retire a received message's payload space\n\n"
+             "Must be called in receive order (SPSC FIFO); the producer\n"
+             "may reuse the space afterwards.\n\n"
+             "Args:\n"
+             "    descriptor: Descriptor from try_receive()")
+
+        .def("payload_at",
+             [](const SharedMemoryChannel& self, uint64_t offset) {
+                 return reinterpret_cast<uintptr_t>(self.payloadAt(offset));
+             },
+             py::arg("offset"),
+             "Map an absolute payload offset to this process's mapping\n\n"
+             "Args:\n"
+             "    offset: Offset from reserve() or a received descriptor\n\n"
+             "Returns:\n"
+             "    int: Pointer into the shared payload region (read via\n"
+             "    ctypes/numpy, or hand to BlitQueue as a CPU pointer)")
+
+        .def("payload_capacity",
+             &SharedMemoryChannel::payloadCapacity,
+             "Get payload region capacity in bytes")
+
+        .def("pending_count",
+             &SharedMemoryChannel::pendingCount,
+             "Get number of descriptors currently in the ring")
+
+        .def("is_owner",
+             &SharedMemoryChannel::isOwner,
+             "Check whether this endpoint created (owns) the segment")
+
+        .def_static("unlink_segment",
+                    &SharedMemoryChannel::unlinkSegment,
+                    py::arg("name"),
+                    "Remove a channel's shm name without attaching to it\n\n"
+                    "Cleanup helper for crashed peers; safe if the name\n"
+                    "doesn't exist.\n\n"
+                    "Args:\n"
+                    "    name: POSIX shm name (with leading '/')")
+
+        .def("get_statistics",
+             &SharedMemoryChannel::getStatistics,
+             "Get current statistics (local endpoint's view)")
+
+        .def("reset_statistics",
+             &SharedMemoryChannel::resetStatistics,
+             "Reset statistics counters")
+
+        .def("get_config",
+             &SharedMemoryChannel::getConfig,
+             "Get current configuration")
+
+        .def_property_readonly_static("INVALID_OFFSET",
+            [](py::object) { return SharedMemoryChannel::INVALID_OFFSET; },
+            "Sentinel returned by reserve() when the payload region is full")
+
+        .def("__repr__", [](const SharedMemoryChannel& channel) {
+            auto stats = channel.getStatistics();
+            return "SharedMemoryChannel(name='" + channel.getConfig().name +
+                   "', owner=" + (channel.isOwner() ? "True" : "False") +
+                   ", pending=" + std::to_string(channel.pendingCount()) +
+                   ", sent=" + std::to_string(stats.messages_sent) + ")";
+        });
+}
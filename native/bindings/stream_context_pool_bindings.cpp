@@ -0,0 +1,238 @@
+// native/bindings/stream_context_pool_bindings.cpp
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "../include/kr_stream_context_pool.h"
+
+namespace py = pybind11;
+using namespace krserve;
+
+/**
+ * Python Bindings for StreamContextPool
+ *
+ * Exposes the native freelist of per-stream generation contexts
+ * (detokenizer, sampling scratch, request arena) so admission and
+ * stream teardown stay constant-time under high stream churn.
+ *
+ * Module: krserve_native
+ */
+void bind_stream_context_pool(py::module& m) {
+    // StreamContextPool::Config
+    py::class_<StreamContextPool::Config>(m, "StreamContextPoolConfig")
+        .def(py::init<>(),
+             "Create default stream context pool configuration\n\n"
+             "Default values:\n"
+             "    vocab_size: 32768\n"
+             "    initial_contexts: 0\n"
+             "    max_pooled_contexts: 512\n"
+             "    arena: ArenaPoolConfig()\n"
+             "    enable_stats: true")
+
+        .def_readwrite("vocab_size", &StreamContextPool::Config::vocab_size,
+                       "Sampling scratch length per context (default: 32768)")
+
+        .def_readwrite("initial_contexts", &StreamContextPool::Config::initial_contexts,
+                       "Contexts created eagerly at construction (default: 0)")
+
+        .def_readwrite("max_pooled_contexts", &StreamContextPool::Config::max_pooled_contexts,
+                       "Contexts kept for reuse (default: 512)")
+
+        .def_readwrite("arena", &StreamContextPool::Config::arena,
+                       "Backing arena pool configuration")
+
+        .def_readwrite("enable_stats", &StreamContextPool::Config::enable_stats,
+                       "Enable statistics collection (default: true)")
+
+        .def("__repr__", [](const StreamContextPool::Config& c) {
+            return "StreamContextPoolConfig(vocab_size=" + std::to_string(c.vocab_size) +
+                   ", warm=" + std::to_string(c.initial_contexts) +
+                   ", max_pooled=" + std::to_string(c.max_pooled_contexts) + ")";
+        });
+
+    // StreamContextPool::Statistics
+    py::class_<StreamContextPool::Statistics>(m, "StreamContextPoolStatistics")
+        .def_readonly("contexts_created", &StreamContextPool::Statistics::contexts_created,
+                      "Contexts constructed (freelist misses + warm start)")
+
+        .def_readonly("acquires", &StreamContextPool::Statistics::acquires,
+                      "acquire_context() calls")
+
+        .def_readonly("releases", &StreamContextPool::Statistics::releases,
+                      "release_context() calls")
+
+        .def_readonly("freelist_hits", &StreamContextPool::Statistics::freelist_hits,
+                      "Acquires served from the freelist")
+
+        .def_readonly("contexts_dropped", &StreamContextPool::Statistics::contexts_dropped,
+                      "Released contexts freed (freelist full)")
+
+        .def_readonly("contexts_pooled", &StreamContextPool::Statistics::contexts_pooled,
+                      "Contexts currently idle in the freelist")
+
+        .def_readonly("contexts_active", &StreamContextPool::Statistics::contexts_active,
+                      "Contexts currently held by streams")
+
+        .def("get_hit_rate", &StreamContextPool::Statistics::getHitRate,
+             "Get fraction of acquires served without construction (0.0-1.0)")
+
+        .def("to_dict", [](const StreamContextPool::Statistics& s) {
+            py::dict d;
+            d["contexts_created"] = s.contexts_created;
+            d["acquires"] = s.acquires;
+            d["releases"] = s.releases;
+            d["freelist_hits"] = s.freelist_hits;
+            d["contexts_dropped"] = s.contexts_dropped;
+            d["contexts_pooled"] = s.contexts_pooled;
+            d["contexts_active"] = s.contexts_active;
+            d["hit_rate"] = s.getHitRate();
+            return d;
+        }, "Convert statistics to Python dictionary")
+
+        .def("__repr__", [](const StreamContextPool::Statistics& s) {
+            return "StreamContextPoolStatistics(active=" + std::to_string(s.contexts_active) +
+                   ", pooled=" + std::to_string(s.contexts_pooled) +
+                   ", hit_rate=" + std::to_string(s.getHitRate()) + ")";
+        });
+
+    // StreamContext
+    py::class_<StreamContext, std::shared_ptr<StreamContext>>(m, "StreamContext",
+        R"doc(
+        Per-stream generation state bundle.
+
+        Bundles the pieces a live output stream needs between admission
+        and stream end — streaming detokenizer, vocab-sized sampling
+        scratch, request arena, per-stream counters — pre-sized so the
+        decode loop never allocates. Obtained from
+        StreamContextPool.acquire_context(); hand it back with
+        release_context() at stream end.
+        )doc")
+        .def_property_readonly("stream_id", &StreamContext::streamId,
+            "Id assigned at the most recent acquire")
+
+        .def_property_readonly("decoder",
+            [](const StreamContext& ctx) -> py::object {
+                if (!ctx.decoder()) return py::none();
+                return py::cast(ctx.decoder());
+            },
+            "Pooled StreamingDecoder, or None if the pool has no tokenizer")
+
+        .def("sampling_scratch_ptr",
+             [](StreamContext& ctx) {
+                 return reinterpret_cast<uintptr_t>(ctx.samplingScratch());
+             },
+             "Get the vocab-sized float32 sampling scratch array\n\n"
+             "Returns:\n"
+             "    int: Stable pointer (float* as int/uintptr_t) for logits\n"
+             "    post-processing — hand to Sampler pointer APIs or wrap\n"
+             "    with numpy, instead of allocating per decode step")
+
+        .def_property_readonly("sampling_scratch_size",
+            &StreamContext::samplingScratchSize,
+            "Sampling scratch length in floats (the pool's vocab_size)")
+
+        .def("allocate",
+             [](StreamContext& ctx, size_t bytes) {
+                 return reinterpret_cast<uintptr_t>(ctx.arena().allocate(bytes));
+             },
+             py::arg("bytes"),
+             "Allocate transient bytes from the stream's arena\n\n"
+             "Valid until the context is released; freed en masse.\n\n"
+             "Args:\n"
+             "    bytes: Size to allocate\n\n"
+             "Returns:\n"
+             "    int: Pointer (as int/uintptr_t), max_align_t aligned")
+
+        .def_property_readonly("bytes_allocated",
+            [](StreamContext& ctx) { return ctx.arena().bytesAllocated(); },
+            "Arena bytes handed out since acquire")
+
+        .def_property_readonly("tokens_generated", &StreamContext::tokensGenerated,
+            "Tokens generated on this stream since acquire")
+
+        .def("record_tokens", &StreamContext::recordTokens,
+             py::arg("count"),
+             "Count generated tokens (read tokens_generated before release)")
+
+        .def("__repr__", [](const StreamContext& ctx) {
+            return "StreamContext(stream_id=" + std::to_string(ctx.streamId()) +
+                   ", tokens=" + std::to_string(ctx.tokensGenerated()) +
+                   ", decoder=" + (ctx.decoder() ? "yes" : "no") + ")";
+        });
+
+    // StreamContextPool main class
+    py::class_<StreamContextPool>(m, "StreamContextPool",
+        R"doc(
+        Freelist of per-stream generation contexts.
+
+        Native replacement for recycling per-request state through
+        python/object_pool.py: detokenizer tail buffers, vocab-sized
+        sampling scratch, and arena blocks bundle into StreamContext
+        objects that cycle through a freelist. acquire_context() at
+        admission and release_context() at stream end are both O(1),
+        keeping context setup/teardown out of TTFT at hundreds of
+        concurrent short streams.
+
+        Example:
+            >>> config = StreamContextPoolConfig()
+            >>> config.vocab_size = 32768
+            >>> config.initial_contexts = 64
+            >>> pool = StreamContextPool(config, tokenizer)
+            >>> ctx = pool.acquire_context()
+            >>> # decode loop: ctx.decoder.feed(token), sample into
+            >>> # ctx.sampling_scratch_ptr(), scratch via ctx.allocate()
+            >>> pool.release_context(ctx)
+        )doc")
+        .def(py::init<const StreamContextPool::Config&, ParallelTokenizer*>(),
+             py::arg("config") = StreamContextPool::Config{},
+             py::arg("tokenizer") = nullptr,
+             py::keep_alive<1, 3>(),  // Pool keeps the tokenizer alive
+             "Create a stream context pool\n\n"
+             "Args:\n"
+             "    config: StreamContextPoolConfig instance\n"
+             "    tokenizer: ParallelTokenizer whose streaming decoders the\n"
+             "               contexts carry (optional)\n\n"
+             "Raises:\n"
+             "    ValueError: If the configuration is invalid")
+
+        .def("acquire_context",
+             &StreamContextPool::acquireContext,
+             "Acquire a context for a newly admitted stream\n\n"
+             "Served from the freelist when possible (O(1)); otherwise a\n"
+             "context is constructed with scratch sized to vocab_size. When\n"
+             "a tokenizer with a native vocabulary is attached, the context\n"
+             "carries a pooled StreamingDecoder, handed out reset.\n\n"
+             "Returns:\n"
+             "    StreamContext: Context bound to a fresh stream id")
+
+        .def("release_context",
+             &StreamContextPool::releaseContext,
+             py::arg("context"),
+             "Return a context at stream end\n\n"
+             "O(1) reset: arena blocks recycle, counters zero, the decoder\n"
+             "goes back to the tokenizer's pool, and the context parks in\n"
+             "the freelist (or is dropped if the freelist is full).\n\n"
+             "Args:\n"
+             "    context: Context from acquire_context()")
+
+        .def("pooled_count",
+             &StreamContextPool::pooledCount,
+             "Get number of contexts currently idle in the freelist")
+
+        .def("get_statistics",
+             &StreamContextPool::getStatistics,
+             "Get current statistics")
+
+        .def("reset_statistics",
+             &StreamContextPool::resetStatistics,
+             "Reset statistics counters")
+
+        .def("get_config",
+             &StreamContextPool::getConfig,
+             "Get current configuration")
+
+        .def("__repr__", [](const StreamContextPool& pool) {
+            auto stats = pool.getStatistics();
+            return "StreamContextPool(active=" + std::to_string(stats.contexts_active) +
+                   ", pooled=" + std::to_string(stats.contexts_pooled) +
+                   ", created=" + std::to_string(stats.contexts_created) + ")";
+        });
+}
@@ -7,6 +7,63 @@ namespace py = pybind11;
 using namespace krserve;
 
 void bind_weight_manager(py::module& m) {
+    // SafetensorsTensorView
+    py::class_<SafetensorsTensorView>(m, "SafetensorsTensorView",
+        R"doc(
+        Zero-copy view of one tensor inside a mapped safetensors file.
+
+        Offsets are absolute into the mapped buffer, so a tensor can be bound
+        directly at (buffer, offset) without copying anything out.
+
+        Attributes:
+            dtype (str): Safetensors dtype string (e.g. "F16", "BF16", "U8")
+            shape (list[int]): Tensor shape
+            offset (int): Absolute byte offset into the mapped buffer
+            length (int): Byte length of tensor data
+        )doc")
+        .def_readonly("dtype", &SafetensorsTensorView::dtype,
+            "Safetensors dtype string")
+        .def_readonly("shape", &SafetensorsTensorView::shape,
+            "Tensor shape")
+        .def_readonly("offset", &SafetensorsTensorView::offset,
+            "Absolute byte offset into the mapped buffer")
+        .def_readonly("length", &SafetensorsTensorView::length,
+            "Byte length of tensor data")
+        .def("__repr__", [](const SafetensorsTensorView& v) {
+            return "SafetensorsTensorView(dtype=" + v.dtype +
+                   ", offset=" + std::to_string(v.offset) +
+                   ", length=" + std::to_string(v.length) + ")";
+        });
+
+    // SafetensorsModel
+    py::class_<SafetensorsModel>(m, "SafetensorsModel",
+        R"doc(
+        A safetensors file mapped as a single zero-copy Metal buffer.
+
+        Holds the whole-file buffer plus per-tensor views. The Python object
+        keeps the underlying mmap alive; tensor views become invalid once the
+        model is garbage-collected.
+
+        Attributes:
+            buffer_ptr (int): Mapped buffer (id<MTLBuffer> as int/uintptr_t)
+            file_size (int): Total mapped size in bytes
+            data_offset (int): Start of the tensor data section
+            tensors (dict[str, SafetensorsTensorView]): Per-tensor views
+        )doc")
+        .def_property_readonly("buffer_ptr", [](const SafetensorsModel& model) {
+            return reinterpret_cast<uintptr_t>((__bridge void*)model.buffer);
+        }, "Mapped buffer (id<MTLBuffer> as int/uintptr_t)")
+        .def_readonly("file_size", &SafetensorsModel::file_size,
+            "Total mapped size in bytes")
+        .def_readonly("data_offset", &SafetensorsModel::data_offset,
+            "Start of the tensor data section")
+        .def_readonly("tensors", &SafetensorsModel::tensors,
+            "Per-tensor views (name -> SafetensorsTensorView)")
+        .def("__repr__", [](const SafetensorsModel& model) {
+            return "SafetensorsModel(tensors=" + std::to_string(model.tensors.size()) +
+                   ", size=" + std::to_string(model.file_size / (1024 * 1024)) + "MB)";
+        });
+
     // WeightManagerConfig
     py::class_<WeightManagerConfig>(m, "WeightManagerConfig",
         R"doc(
@@ -69,6 +126,12 @@ void bind_weight_manager(py::module& m) {
             "Number of critical layers to pin (first N)")
         .def_readwrite("max_pinned_mb", &WeightManagerConfig::max_pinned_mb,
             "Max pinned memory allowed (in MB, 0 = unlimited)")
+        .def_readwrite("adaptive_prefetch", &WeightManagerConfig::adaptive_prefetch,
+            "Learn layer access order and prefetch predicted successors")
+        .def_readwrite("prefetch_candidates", &WeightManagerConfig::prefetch_candidates,
+            "Number of predicted successor layers to prefetch per access")
+        .def_readwrite("dequant_chunk_kb", &WeightManagerConfig::dequant_chunk_kb,
+            "Source bytes per streaming-dequantization chunk (in KB)")
         .def_readwrite("enable_stats", &WeightManagerConfig::enable_stats,
             "Enable statistics collection")
         .def("__repr__", [](const WeightManagerConfig& c) {
@@ -143,6 +206,20 @@ void bind_weight_manager(py::module& m) {
             "Failed pin operations (permissions/limits)")
         .def_readonly("active_prefetch_tasks", &WeightManagerStatistics::active_prefetch_tasks,
             "Currently active prefetch tasks")
+        .def_readonly("accesses_recorded", &WeightManagerStatistics::accesses_recorded,
+            "Layer accesses recorded into the transition table")
+        .def_readonly("predicted_prefetches", &WeightManagerStatistics::predicted_prefetches,
+            "Prefetches driven by the learned transition table")
+        .def_readonly("sequential_fallbacks", &WeightManagerStatistics::sequential_fallbacks,
+            "Prefetches that fell back to sequential (no history yet)")
+        .def_readonly("parallel_loads", &WeightManagerStatistics::parallel_loads,
+            "Parallel warm-in passes completed")
+        .def_readonly("dequant_ops", &WeightManagerStatistics::dequant_ops,
+            "Streaming dequantization passes completed")
+        .def_readonly("dequant_chunks", &WeightManagerStatistics::dequant_chunks,
+            "Dequantization chunks fanned out across the thread pool")
+        .def_readonly("dequant_bytes_out", &WeightManagerStatistics::dequant_bytes_out,
+            "fp16 bytes produced by streaming dequantization")
         .def("get_page_fault_reduction", &WeightManagerStatistics::getPageFaultReduction,
             "Get page fault reduction ratio (0.0-1.0)")
         .def("get_avg_bytes_per_weight", &WeightManagerStatistics::getAvgBytesPerWeight,
@@ -161,6 +238,13 @@ void bind_weight_manager(py::module& m) {
             d["prefetch_ops"] = s.prefetch_ops;
             d["pin_failures"] = s.pin_failures;
             d["active_prefetch_tasks"] = s.active_prefetch_tasks;
+            d["accesses_recorded"] = s.accesses_recorded;
+            d["predicted_prefetches"] = s.predicted_prefetches;
+            d["sequential_fallbacks"] = s.sequential_fallbacks;
+            d["parallel_loads"] = s.parallel_loads;
+            d["dequant_ops"] = s.dequant_ops;
+            d["dequant_chunks"] = s.dequant_chunks;
+            d["dequant_bytes_out"] = s.dequant_bytes_out;
             d["page_fault_reduction"] = s.getPageFaultReduction();
             d["avg_bytes_per_weight"] = s.getAvgBytesPerWeight();
             d["pin_success_rate"] = s.getPinSuccessRate();
@@ -345,6 +429,35 @@ void bind_weight_manager(py::module& m) {
                  - Automatic for next 2 layers
              )doc")
 
+        .def("record_layer_access",
+             &WeightManager::recordLayerAccess,
+             py::arg("layer_index"),
+             R"doc(
+             Record an observed layer access for the adaptive prefetcher.
+
+             Feeds the transition table that drives predicted prefetches.
+             Call from the inference loop as each layer's weights are
+             actually touched. No-op unless config.adaptive_prefetch is
+             enabled.
+
+             Args:
+                 layer_index (int): Layer whose weights were just accessed
+
+             Example:
+                 >>> # MoE / speculative decode inference loop
+                 >>> manager.record_layer_access(i)
+                 >>> manager.prefetch_layer(i, all_layers)  # uses predictions
+             )doc")
+
+        .def("reset_access_pattern",
+             &WeightManager::resetAccessPattern,
+             R"doc(
+             Clear the learned access-pattern transition table.
+
+             Use when switching models or routing configurations so stale
+             transitions don't drive wasted prefetches.
+             )doc")
+
         .def("warmup_model",
              &WeightManager::warmupModel,
              py::arg("buffer_size_mb") = 0,
@@ -401,6 +514,147 @@ void bind_weight_manager(py::module& m) {
                  - Automatic cleanup when buffer released
              )doc")
 
+        .def("load_safetensors_mapped",
+             [](WeightManager& self, const std::string& path, uintptr_t device_ptr) {
+                 id<MTLDevice> device = (__bridge id<MTLDevice>)(void*)device_ptr;
+                 return self.loadSafetensorsMapped(path, device);
+             },
+             py::arg("path"),
+             py::arg("device_ptr"),
+             R"doc(
+             Load a safetensors file with zero-copy per-tensor views.
+
+             Maps the whole file via mmap (same path as load_weights_mapped),
+             parses the safetensors header natively, and returns a model with
+             one absolute (offset, length) view per tensor into the single
+             mapped buffer. No tensor data is copied or re-laid-out.
+
+             Args:
+                 path (str): Path to .safetensors file
+                 device_ptr (int): Metal device pointer (id<MTLDevice> as int)
+
+             Returns:
+                 SafetensorsModel: Mapped buffer plus per-tensor views
+
+             Raises:
+                 RuntimeError: If the file cannot be mapped or the header
+                     is malformed
+
+             Example:
+                 >>> model = manager.load_safetensors_mapped(
+                 ...     "/path/to/model.safetensors", device_ptr)
+                 >>> view = model.tensors["model.embed_tokens.weight"]
+                 >>> # Bind (model.buffer_ptr, view.offset) directly
+
+             Performance:
+                 - Zero-copy: one mmap, no per-tensor allocation
+                 - Header parsed natively (no Python JSON round-trip)
+                 - Offsets pre-rebased to absolute file positions
+             )doc")
+
+        .def("warm_safetensors_parallel",
+             [](WeightManager& self, const SafetensorsModel& model,
+                const std::vector<uintptr_t>& critical_layer_ptrs) {
+                 std::vector<id<MTLBuffer>> layers;
+                 layers.reserve(critical_layer_ptrs.size());
+                 for (uintptr_t ptr : critical_layer_ptrs) {
+                     layers.push_back((__bridge id<MTLBuffer>)(void*)ptr);
+                 }
+                 py::gil_scoped_release release;
+                 self.warmSafetensorsParallel(model, layers);
+             },
+             py::arg("model"),
+             py::arg("critical_layer_ptrs") = std::vector<uintptr_t>{},
+             R"doc(
+             Warm a mapped safetensors model in parallel.
+
+             Splits the tensor data section into prefetch_threads shards and
+             faults each in on a worker thread (madvise(MADV_SEQUENTIAL) +
+             page touch), overlapped with pinning the critical layers on the
+             calling thread. Blocks until all pages are resident.
+
+             Args:
+                 model (SafetensorsModel): Model from load_safetensors_mapped()
+                 critical_layer_ptrs (list[int]): Layer buffers to pin while
+                     warming (id<MTLBuffer> as int; optional)
+
+             Example:
+                 >>> model = manager.load_safetensors_mapped(path, device_ptr)
+                 >>> manager.warm_safetensors_parallel(model, layer_ptrs)
+
+             Performance:
+                 - Warm-in parallelism follows config.prefetch_threads, so
+                   cold start scales with NVMe queue parallelism
+                 - Pinning overlaps the page-in instead of following it
+             )doc")
+
+        .def("dequantize_int4_to_fp16",
+             [](WeightManager& self,
+                uintptr_t packed_ptr,
+                size_t element_count,
+                uintptr_t scales_ptr,
+                uintptr_t biases_ptr,
+                size_t group_size,
+                uintptr_t dest_buffer,
+                size_t dest_offset) {
+                 id<MTLBuffer> dest = (__bridge id<MTLBuffer>)(void*)dest_buffer;
+                 py::gil_scoped_release release;
+                 return self.dequantizeInt4ToFp16(
+                     reinterpret_cast<const void*>(packed_ptr),
+                     element_count,
+                     reinterpret_cast<const void*>(scales_ptr),
+                     reinterpret_cast<const void*>(biases_ptr),
+                     group_size,
+                     dest,
+                     dest_offset);
+             },
+             py::arg("packed_ptr"),
+             py::arg("element_count"),
+             py::arg("scales_ptr"),
+             py::arg("biases_ptr"),
+             py::arg("group_size"),
+             py::arg("dest_buffer"),
+             py::arg("dest_offset") = 0,
+             R"doc(
+             Stream an int4-quantized tensor to fp16 in a destination buffer.
+
+             Replaces the tensor-by-tensor Python dequant pass: mapped int4
+             data (two elements per byte, low nibble first; value =
+             scale * q + bias with one fp16 scale/bias per group) is expanded
+             straight into the destination MTLBuffer, chunked across the
+             prefetch thread pool. Each worker prefetches its source slice
+             (madvise) so page-in overlaps the SIMD expansion, and transient
+             memory is bounded at dequant_chunk_kb x prefetch_threads instead
+             of a full-tensor fp16 copy. Blocks until the tensor is expanded.
+
+             Args:
+                 packed_ptr (int): Packed int4 source pointer (e.g. mapped
+                     buffer contents + tensor view offset)
+                 element_count (int): Quantized elements (multiple of group_size)
+                 scales_ptr (int): fp16 scales pointer (one per group)
+                 biases_ptr (int): fp16 biases pointer (one per group)
+                 group_size (int): Quantization group size (e.g. 32 or 64)
+                 dest_buffer (int): Destination buffer (id<MTLBuffer> as int)
+                 dest_offset (int): Byte offset into dest (default: 0)
+
+             Returns:
+                 int: Bytes written (element_count * 2)
+
+             Raises:
+                 ValueError: On null inputs, bad sizes, or a destination
+                     too small for the output
+
+             Example:
+                 >>> view = model.tensors["layers.0.mlp.w1.weight"]
+                 >>> manager.dequantize_int4_to_fp16(
+                 ...     base_ptr + view.offset, elements,
+                 ...     scales_ptr, biases_ptr, 64, fp16_buffer_ptr)
+
+             Performance:
+                 - Startup dequant time drops roughly by prefetch_threads
+                 - Peak RSS bounded by chunk size, not tensor size
+             )doc")
+
         .def("get_statistics",
              &WeightManager::getStatistics,
              "Get current performance statistics")
@@ -5,8 +5,10 @@
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <functional>
+#include <vector>
 
 namespace krserve {
 
@@ -43,6 +45,8 @@ public:
         size_t max_pending_ops = 8;        // Max concurrent blit operations
         bool use_shared_events = true;     // Use MTLSharedEvent (recommended)
         bool track_metrics = true;         // Track performance metrics
+        size_t staging_ring_slots = 8;     // Pre-allocated streaming staging slots
+        size_t staging_slot_kb = 64;       // Size per staging slot (KB)
     };
 
     /**
@@ -57,6 +61,39 @@ public:
         double overlap_ratio;              // Overlap efficiency (0.0-1.0)
         uint64_t sync_wait_count;          // Times waited on synchronization
         double avg_sync_wait_ms;           // Average sync wait duration
+        uint64_t batched_uploads;          // Coalesced batch upload operations
+        uint64_t coalesced_regions;        // Regions folded into batch uploads
+        uint64_t chained_downloads;        // Downloads ordered on-GPU via events
+        uint64_t streaming_downloads;      // Downloads served from the staging ring
+        uint64_t staging_fallbacks;        // Ring exhausted/oversized -> transient buffer
+    };
+
+    /**
+     * One region of a coalesced batch upload
+     *
+     * Describes a single CPU -> GPU copy; a batch of regions is encoded
+     * into one blit command buffer with one completion event.
+     */
+    struct UploadRegion {
+        const void* source_data = nullptr; // CPU buffer (host memory)
+        size_t source_size = 0;            // Size of source data in bytes
+        void* dest_buffer = nullptr;       // GPU buffer (id<MTLBuffer> cast to void*)
+        size_t dest_offset = 0;            // Offset in destination buffer
+    };
+
+    /**
+     * GPU-side synchronization point on the queue's shared event
+     *
+     * Returned by getEventHandle()/nextSignalHandle() and encoded into
+     * command buffers with encodeWait()/encodeSignal(), so upload ->
+     * compute -> download chains are ordered entirely on-GPU with no
+     * CPU-side waitForCompletion() stall.
+     */
+    struct EventHandle {
+        void* event = nullptr;  // MTLSharedEvent (id<MTLSharedEvent> cast to void*)
+        uint64_t value = 0;     // Signal value to wait for / signal
+
+        bool isValid() const { return event != nullptr && value != 0; }
     };
 
     /**
@@ -104,6 +141,24 @@ public:
         CompletionHandler completion = nullptr
     );
 
+    /**
+     * Asynchronously upload multiple regions in a single command buffer
+     *
+     * Encodes every region into one blit command buffer with one shared
+     * event signal, so uploading a batch's embeddings, masks, and position
+     * ids costs one commit instead of one per tensor. The whole batch
+     * completes (and signals) atomically.
+     *
+     * @param regions Regions to copy (all must be valid and in-bounds)
+     * @param completion Optional callback when the whole batch completes
+     * @return Operation ID for tracking (use with waitForCompletion)
+     * @throws std::invalid_argument if regions is empty or any region is invalid
+     */
+    uint64_t uploadBatchAsync(
+        const std::vector<UploadRegion>& regions,
+        CompletionHandler completion = nullptr
+    );
+
     /**
      * Asynchronously download data from GPU to CPU
      *
@@ -125,6 +180,128 @@ public:
         CompletionHandler completion = nullptr
     );
 
+    /**
+     * Asynchronously download after a GPU-side dependency is satisfied
+     *
+     * Same as downloadAsync(), but the blit waits on `after` (encoded as an
+     * MTLSharedEvent wait) before copying — so a compute command buffer that
+     * signals `after` orders the download entirely on-GPU. Combined with
+     * getEventHandle()/encodeWait() on the upload side, a full
+     * upload -> compute -> download chain needs zero CPU sync.
+     *
+     * @param after Dependency from nextSignalHandle() (signaled by compute)
+     * @param source_buffer GPU buffer (id<MTLBuffer> cast to void*)
+     * @param source_offset Offset in source buffer
+     * @param dest_data CPU buffer (host memory, must be pre-allocated)
+     * @param dest_size Size of destination buffer in bytes
+     * @param completion Optional callback when download completes
+     * @return Operation ID for tracking (use with waitForCompletion)
+     * @throws std::invalid_argument if `after` is invalid
+     */
+    uint64_t downloadAsyncAfter(
+        const EventHandle& after,
+        void* source_buffer,
+        size_t source_offset,
+        void* dest_data,
+        size_t dest_size,
+        CompletionHandler completion = nullptr
+    );
+
+    /**
+     * Handle to a streaming download in flight
+     *
+     * `data` points into a persistent staging slot (shared storage mode,
+     * page-aligned): stable, valid to read once the operation completes,
+     * and reused only after releaseStreamingSlot().
+     */
+    struct StreamingDownload {
+        uint64_t op_id = 0;         // Operation ID (use with waitForCompletion)
+        const void* data = nullptr; // CPU-visible staging memory for this slot
+    };
+
+    /**
+     * Download into a pre-allocated staging ring slot (streaming path)
+     *
+     * For small recurring readbacks — sampled tokens every decode step —
+     * downloadAsync() pays a fresh staging allocation plus a memcpy per
+     * call. This rotates through a fixed ring of shared-storage staging
+     * buffers instead: zero allocation, and the caller reads the slot
+     * memory directly once the operation completes (waitForCompletion or
+     * isCompleted). Call releaseStreamingSlot() when done reading so the
+     * slot can be reused; holding more than staging_ring_slots results at
+     * once falls back to transient buffers (counted in staging_fallbacks).
+     *
+     * @param source_buffer GPU buffer (id<MTLBuffer> cast to void*)
+     * @param source_offset Offset in source buffer
+     * @param size Bytes to download (sizes beyond staging_slot_kb fall
+     *        back to a transient buffer)
+     * @param completion Optional callback when download completes
+     * @return Handle with operation ID and stable CPU pointer
+     */
+    StreamingDownload downloadStreaming(
+        void* source_buffer,
+        size_t source_offset,
+        size_t size,
+        CompletionHandler completion = nullptr
+    );
+
+    /**
+     * Return a streaming download's staging slot to the ring
+     *
+     * Call after the slot's data has been consumed. Safe to call with an
+     * unknown ID (no-op).
+     *
+     * @param op_id Operation ID from downloadStreaming()
+     */
+    void releaseStreamingSlot(uint64_t op_id);
+
+    /**
+     * Get the GPU-side completion point of a pending operation
+     *
+     * Encode the returned handle as a wait (see encodeWait) into a compute
+     * command buffer — e.g. one acquired from CommandBufferRing — and the
+     * GPU defers that work until the blit finishes, with no CPU stall.
+     * Valid for pending and completed operations (waits on completed
+     * operations pass immediately).
+     *
+     * @param operation_id Operation ID returned from uploadAsync/downloadAsync
+     * @return Handle for GPU-side waiting (isValid() == false if the
+     *         operation is unknown or shared events are disabled)
+     */
+    EventHandle getEventHandle(uint64_t operation_id) const;
+
+    /**
+     * Reserve a fresh signal point on the queue's shared event
+     *
+     * Encode it as a signal (see encodeSignal) at the end of a compute
+     * command buffer, then pass it to downloadAsyncAfter() so the download
+     * chains off the compute on-GPU.
+     *
+     * @return Fresh handle (isValid() == false if shared events disabled)
+     */
+    EventHandle nextSignalHandle();
+
+    /**
+     * Encode a GPU-side wait on `handle` into a command buffer
+     *
+     * Must be called before any encoders are created on the command buffer.
+     *
+     * @param command_buffer MTLCommandBuffer (id<MTLCommandBuffer> cast to
+     *        void*, e.g. from CommandBufferRing::acquireBuffer())
+     * @param handle Dependency to wait for
+     */
+    static void encodeWait(void* command_buffer, const EventHandle& handle);
+
+    /**
+     * Encode a GPU-side signal of `handle` into a command buffer
+     *
+     * The signal fires after all work encoded in the command buffer.
+     *
+     * @param command_buffer MTLCommandBuffer (id<MTLCommandBuffer> cast to void*)
+     * @param handle Signal point from nextSignalHandle()
+     */
+    static void encodeSignal(void* command_buffer, const EventHandle& handle);
+
     /**
      * Wait for a specific blit operation to complete
      *
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <array>
+#include <utility>
+
+namespace krserve {
+
+/**
+ * In-process byte-level BPE engine
+ *
+ * Owns the vocabulary and merge-rank table so encoding runs entirely in
+ * native code — no Python callback, no GIL. Designed to back
+ * ParallelTokenizer::encodeNative()/encodeBatchNative() so the OpenMP
+ * fan-out actually scales instead of serializing on the pybind11 boundary.
+ *
+ * Supports the GPT-2 style byte-level BPE format:
+ * - vocab.json: token string -> token id
+ * - merges.txt: one merge pair per line, in rank order
+ *
+ * Thread-Safety:
+ * - Loading is NOT thread-safe (call once during startup)
+ * - encode() is const and safe to call from any number of threads
+ */
+class BpeEngine {
+public:
+    BpeEngine();
+    ~BpeEngine();
+
+    // Disable copy (merge tables can be large)
+    BpeEngine(const BpeEngine&) = delete;
+    BpeEngine& operator=(const BpeEngine&) = delete;
+
+    /**
+     * Load vocabulary and merges from GPT-2 style files
+     *
+     * @param vocab_path Path to vocab.json (token -> id map)
+     * @param merges_path Path to merges.txt (one pair per line, rank order)
+     * @throws std::runtime_error if files cannot be read or parsed
+     */
+    void loadFromFiles(const std::string& vocab_path, const std::string& merges_path);
+
+    /**
+     * Load vocabulary and merges from pre-parsed tables
+     *
+     * Useful when the Python side already holds the tokenizer config
+     * (e.g. from HuggingFace tokenizer.json) and wants to hand it over once.
+     *
+     * @param vocab Token string -> token id
+     * @param merges Merge pairs in rank order (left, right)
+     */
+    void loadFromTables(
+        const std::unordered_map<std::string, uint32_t>& vocab,
+        const std::vector<std::pair<std::string, std::string>>& merges
+    );
+
+    /**
+     * Compile the loaded vocabulary into a flat mmap-able file
+     *
+     * One-time offline build: serializes the string table, token ids,
+     * merge ranks and an open-addressing hash index into a single
+     * contiguous file that loadFromCompiledFile() maps zero-copy. Run
+     * once after loadFromFiles() and ship the artifact next to the
+     * model weights.
+     *
+     * @param path Output path for the compiled vocabulary
+     * @throws std::runtime_error if not loaded from source tables or
+     *         the file cannot be written
+     */
+    void compileToFile(const std::string& path) const;
+
+    /**
+     * Load a compiled vocabulary by memory-mapping it
+     *
+     * Replaces the 1.5-2s JSON parse with a single map call (the same
+     * zero-copy approach WeightManager::loadWeightsMapped uses for
+     * weights); forked workers share the mapped pages. Encode-path
+     * lookups probe a flat open-addressing table in the mapping instead
+     * of chasing unordered_map heap pointers. Only the small id->bytes
+     * decode table is materialized.
+     *
+     * @param path Path to a file written by compileToFile()
+     * @throws std::runtime_error if the file is missing, truncated or
+     *         has the wrong magic/version
+     */
+    void loadFromCompiledFile(const std::string& path);
+
+    /**
+     * Check if the vocabulary is served from a compiled mapping
+     */
+    bool isCompiled() const { return compiled_; }
+
+    /**
+     * Encode UTF-8 text to token IDs (fully native, no callbacks)
+     *
+     * Pre-tokenizes into words (leading space attached, GPT-2 style),
+     * maps bytes through the byte-level encoder, then applies ranked
+     * BPE merges. Unknown symbols fall back to per-byte tokens.
+     *
+     * @param text Input text
+     * @return Vector of token IDs
+     */
+    std::vector<uint32_t> encode(const std::string& text) const;
+
+    /**
+     * Get the raw UTF-8 bytes for a token id
+     *
+     * Returns an empty string for out-of-range ids. The returned reference
+     * is valid for the lifetime of the engine.
+     *
+     * @param token_id Token id to look up
+     * @return Decoded bytes for the token
+     */
+    const std::string& decodeToken(uint32_t token_id) const;
+
+    /**
+     * Check if a vocabulary has been loaded
+     */
+    bool isLoaded() const { return loaded_; }
+
+    /**
+     * Get vocabulary size (0 if not loaded)
+     */
+    size_t vocabSize() const { return id_to_bytes_.size(); }
+
+    /**
+     * Get number of merge rules (0 if not loaded)
+     */
+    size_t mergeCount() const { return merge_count_; }
+
+private:
+    // Token string (byte-encoded) -> token id
+    std::unordered_map<std::string, uint32_t> vocab_;
+
+    // Token id -> raw UTF-8 bytes (byte-decoded)
+    std::vector<std::string> id_to_bytes_;
+
+    // Merge pair ("left\x01right") -> rank
+    std::unordered_map<std::string, uint32_t> merge_ranks_;
+
+    // Merge rule count (survives compiled loads, where merge_ranks_
+    // stays empty)
+    size_t merge_count_ = 0;
+
+    // Compiled (mmap-backed) tables; null unless loadFromCompiledFile
+    bool compiled_ = false;
+    uint8_t* map_base_ = nullptr;
+    size_t map_size_ = 0;
+    const void* compiled_vocab_slots_ = nullptr;   // TableSlot array
+    const void* compiled_merge_slots_ = nullptr;   // TableSlot array
+    const char* compiled_strings_ = nullptr;       // Shared string blob
+    uint32_t compiled_vocab_slot_count_ = 0;
+    uint32_t compiled_merge_slot_count_ = 0;
+
+    // GPT-2 byte-to-unicode table (byte value -> UTF-8 string)
+    std::array<std::string, 256> byte_encoder_;
+
+    // Reverse mapping: encoded unicode string -> byte value
+    std::unordered_map<std::string, uint8_t> byte_decoder_;
+
+    // Load state
+    bool loaded_ = false;
+
+    /**
+     * Build the GPT-2 byte <-> unicode tables
+     */
+    void buildByteTables();
+
+    /**
+     * Rebuild id_to_bytes_ and byte-decode the vocab after loading
+     */
+    void finalizeLoad();
+
+    /**
+     * Split text into GPT-2 pre-tokens (contractions, words with an
+     * attached leading space, digit runs, punctuation runs, whitespace)
+     */
+    std::vector<std::string> preTokenize(const std::string& text) const;
+
+    /**
+     * Apply BPE merges to a single byte-encoded word
+     * Appends resulting token ids to output.
+     */
+    void bpeWord(const std::string& word, std::vector<uint32_t>& output) const;
+
+    /**
+     * Look up merge rank for a symbol pair (UINT32_MAX if not mergeable)
+     */
+    uint32_t pairRank(const std::string& left, const std::string& right) const;
+
+    /**
+     * Look up a token id (UINT32_MAX if unknown); probes the compiled
+     * table when mapped, else the hash map
+     */
+    uint32_t lookupToken(const std::string& symbol) const;
+
+    /**
+     * Release a compiled mapping if one is held
+     */
+    void unmapCompiled();
+};
+
+} // namespace krserve
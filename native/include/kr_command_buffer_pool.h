@@ -13,19 +13,27 @@ namespace krserve {
  * Command Buffer Pool for Metal GPU operations
  *
  * Reuses Metal command buffers to reduce allocation overhead.
- * Thread-safe with minimal locking.
+ * Each thread gets its own small free list so concurrent streams don't
+ * contend on a lock; a locked global pool sits behind the thread caches
+ * as overflow and for cross-thread acquire/release balancing.
  *
  * Performance Impact:
  * - Reduces command buffer allocation from ~0.5ms to ~0.05ms
  * - Expected improvement: 5-10% on small batches
+ * - Thread-cache hits take no lock shared with other threads
  */
 class CommandBufferPool {
 public:
     /**
      * Create a command buffer pool
-     * @param pool_size Maximum number of buffers to cache (default: 16)
+     * @param pool_size Maximum number of buffers in the global pool (default: 16)
+     * @param warm Pre-create pool_size buffers against the queue now, so
+     *             the first acquires are hits instead of ~0.5ms misses
+     * @param thread_cache_size Buffers cached per submitting thread (default: 4)
      */
-    explicit CommandBufferPool(size_t pool_size = 16);
+    explicit CommandBufferPool(size_t pool_size = 16,
+                               bool warm = false,
+                               size_t thread_cache_size = 4);
 
     /**
      * Destructor - ensures proper cleanup
@@ -38,18 +46,26 @@ public:
 
     /**
      * Acquire a command buffer from the pool
+     *
+     * Checks the calling thread's free list first, then the global
+     * pool, and only creates a new buffer when both are empty.
+     *
      * @return Command buffer (creates new if pool is empty)
      */
     void* acquire();
 
     /**
      * Release a command buffer back to the pool
+     *
+     * Returned to the calling thread's free list while it has room,
+     * then the global pool, then dropped to ARC.
+     *
      * @param buffer Command buffer to release (id<MTLCommandBuffer>)
      */
     void release(void* buffer);
 
     /**
-     * Reset the pool (clears all cached buffers)
+     * Reset the pool (clears all cached buffers, thread caches included)
      */
     void reset();
 
@@ -58,11 +74,13 @@ public:
      */
     struct Stats {
         size_t pool_size;
-        size_t available_buffers;
+        size_t available_buffers;   // Global pool + all thread caches
         size_t total_acquired;
         size_t total_released;
-        size_t cache_hits;
+        size_t cache_hits;          // Served from any free list
         size_t cache_misses;
+        size_t thread_cache_hits;   // Subset of cache_hits with no global lock
+        size_t thread_caches;       // Threads that have acquired so far
     };
     Stats getStats() const;
 
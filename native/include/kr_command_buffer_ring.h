@@ -19,10 +19,11 @@ namespace krserve {
  * allowing the GPU to work on one buffer while the CPU prepares the next.
  *
  * Architecture:
- * - Ring of 2-3 pre-allocated MTLCommandBuffers
- * - Round-robin acquisition with automatic rotation
- * - Wait for buffer completion before reuse (prevents GPU stalls)
- * - Thread-safe acquire/release with std::mutex
+ * - Ring of 2-3 slots with atomic lifecycle states (FREE/IN_USE/IN_FLIGHT)
+ * - Lock-free round-robin acquisition: FREE -> IN_USE claimed via CAS
+ * - Completion flag set from the Metal completion handler (single atomic
+ *   store, no mutex, no condition variable)
+ * - Spin-then-yield acquire path when all slots are in flight
  *
  * Performance Impact:
  * - Expected: +5-10% GPU utilization
@@ -55,9 +56,30 @@ public:
          * Number of buffers in ring (2-3 recommended)
          * - 2 buffers: Double buffering (CPU/GPU overlap)
          * - 3 buffers: Triple buffering (higher latency tolerance)
+         * With adaptive_sizing this is the floor the ring shrinks back to.
          */
         size_t ring_size = 2;
 
+        /**
+         * Grow/shrink the active ring between ring_size and max_ring_size
+         * based on observed wait pressure (prefill bursts grow it, idle
+         * decode shrinks it back)
+         */
+        bool adaptive_sizing = false;
+
+        /**
+         * Growth ceiling for adaptive sizing (slots are pre-allocated up
+         * to this, so resizing never allocates on the hot path)
+         */
+        size_t max_ring_size = 8;
+
+        /**
+         * Slots the prefill lane may never occupy, so decode always has
+         * a slot available (prevents head-of-line blocking of token
+         * generation behind long prefill command buffers)
+         */
+        size_t decode_reserved_slots = 1;
+
         /**
          * Maximum time to wait for buffer availability (milliseconds)
          * - 0 = infinite wait
@@ -100,6 +122,26 @@ public:
         // Rotation metrics
         uint64_t rotations;           // Number of ring rotations
         double rotation_rate;         // Rotations per second
+
+        // Adaptive sizing / lane metrics
+        size_t active_ring_size;      // Slots currently in rotation
+        uint64_t grow_events;         // Adaptive ring growths
+        uint64_t shrink_events;       // Adaptive ring shrinks
+        uint64_t decode_acquired;     // Acquisitions on the decode lane
+        uint64_t prefill_acquired;    // Acquisitions on the prefill lane
+        uint64_t prefill_throttles;   // Prefill waits on the lane budget
+    };
+
+    /**
+     * Submission lane
+     *
+     * Decode is latency-critical and may claim any free slot; prefill is
+     * throughput work and is capped at active_size - decode_reserved_slots
+     * concurrent slots so it can never starve decode.
+     */
+    enum class Lane : uint32_t {
+        Decode = 0,
+        Prefill = 1,
     };
 
     /**
@@ -125,16 +167,30 @@ public:
      * Acquire next available buffer from ring
      *
      * Behavior:
-     * - Returns immediately if buffer available
-     * - Waits for buffer completion if all buffers in-flight
+     * - Returns immediately if a slot is free (lock-free CAS claim)
+     * - Spins briefly, then yields, if all buffers are in-flight
      * - Respects timeout_ms configuration
-     * - Thread-safe with mutex protection
+     * - Thread-safe without taking any lock
      *
      * @return Command buffer (id<MTLCommandBuffer> as void*)
      * @throws std::runtime_error if timeout occurs or allocation fails
      */
     void* acquireBuffer();
 
+    /**
+     * Acquire a buffer on an explicit lane
+     *
+     * Decode behaves exactly like acquireBuffer(). Prefill additionally
+     * respects the decode_reserved_slots budget: when the prefill lane
+     * already holds its quota of slots, the call waits even if free slots
+     * remain, leaving them for decode.
+     *
+     * @param lane Submission lane (Decode or Prefill)
+     * @return Command buffer (id<MTLCommandBuffer> as void*)
+     * @throws std::runtime_error if timeout occurs or allocation fails
+     */
+    void* acquireBuffer(Lane lane);
+
     /**
      * Release buffer back to ring
      *
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "kr_command_buffer_ring.h"
+#include "kr_blit_queue.h"
+
+namespace krserve {
+
+/**
+ * Per-stream transfer layout registered with the batcher
+ *
+ * Pointers are re-read on every step, so a stream rewrites its upload
+ * source in place (e.g. the token fed back for the next step) and the
+ * batcher picks up the new contents — no re-registration per step.
+ */
+struct DecodeStreamSlot {
+    // Stream identity (e.g. StreamContext::streamId())
+    uint64_t stream_id = 0;
+
+    // Host -> GPU per step: next-token input, positions, masks
+    const void* upload_src = nullptr;  // Host source (null = no upload)
+    size_t upload_bytes = 0;
+    void* upload_dst = nullptr;        // id<MTLBuffer> destination
+    size_t upload_dst_offset = 0;
+
+    // GPU -> host per step: this stream's logits/token region
+    void* download_src = nullptr;      // id<MTLBuffer> source (null = no download)
+    size_t download_offset = 0;
+    size_t download_bytes = 0;
+};
+
+/**
+ * One stream's readback from a submitted step
+ */
+struct DecodeStreamReadback {
+    uint64_t stream_id = 0;
+
+    // BlitQueue operation id for this stream's download (0 = no download)
+    uint64_t op_id = 0;
+
+    // Batcher-owned staging slot the download lands in; valid until the
+    // stream is unregistered or the next step's download completes
+    const uint8_t* data = nullptr;
+    size_t bytes = 0;
+};
+
+/**
+ * Everything produced by one submitDecodeStep() call
+ */
+struct DecodeStepResult {
+    // Coalesced upload covering every stream (0 = nothing to upload)
+    uint64_t upload_op = 0;
+
+    // GPU-side signal encoded after the step's compute; chain further
+    // work on it with BlitQueue::encodeWait()
+    BlitQueue::EventHandle compute_done;
+
+    // Per-stream downloads, in registration order
+    std::vector<DecodeStreamReadback> readbacks;
+};
+
+/**
+ * Batched Multi-Stream Decode Submission
+ *
+ * With every decode stream driving its own acquire/upload/commit/
+ * download cycle, N streams cost N command buffer submissions per step
+ * even when their compute shares one. The batcher makes the per-step
+ * CPU cost O(1) in stream count: register active streams once, then a
+ * single submitDecodeStep() per step
+ *
+ * 1. coalesces every stream's host->GPU upload into one
+ *    BlitQueue::uploadBatchAsync() command buffer,
+ * 2. acquires ONE decode-lane buffer from the CommandBufferRing and
+ *    encodes a GPU-side wait on the upload batch (no CPU stall),
+ * 3. lets the caller encode the shared batched compute into that
+ *    buffer via the encode hook,
+ * 4. encodes a shared-event signal after the compute and releases the
+ *    buffer back to the ring (releaseBuffer() commits it), and
+ * 5. fans results back out with one downloadAsyncAfter() per stream
+ *    into batcher-owned staging slots, chained on the compute signal.
+ *
+ * Readback slots are stable host memory — hand a slot straight to
+ * Sampler::sample() pointer APIs or a StreamingDecoder once its op
+ * completes.
+ *
+ * Thread Safety:
+ * - All public methods are thread-safe (mutex); submitDecodeStep() is
+ *   expected on one scheduler thread
+ *
+ * Example:
+ *     DecodeBatcher batcher(config, &ring, &blit);
+ *     batcher.registerStream({ctx->streamId(), token_src, 4, input_buf, 0,
+ *                             logits_buf, 0, vocab_bytes});
+ *     // ... per step:
+ *     auto step = batcher.submitDecodeStep([&](void* cmd) {
+ *         encodeBatchedDecodeKernel(cmd);  // one dispatch, all streams
+ *     });
+ *     batcher.waitForStep(step);
+ *     for (const auto& rb : step.readbacks) {
+ *         sampleFrom(rb.data, rb.bytes);   // per-stream logits
+ *     }
+ */
+class DecodeBatcher {
+public:
+    /**
+     * Configuration for Decode Batcher
+     */
+    struct Config {
+        // Maximum streams registered at once
+        uint32_t max_streams = 64;
+
+        // Enable statistics collection
+        bool enable_stats = true;
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t steps_submitted;     // submitDecodeStep() calls
+        uint64_t streams_submitted;   // Stream-steps covered (sum over steps)
+        uint64_t uploads_coalesced;   // Upload regions folded into batches
+        uint64_t downloads_issued;    // Per-stream readbacks issued
+        size_t streams_registered;    // Streams currently registered
+
+        // Streams covered per submission (the coalescing win)
+        double getAvgStreamsPerStep() const {
+            if (steps_submitted == 0) return 0.0;
+            return static_cast<double>(streams_submitted) / steps_submitted;
+        }
+    };
+
+    /**
+     * Hook that encodes the step's batched compute into the shared
+     * command buffer (id<MTLCommandBuffer> as void*). Encode only —
+     * never commit; the ring commits the buffer on release.
+     */
+    using EncodeHook = std::function<void(void* command_buffer)>;
+
+    /**
+     * Create a decode batcher over an existing ring and blit queue
+     *
+     * @param config Batcher configuration
+     * @param ring Command buffer ring (not owned, must outlive the batcher)
+     * @param blit Blit queue (not owned, must outlive the batcher)
+     * @throws std::invalid_argument if config or dependencies are invalid
+     */
+    DecodeBatcher(const Config& config, CommandBufferRing* ring, BlitQueue* blit);
+
+    ~DecodeBatcher();
+
+    // Non-copyable, non-movable (holds staging slots referenced by blits)
+    DecodeBatcher(const DecodeBatcher&) = delete;
+    DecodeBatcher& operator=(const DecodeBatcher&) = delete;
+
+    /**
+     * Register a stream for subsequent steps
+     *
+     * Allocates the stream's staging slot (download_bytes). The slot
+     * pointer stays stable until unregisterStream().
+     *
+     * @param slot Transfer layout for the stream
+     * @throws std::invalid_argument if the id is already registered,
+     *         the batcher is full, or the layout is inconsistent
+     */
+    void registerStream(const DecodeStreamSlot& slot);
+
+    /**
+     * Remove a stream (e.g. at stream end)
+     *
+     * The caller must ensure no in-flight step still targets the
+     * stream's staging slot (waitForStep() the last result first).
+     *
+     * @param stream_id Id passed at registration
+     * @return true if the stream was registered
+     */
+    bool unregisterStream(uint64_t stream_id);
+
+    /**
+     * Submit one decode step covering every registered stream
+     *
+     * One upload batch, one ring submission, one signal, N chained
+     * readbacks — constant submissions regardless of stream count.
+     *
+     * @param encode_compute Hook encoding the batched compute (may be
+     *        null: transfers and event chaining only)
+     * @return Per-stream readback handles for this step
+     * @throws std::runtime_error if no streams are registered
+     */
+    DecodeStepResult submitDecodeStep(const EncodeHook& encode_compute = nullptr);
+
+    /**
+     * Block until every readback of a step has landed
+     *
+     * @param step Result from submitDecodeStep()
+     * @param timeout_ms Per-operation timeout (0 = wait forever)
+     * @return false if any operation timed out
+     */
+    bool waitForStep(const DecodeStepResult& step, uint32_t timeout_ms = 0);
+
+    /**
+     * Get number of streams currently registered
+     */
+    size_t streamCount() const;
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+private:
+    /**
+     * Registered stream plus its staging slot
+     */
+    struct StreamEntry {
+        DecodeStreamSlot slot;
+        std::unique_ptr<uint8_t[]> staging;
+    };
+
+    /**
+     * Validate configuration and dependencies
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    Config config_;
+    CommandBufferRing* ring_;  // Not owned
+    BlitQueue* blit_;          // Not owned
+
+    mutable std::mutex mutex_;
+    std::vector<StreamEntry> streams_;
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> steps_submitted_{0};
+    mutable std::atomic<uint64_t> streams_submitted_{0};
+    mutable std::atomic<uint64_t> uploads_coalesced_{0};
+    mutable std::atomic<uint64_t> downloads_issued_{0};
+};
+
+} // namespace krserve
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "kr_kv_block_pool.h"
+
+namespace krserve {
+
+/**
+ * Native Continuous-Batching GPU Scheduler
+ *
+ * C++ replacement for the asyncio hot loop in python/gpu_scheduler.py.
+ * The Python scheduler's per-tick cost (~ms) and GC jitter cap throughput
+ * well below what the GPU sustains; here the inner loop is native and
+ * Python only receives the composed batch.
+ *
+ * Three pieces:
+ * - Priority work queue with per-worker deques and work stealing:
+ *   submissions spread round-robin across workers, a worker pops its own
+ *   deque front (FIFO within priority) and steals from other workers'
+ *   backs when idle
+ * - Admission control driven by the paged KV block pool: a request joins
+ *   a batch only when the pool can cover its blocks_needed plus a
+ *   configured reserve, so admission can't trigger mid-decode OOM
+ * - Batch composition: composeBatch() is called once per decode step and
+ *   returns the full active set — continuing sequences plus any newly
+ *   admitted requests, highest priority first (join/leave per step)
+ *
+ * Priorities match python/gpu_scheduler.py JobPriority:
+ * 0 = URGENT, 1 = DEFAULT, 2 = LOW.
+ *
+ * Thread Safety:
+ * - All public methods are thread-safe
+ * - Per-worker deque locks keep submit/pop contention off the batch path
+ *
+ * Example:
+ *     GpuScheduler::Config config;
+ *     config.max_batch_size = 16;
+ *     GpuScheduler scheduler(config, &kv_pool);
+ *
+ *     scheduler.submit({.request_id = id, .priority = 1, .blocks_needed = 50});
+ *
+ *     // Per decode step:
+ *     auto batch = scheduler.composeBatch();
+ *     runDecodeStep(batch);
+ *     for (uint64_t finished : finished_ids) {
+ *         scheduler.completeRequest(finished);
+ *     }
+ */
+class GpuScheduler {
+public:
+    /**
+     * Configuration for GPU Scheduler
+     */
+    struct Config {
+        // Worker deques (match engine worker thread count)
+        uint32_t num_workers = 4;
+
+        // Maximum sequences decoding concurrently
+        uint32_t max_batch_size = 16;
+
+        // KV pages held back from admission (decode growth headroom)
+        uint32_t admission_reserve_blocks = 64;
+
+        // Enable statistics collection
+        bool enable_stats = true;
+    };
+
+    /**
+     * A unit of schedulable work
+     */
+    struct Request {
+        uint64_t request_id = 0;     // Caller-assigned unique ID
+        uint32_t priority = 1;       // 0 = urgent, 1 = default, 2 = low
+        uint32_t blocks_needed = 0;  // KV pages the prefill will allocate
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t submitted;           // Requests submitted
+        uint64_t admitted;            // Requests admitted into a batch
+        uint64_t completed;           // Requests completed
+        uint64_t admission_deferrals; // Times admission was blocked on KV pages
+        uint64_t steals;              // Requests taken from another worker's deque
+        uint64_t batches_composed;    // composeBatch calls
+        uint64_t total_queue_wait_us; // Total submit -> admit wait
+        uint32_t queued;              // Requests currently queued
+        uint32_t active;              // Sequences currently decoding
+
+        // Average queue wait per admitted request (microseconds)
+        double getAvgQueueWaitUs() const {
+            if (admitted == 0) return 0.0;
+            return static_cast<double>(total_queue_wait_us) / admitted;
+        }
+    };
+
+    /**
+     * Create a scheduler
+     *
+     * @param config Scheduler configuration
+     * @param kv_pool KV block pool used for admission control (may be null
+     *        to disable admission checks; not owned, must outlive this)
+     * @throws std::invalid_argument if config is invalid
+     */
+    explicit GpuScheduler(const Config& config, KVBlockPool* kv_pool = nullptr);
+
+    /**
+     * Destructor
+     */
+    ~GpuScheduler();
+
+    // Non-copyable, non-movable (RAII pattern)
+    GpuScheduler(const GpuScheduler&) = delete;
+    GpuScheduler& operator=(const GpuScheduler&) = delete;
+    GpuScheduler(GpuScheduler&&) = delete;
+    GpuScheduler& operator=(GpuScheduler&&) = delete;
+
+    /**
+     * Submit a request for scheduling
+     *
+     * Round-robins across worker deques. Never blocks.
+     *
+     * @param request Request to queue (request_id must be unique among
+     *        queued/active requests)
+     */
+    void submit(const Request& request);
+
+    /**
+     * Compose the batch for the next decode step
+     *
+     * Returns all currently decoding request IDs plus newly admitted
+     * requests, highest priority first. Admission pops queued requests
+     * while the batch has room and the KV pool can cover blocks_needed
+     * plus the configured reserve; the first request that doesn't fit
+     * stops admission for its priority (no starvation via queue jumping).
+     *
+     * @return Request IDs composing this step's batch
+     */
+    std::vector<uint64_t> composeBatch();
+
+    /**
+     * Pop one request for direct execution (worker-pool mode)
+     *
+     * Tries the worker's own deques highest priority first, then steals
+     * from the back of other workers' deques. Does not apply admission
+     * control — use composeBatch() for the batched decode path.
+     *
+     * @param worker_id Worker index (< num_workers)
+     * @param request Output request
+     * @return true if a request was popped
+     */
+    bool popRequest(uint32_t worker_id, Request& request);
+
+    /**
+     * Mark a sequence finished (leaves the batch)
+     *
+     * @param request_id ID previously returned by composeBatch()
+     */
+    void completeRequest(uint64_t request_id);
+
+    /**
+     * Requests currently queued across all workers
+     */
+    uint32_t queuedCount() const;
+
+    /**
+     * Sequences currently in the decode batch
+     */
+    uint32_t activeCount() const;
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+private:
+    static constexpr uint32_t NUM_PRIORITIES = 3;
+
+    // Queued request with its enqueue timestamp for wait accounting
+    struct QueuedRequest {
+        Request request;
+        uint64_t enqueue_time_us = 0;
+    };
+
+    // One worker's priority deques
+    struct Worker {
+        std::mutex mutex;
+        std::deque<QueuedRequest> queues[NUM_PRIORITIES];
+    };
+
+    /**
+     * Validate configuration
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    /**
+     * KV pages available for admission (pool capacity minus in-use)
+     */
+    uint32_t availableBlocks() const;
+
+    /**
+     * Pop the oldest request of the highest non-empty priority <= max_priority
+     * from any worker (used by composeBatch)
+     * @return true if popped
+     */
+    bool popHighestPriority(QueuedRequest& out);
+
+    Config config_;
+    KVBlockPool* kv_pool_;  // Not owned (may be null)
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> next_submit_worker_{0};
+
+    mutable std::mutex active_mutex_;
+    std::unordered_set<uint64_t> active_;
+    std::vector<uint64_t> active_order_;  // Join order for stable batches
+    std::unordered_map<uint64_t, uint32_t> active_blocks_;  // For reserve accounting
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> submitted_{0};
+    mutable std::atomic<uint64_t> admitted_{0};
+    mutable std::atomic<uint64_t> completed_{0};
+    mutable std::atomic<uint64_t> admission_deferrals_{0};
+    mutable std::atomic<uint64_t> steals_{0};
+    mutable std::atomic<uint64_t> batches_composed_{0};
+    mutable std::atomic<uint64_t> total_queue_wait_us_{0};
+    mutable std::atomic<uint32_t> queued_{0};
+};
+
+} // namespace krserve
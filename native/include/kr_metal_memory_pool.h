@@ -43,6 +43,14 @@ public:
         std::vector<size_t> warmup_sizes;   // Buffer sizes to pre-allocate (MB)
         bool track_statistics = true;        // Track statistics
         bool log_exhaustion = true;          // Log when pool is exhausted
+        size_t min_buffer_class_kb = 64;     // Smallest suballocation size class (KB)
+
+        // Elastic pooling: register for system memory-pressure
+        // notifications, mark idle heaps purgeable under pressure
+        // (re-committed lazily on demand), and grow the pool up to
+        // max_heaps when it runs dry instead of falling back
+        bool elastic = false;
+        size_t max_heaps = 8;                // Growth ceiling when elastic
     };
 
     /**
@@ -55,6 +63,20 @@ public:
         uint64_t fallback_events;     // Times fallback allocation used
         size_t pool_size;             // Total pool size
         size_t available_count;       // Currently available heaps
+
+        // Suballocation metrics (acquireBuffer/releaseBuffer path)
+        uint64_t buffers_acquired;    // Total buffers acquired
+        uint64_t buffers_released;    // Total buffers released
+        uint64_t buffer_cache_hits;   // Buffers reused from a free list
+        uint64_t buffer_fallbacks;    // Buffers allocated outside pooled heaps
+        size_t buffers_in_use;        // Currently outstanding buffers
+        size_t bytes_in_use;          // Bytes held by outstanding buffers
+
+        // Elastic pooling metrics
+        uint64_t pressure_events;     // Memory-pressure notifications handled
+        uint64_t heaps_purged;        // Idle heaps marked purgeable
+        uint64_t heaps_recommitted;   // Purged heaps brought back on demand
+        uint64_t heaps_grown;         // Heaps added beyond the initial pool
     };
 
     /**
@@ -95,6 +117,36 @@ public:
      */
     void releaseHeap(void* heap);
 
+    /**
+     * Acquire a buffer of at least `size` bytes, suballocated from the
+     * pooled heaps
+     *
+     * Sizes are rounded up to power-of-two size classes (starting at
+     * min_buffer_class_kb) and recycled through per-class free lists, so
+     * hundreds of small transient buffers can share the heaps instead of
+     * each pinning a whole 256 MB heap. Falls back to a device allocation
+     * (counted in buffer_fallbacks) only when every pooled heap is full.
+     *
+     * Thread-safe.
+     *
+     * @param size Requested size in bytes (must be > 0)
+     * @return MTLBuffer object (id<MTLBuffer> cast to void*), or nullptr
+     *         if even the fallback allocation fails
+     */
+    void* acquireBuffer(size_t size);
+
+    /**
+     * Release a buffer previously acquired via acquireBuffer()
+     *
+     * Pool-backed buffers return to their size-class free list for reuse;
+     * fallback buffers are released via ARC.
+     *
+     * Thread-safe. Safe to call with nullptr (no-op).
+     *
+     * @param buffer MTLBuffer object (id<MTLBuffer> cast from void*)
+     */
+    void releaseBuffer(void* buffer);
+
     /**
      * Pre-warm pool with common buffer sizes
      *
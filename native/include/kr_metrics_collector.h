@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include <atomic>
-#include <vector>
+#include <array>
 #include <mutex>
 
 namespace krserve {
@@ -10,7 +10,13 @@ namespace krserve {
 /**
  * High-performance metrics collector
  *
- * Thread-safe lock-free counters with periodic statistical aggregation.
+ * The record path is lock-free: counters are sharded across a fixed set of
+ * cache-line-padded shards (one picked per thread on first use), and
+ * latencies go into per-shard log-scale histograms (HDR-style: power-of-two
+ * major buckets with linear sub-buckets, ~12.5% relative error bound).
+ * Every completion lands in a bucket — nothing is sampled or dropped — so
+ * percentiles cover the full window. getMetrics() merges the shards
+ * on demand; only the reader pays that cost.
  */
 class MetricsCollector {
 public:
@@ -48,7 +54,7 @@ public:
     };
 
     /**
-     * Get current metrics (computed on-demand)
+     * Get current metrics (merged across shards, computed on-demand)
      */
     Metrics getMetrics() const;
 
@@ -58,20 +64,47 @@ public:
     void reset();
 
 private:
-    std::atomic<uint64_t> total_requests_{0};
-    std::atomic<uint64_t> completed_requests_{0};
-    std::atomic<uint64_t> failed_requests_{0};
-    std::atomic<uint64_t> sum_latency_ns_{0};  // Use nanoseconds for precision
-
-    // Latency samples for percentile calculation
-    mutable std::mutex samples_mutex_;
-    std::vector<double> latency_samples_;
-    static constexpr size_t MAX_SAMPLES = 1000;
-
-    // Throughput calculation
-    mutable std::mutex throughput_mutex_;
-    uint64_t throughput_window_start_ns_;
-    uint64_t throughput_requests_;
+    // Shard count: power of two, enough to spread M3 Max/Ultra thread counts
+    static constexpr size_t NUM_SHARDS = 16;
+
+    // Histogram geometry: latencies in nanoseconds, 8 linear sub-buckets per
+    // power-of-two major bucket. 64 majors cover the full uint64 range, so
+    // any latency from 1ns to ~580 years lands in a bucket.
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr size_t NUM_BUCKETS = 64 * SUB_BUCKETS;
+
+    // Per-thread shard of counters + histogram. Padded to its own cache
+    // lines so threads on different shards never false-share.
+    struct alignas(128) Shard {
+        std::atomic<uint64_t> total_requests{0};
+        std::atomic<uint64_t> completed_requests{0};
+        std::atomic<uint64_t> failed_requests{0};
+        std::atomic<uint64_t> sum_latency_ns{0};
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> histogram{};
+    };
+
+    /**
+     * Shard for the calling thread (assigned round-robin on first use)
+     */
+    Shard& localShard();
+    const Shard& shardAt(size_t index) const { return shards_[index]; }
+
+    /**
+     * Histogram bucket index for a latency in nanoseconds
+     */
+    static size_t bucketFor(uint64_t latency_ns);
+
+    /**
+     * Representative latency (bucket midpoint) in milliseconds
+     */
+    static double bucketMidpointMs(size_t bucket);
+
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::atomic<size_t> next_shard_{0};
+
+    // Throughput window start (reset() restarts the window)
+    std::atomic<uint64_t> throughput_window_start_ns_;
 };
 
 } // namespace krserve
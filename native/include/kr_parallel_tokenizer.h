@@ -11,9 +11,13 @@
 #include <condition_variable>
 #include <queue>
 #include <future>
+#include <unordered_map>
+#include <utility>
 
 namespace krserve {
 
+class BpeEngine;
+
 /**
  * Configuration for parallel tokenizer
  */
@@ -84,6 +88,87 @@ struct ParallelTokenizerStatistics {
 
     // Accelerate framework usage
     uint64_t accelerate_ops = 0;
+
+    // Encodes served by the native BPE engine (no Python callback)
+    uint64_t native_encodes = 0;
+
+    // Tokens decoded through streaming decoders (returned to the pool)
+    uint64_t stream_tokens = 0;
+};
+
+/**
+ * Incremental Streaming Detokenizer
+ *
+ * Per-stream decode state: feed one token id at a time and get back only
+ * the bytes that became safe to emit — i.e. everything up to the last
+ * complete UTF-8 character. BPE tokens can split multi-byte characters
+ * across token boundaries, so the decoder holds the incomplete tail
+ * (at most 3 bytes) until the continuation bytes arrive.
+ *
+ * This replaces the re-decode-everything-per-token pattern: emission is
+ * O(bytes of this token), independent of how long the stream already is.
+ *
+ * Instances are obtained from ParallelTokenizer::acquireStreamDecoder()
+ * and returned with releaseStreamDecoder() so per-stream state is pooled
+ * across requests instead of reallocated.
+ *
+ * Thread Safety: each instance serves one stream; not thread-safe.
+ */
+class StreamingDecoder {
+public:
+    /**
+     * Create a streaming decoder bound to a BPE engine
+     * @param engine Loaded engine (shared with the owning tokenizer)
+     */
+    explicit StreamingDecoder(std::shared_ptr<BpeEngine> engine);
+
+    /**
+     * Feed one token id and get the newly-safe bytes
+     *
+     * Appends the token's raw bytes to the pending tail and emits every
+     * byte up to the last complete UTF-8 boundary. Unknown token ids
+     * contribute no bytes.
+     *
+     * @param token_id Token to decode
+     * @return Bytes safe to forward to the client (may be empty)
+     */
+    std::string feed(uint32_t token_id);
+
+    /**
+     * Emit whatever is still pending at end of stream
+     *
+     * Called once when the stream finishes; any trailing incomplete
+     * character is emitted as-is rather than dropped.
+     *
+     * @return Remaining pending bytes (may be empty)
+     */
+    std::string flush();
+
+    /**
+     * Clear all stream state for reuse on a new stream
+     */
+    void reset();
+
+    /**
+     * Bytes currently held back waiting for a UTF-8 continuation
+     */
+    size_t pendingBytes() const { return pending_.size(); }
+
+    /**
+     * Tokens fed since construction or the last reset
+     */
+    uint64_t tokensFed() const { return tokens_fed_; }
+
+private:
+    std::shared_ptr<BpeEngine> engine_;
+
+    // Incomplete UTF-8 tail carried between feed() calls
+    std::string pending_;
+
+    uint64_t tokens_fed_ = 0;
+
+    // Pool bookkeeping (engine identity check on release)
+    friend class ParallelTokenizer;
 };
 
 /**
@@ -169,6 +254,152 @@ public:
         const std::function<std::vector<uint32_t>(const std::string&)>& tokenizer_fn
     );
 
+    /**
+     * Completion callback for callback-style async encodes
+     *
+     * Exactly one of the two arguments is meaningful: on success the
+     * token vector is set and the exception pointer is null; on failure
+     * the vector is empty and the pointer carries the error.
+     */
+    using EncodeCallback = std::function<void(std::vector<uint32_t>, std::exception_ptr)>;
+
+    /**
+     * Asynchronous encode with a completion callback
+     *
+     * Same thread-pool execution as encodeAsync(), but the result is
+     * delivered by invoking `on_complete` from the worker thread instead
+     * of through a std::future. A future cannot register a continuation,
+     * so this is the hook event-loop integrations (e.g. the asyncio
+     * bindings) use to get notified without blocking a thread.
+     *
+     * @param text Input text to tokenize
+     * @param tokenizer_fn Tokenization function
+     * @param on_complete Invoked on a pool thread with the result or error
+     */
+    void encodeAsyncCallback(
+        const std::string& text,
+        const std::function<std::vector<uint32_t>(const std::string&)>& tokenizer_fn,
+        EncodeCallback on_complete
+    );
+
+    /**
+     * Asynchronous native-engine encode with a completion callback
+     *
+     * Callback-style counterpart of encodeNative(): the encode runs on
+     * the thread pool with no Python involvement and `on_complete` fires
+     * from the worker thread. A missing vocabulary is reported through
+     * the callback's exception pointer, not thrown to the caller.
+     *
+     * @param text Input text to tokenize
+     * @param on_complete Invoked on a pool thread with the result or error
+     */
+    void encodeNativeAsync(
+        const std::string& text,
+        EncodeCallback on_complete
+    );
+
+    /**
+     * Load a native BPE vocabulary from GPT-2 style files
+     *
+     * After loading, encodeNative()/encodeBatchNative() run entirely in
+     * C++ with no Python callback, so the bindings can release the GIL
+     * and the OpenMP fan-out scales across all configured threads.
+     *
+     * @param vocab_path Path to vocab.json
+     * @param merges_path Path to merges.txt
+     * @throws std::runtime_error if files cannot be read or parsed
+     */
+    void loadVocabulary(const std::string& vocab_path, const std::string& merges_path);
+
+    /**
+     * Load a native BPE vocabulary from pre-parsed tables
+     *
+     * @param vocab Token string -> token id
+     * @param merges Merge pairs in rank order
+     */
+    void loadVocabularyFromTables(
+        const std::unordered_map<std::string, uint32_t>& vocab,
+        const std::vector<std::pair<std::string, std::string>>& merges
+    );
+
+    /**
+     * Load a compiled vocabulary by memory-mapping it (zero-copy)
+     *
+     * Startup path for serving replicas: one map call instead of the
+     * JSON parse, with the mapped pages shared across forked workers.
+     * Build the artifact once with compileVocabulary().
+     *
+     * @param path Path to a compiled vocabulary file
+     * @throws std::runtime_error if the file is invalid
+     */
+    void loadCompiledVocabulary(const std::string& path);
+
+    /**
+     * Compile the loaded vocabulary into a flat mmap-able file
+     *
+     * One-time offline build after loadVocabulary(); the output loads
+     * via loadCompiledVocabulary().
+     *
+     * @param output_path Output path for the compiled vocabulary
+     * @throws std::runtime_error if no vocabulary is loaded
+     */
+    void compileVocabulary(const std::string& output_path) const;
+
+    /**
+     * Check if a native BPE vocabulary is loaded
+     */
+    bool hasNativeEngine() const;
+
+    /**
+     * Encode a single text with the native BPE engine
+     *
+     * No callback, no GIL dependency. For large strings the text is split
+     * on UTF-8 boundaries and chunks are encoded in parallel with OpenMP.
+     *
+     * @param text Input text to tokenize
+     * @return Vector of token IDs
+     * @throws std::runtime_error if no vocabulary is loaded
+     */
+    std::vector<uint32_t> encodeNative(const std::string& text);
+
+    /**
+     * Encode a batch of texts with the native BPE engine
+     *
+     * Fans the batch out across OpenMP threads. This is the path that
+     * delivers the advertised batch speedup: with no Python in the loop,
+     * all num_threads workers encode concurrently.
+     *
+     * @param texts Input texts to tokenize
+     * @return Vector of token ID vectors (one per input text)
+     * @throws std::runtime_error if no vocabulary is loaded
+     */
+    std::vector<std::vector<uint32_t>> encodeBatchNative(
+        const std::vector<std::string>& texts
+    );
+
+    /**
+     * Acquire a pooled streaming decoder for one output stream
+     *
+     * Reuses a previously released decoder when one is available so high
+     * stream churn does not allocate per request. The decoder is handed
+     * out reset and bound to the current native engine.
+     *
+     * @return Decoder ready for feed()/flush()
+     * @throws std::runtime_error if no vocabulary is loaded
+     */
+    std::shared_ptr<StreamingDecoder> acquireStreamDecoder();
+
+    /**
+     * Return a streaming decoder to the pool
+     *
+     * Folds the decoder's token count into the statistics and parks the
+     * instance for the next acquireStreamDecoder() call. Decoders bound
+     * to a since-replaced vocabulary are dropped instead of pooled.
+     *
+     * @param decoder Decoder obtained from acquireStreamDecoder()
+     */
+    void releaseStreamDecoder(std::shared_ptr<StreamingDecoder> decoder);
+
     /**
      * Get current statistics
      */
@@ -212,6 +443,15 @@ private:
     mutable std::atomic<double> speedup_ratio_{1.0};
     mutable std::atomic<uint32_t> active_threads_{0};
     mutable std::atomic<uint64_t> accelerate_ops_{0};
+    mutable std::atomic<uint64_t> native_encodes_{0};
+    mutable std::atomic<uint64_t> stream_tokens_{0};
+
+    // Native BPE engine (owned; null until a vocabulary is loaded)
+    std::shared_ptr<BpeEngine> engine_;
+
+    // Pooled streaming decoders awaiting reuse
+    std::vector<std::shared_ptr<StreamingDecoder>> decoder_pool_;
+    std::mutex decoder_pool_mutex_;
 
     // Thread pool for async operations
     std::vector<std::thread> thread_pool_;
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "kr_kv_block_pool.h"
+
+namespace krserve {
+
+/**
+ * Token-Prefix Radix Tree
+ *
+ * Longest-prefix index over token-ID sequences for KV-cache reuse. The
+ * hash map in KVBlockPool (and _compute_prefix_hash in the Python pool)
+ * only matches a whole prefix exactly; system-prompt-heavy traffic where
+ * requests share the first several hundred tokens but then diverge almost
+ * never hits it. The radix tree matches the deepest cached chain instead,
+ * so prefill restarts from the divergence point rather than token zero.
+ *
+ * Tokens are indexed at token granularity with path compression; reuse is
+ * returned at block granularity (only blocks whose every token matched are
+ * reusable under paged attention). Each node holds its own block-pool
+ * references, so chains stay alive while any tree path needs them and the
+ * pool's LRU eviction cannot free them out from under the index.
+ *
+ * Thread Safety:
+ * - All public methods are thread-safe (single tree mutex; the tree walk
+ *   is pointer chasing, far cheaper than the prefill it saves)
+ *
+ * Example:
+ *     PrefixTree tree(&kv_pool);
+ *
+ *     auto match = tree.matchLongestPrefix(prompt_tokens);
+ *     // match.blocks covers match.matched_tokens — prefill resumes there
+ *
+ *     // After prefilling the full prompt into `blocks`:
+ *     tree.insert(prompt_tokens, blocks);
+ */
+class PrefixTree {
+public:
+    /**
+     * Result of a longest-prefix match
+     */
+    struct MatchResult {
+        // Cached chain covering matched_tokens (caller owns one reference
+        // per block and must releaseBlocks() when the sequence finishes)
+        std::vector<uint32_t> blocks;
+
+        // Tokens covered by `blocks` (multiple of the pool's block size)
+        size_t matched_tokens = 0;
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t inserts;          // Chains inserted
+        uint64_t lookups;          // matchLongestPrefix calls
+        uint64_t hits;             // Lookups that matched at least one block
+        uint64_t tokens_matched;   // Total tokens served from cache
+        uint64_t leaf_evictions;   // Leaves evicted via evictLeaves
+        uint32_t node_count;       // Nodes currently in the tree
+
+        // Fraction of lookups that reused at least one block
+        double getHitRate() const {
+            if (lookups == 0) return 0.0;
+            return static_cast<double>(hits) / lookups;
+        }
+    };
+
+    /**
+     * Create a prefix tree over a KV block pool
+     *
+     * @param pool Block pool backing the cached chains (not owned, must
+     *        outlive this tree)
+     * @throws std::invalid_argument if pool is null
+     */
+    explicit PrefixTree(KVBlockPool* pool);
+
+    /**
+     * Destructor - releases all held block references
+     */
+    ~PrefixTree();
+
+    // Non-copyable, non-movable (RAII pattern)
+    PrefixTree(const PrefixTree&) = delete;
+    PrefixTree& operator=(const PrefixTree&) = delete;
+    PrefixTree(PrefixTree&&) = delete;
+    PrefixTree& operator=(PrefixTree&&) = delete;
+
+    /**
+     * Insert a prefilled chain under its token sequence
+     *
+     * The tree takes its own references on the stored blocks (the caller
+     * keeps and later releases its own). Only complete blocks are indexed;
+     * trailing tokens that don't fill a block are ignored. Where the new
+     * sequence shares a path with an existing one the edge is split, so
+     * divergent continuations of a common system prompt share the common
+     * blocks.
+     *
+     * @param tokens Full token sequence that was prefilled
+     * @param blocks Chain from KVBlockPool covering those tokens (at least
+     *        tokens.size() / block_size_tokens complete blocks)
+     */
+    void insert(const std::vector<uint32_t>& tokens,
+                const std::vector<uint32_t>& blocks);
+
+    /**
+     * Find the deepest cached chain matching a token-sequence prefix
+     *
+     * Walks the tree as far as the tokens agree, then returns the cached
+     * blocks covering the matched span (truncated to whole blocks). The
+     * returned blocks are retained for the caller — release them via
+     * KVBlockPool::releaseBlocks() when the sequence finishes.
+     *
+     * @param tokens Prompt token sequence
+     * @return Deepest cached chain and the token count it covers
+     *         (matched_tokens == 0 on a complete miss)
+     */
+    MatchResult matchLongestPrefix(const std::vector<uint32_t>& tokens);
+
+    /**
+     * Evict least-recently-matched leaf chains
+     *
+     * Releases the block references held by up to `count` leaves, oldest
+     * access first, returning their pages to pool-eviction eligibility.
+     * Interior nodes shared by other paths are untouched.
+     *
+     * @param count Maximum leaves to evict
+     * @return Leaves actually evicted
+     */
+    uint32_t evictLeaves(uint32_t count);
+
+    /**
+     * Remove everything from the tree, releasing all block references
+     */
+    void clear();
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+private:
+    // Radix node: edge holds the (path-compressed) tokens from the parent
+    struct Node {
+        std::vector<uint32_t> edge;    // Tokens on the edge from parent
+        size_t depth = 0;              // Tokens from root through this node
+        std::vector<uint32_t> blocks;  // Chain covering depth's complete
+                                       // blocks (ref-held by the tree)
+        uint64_t last_access = 0;      // Logical clock of last match/insert
+        std::unordered_map<uint32_t, std::unique_ptr<Node>> children;
+    };
+
+    /**
+     * Chain prefix covering the complete blocks of `depth` tokens
+     */
+    std::vector<uint32_t> chainForDepth(const std::vector<uint32_t>& blocks,
+                                        size_t depth) const;
+
+    /**
+     * Release a node's chain and recurse into its children
+     */
+    void releaseSubtree(Node* node);
+
+    KVBlockPool* pool_;  // Not owned
+    uint32_t block_tokens_ = 0;
+
+    mutable std::mutex tree_mutex_;
+    std::unique_ptr<Node> root_;
+    uint64_t access_clock_ = 0;
+    uint32_t node_count_ = 0;
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> inserts_{0};
+    mutable std::atomic<uint64_t> lookups_{0};
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> tokens_matched_{0};
+    mutable std::atomic<uint64_t> leaf_evictions_{0};
+};
+
+} // namespace krserve
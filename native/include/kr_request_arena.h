@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace krserve {
+
+class RequestArena;
+
+/**
+ * Pool of Recycled Arena Blocks
+ *
+ * Backing store for RequestArena. Arenas draw fixed-size blocks from
+ * here and return them wholesale when the request completes, so
+ * steady-state request traffic does zero mallocs: the same blocks
+ * cycle between the pool and live arenas.
+ *
+ * Thread Safety:
+ * - All public methods are thread-safe
+ * - Block acquire/release is a short locked vector push/pop
+ *
+ * Example:
+ *     ArenaPool::Config config;
+ *     config.block_size = 256 * 1024;
+ *     ArenaPool pool(config);
+ *
+ *     {
+ *         RequestArena arena(&pool);       // per request
+ *         auto* scratch = arena.allocate<uint32_t>(1024);
+ *         // ... tokenize / schedule / track ops ...
+ *     }                                    // all freed en masse
+ */
+class ArenaPool {
+public:
+    /**
+     * Configuration for Arena Pool
+     */
+    struct Config {
+        // Bytes per arena block (allocations larger than half of this
+        // get a dedicated oversize block)
+        size_t block_size = 256 * 1024;
+
+        // Blocks created eagerly at construction (warm start)
+        size_t initial_blocks = 0;
+
+        // Blocks kept for reuse; beyond this, returned blocks are freed
+        size_t max_pooled_blocks = 64;
+
+        // Enable statistics collection
+        bool enable_stats = true;
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t blocks_created;   // Blocks malloc'd (pool misses + warm)
+        uint64_t blocks_recycled;  // Blocks served from the pool
+        uint64_t blocks_dropped;   // Returned blocks freed (pool full)
+        uint64_t arenas_created;   // RequestArena instances constructed
+        uint64_t bytes_allocated;  // Total bytes handed out by arenas
+        uint64_t allocations;      // Total arena allocations
+        uint64_t oversize_allocations; // Allocations needing dedicated blocks
+        size_t blocks_pooled;      // Blocks currently idle in the pool
+
+        // Fraction of block demand served without malloc
+        double getRecycleRate() const {
+            uint64_t total = blocks_created + blocks_recycled;
+            if (total == 0) return 0.0;
+            return static_cast<double>(blocks_recycled) / total;
+        }
+    };
+
+    /**
+     * Create an arena pool
+     *
+     * @param config Pool configuration
+     * @throws std::invalid_argument if config is invalid
+     */
+    explicit ArenaPool(const Config& config);
+
+    /**
+     * Create an arena pool with default configuration
+     */
+    ArenaPool() : ArenaPool(Config{}) {}
+
+    /**
+     * Destructor - frees all pooled blocks
+     */
+    ~ArenaPool();
+
+    // Non-copyable, non-movable (RAII pattern)
+    ArenaPool(const ArenaPool&) = delete;
+    ArenaPool& operator=(const ArenaPool&) = delete;
+    ArenaPool(ArenaPool&&) = delete;
+    ArenaPool& operator=(ArenaPool&&) = delete;
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+private:
+    friend class RequestArena;
+
+    /**
+     * One arena block (bump-allocated by a single arena at a time)
+     */
+    struct Block {
+        explicit Block(size_t block_capacity);
+
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity;
+
+        // Bump cursor; reset when the block returns to the pool
+        std::atomic<size_t> used{0};
+    };
+
+    /**
+     * Validate configuration
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    /**
+     * Hand out a standard block (recycled if available, else new)
+     */
+    std::unique_ptr<Block> acquireBlock();
+
+    /**
+     * Create a dedicated block for an oversize allocation (never pooled)
+     */
+    std::unique_ptr<Block> createOversizeBlock(size_t bytes);
+
+    /**
+     * Take back a batch of standard blocks from a finished arena
+     */
+    void releaseBlocks(std::vector<std::unique_ptr<Block>>& blocks);
+
+    Config config_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Block>> free_blocks_;
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> blocks_created_{0};
+    mutable std::atomic<uint64_t> blocks_recycled_{0};
+    mutable std::atomic<uint64_t> blocks_dropped_{0};
+    mutable std::atomic<uint64_t> arenas_created_{0};
+    mutable std::atomic<uint64_t> bytes_allocated_{0};
+    mutable std::atomic<uint64_t> allocations_{0};
+    mutable std::atomic<uint64_t> oversize_allocations_{0};
+};
+
+/**
+ * Request-Scoped Bump Arena
+ *
+ * Per-request allocation scope for native-side scratch: chunk vectors,
+ * token merge buffers, per-op tracking records. Allocation is a bump
+ * (one atomic add on the current block); nothing is freed individually —
+ * the whole arena is returned to the pool at request completion, which
+ * removes malloc/free lock waits from the hot paths under concurrent
+ * OpenMP and ThreadPool load.
+ *
+ * Thread Safety:
+ * - allocate() is safe from multiple threads (atomic bump, locked
+ *   block switch), so OpenMP workers can share one request's arena
+ * - reset() and destruction must not race live allocate() calls
+ *
+ * Example:
+ *     RequestArena arena(&pool);
+ *     std::vector<uint32_t, ArenaAllocator<uint32_t>> merged(
+ *         ArenaAllocator<uint32_t>(&arena));
+ *     merged.reserve(total_tokens);
+ */
+class RequestArena {
+public:
+    /**
+     * Create an arena drawing blocks from a pool
+     *
+     * @param pool Backing block pool (not owned, must outlive the arena)
+     */
+    explicit RequestArena(ArenaPool* pool);
+
+    /**
+     * Destructor - returns all standard blocks to the pool
+     */
+    ~RequestArena();
+
+    // Non-copyable, non-movable (blocks reference the arena)
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+    RequestArena(RequestArena&&) = delete;
+    RequestArena& operator=(RequestArena&&) = delete;
+
+    /**
+     * Allocate raw bytes from the arena
+     *
+     * Alignment is alignof(std::max_align_t); every allocation is
+     * rounded up to that, so any object type fits the returned pointer.
+     *
+     * @param bytes Size to allocate (0 returns a valid unique pointer)
+     * @return Pointer valid until reset() or destruction
+     */
+    void* allocate(size_t bytes);
+
+    /**
+     * Allocate an uninitialized array of n objects
+     *
+     * @param n Element count
+     * @return Typed pointer valid until reset() or destruction
+     */
+    template <typename T>
+    T* allocate(size_t n) {
+        return static_cast<T*>(allocate(n * sizeof(T)));
+    }
+
+    /**
+     * Free everything at once and keep one block for reuse
+     *
+     * Pointers from prior allocate() calls become invalid. Must not
+     * race live allocate() calls.
+     */
+    void reset();
+
+    /**
+     * Bytes handed out since construction or the last reset
+     */
+    size_t bytesAllocated() const {
+        return bytes_allocated_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Blocks currently held (standard + oversize)
+     */
+    size_t blocksUsed() const;
+
+private:
+    /**
+     * Slow path: current block exhausted — install a fresh one
+     */
+    void* allocateSlow(size_t bytes);
+
+    ArenaPool* pool_;  // Not owned
+
+    // Current bump target, readable without the mutex
+    std::atomic<ArenaPool::Block*> current_{nullptr};
+
+    // Owns all blocks; guards block switches and oversize allocations
+    mutable std::mutex blocks_mutex_;
+    std::vector<std::unique_ptr<ArenaPool::Block>> blocks_;
+    std::vector<std::unique_ptr<ArenaPool::Block>> oversize_blocks_;
+
+    std::atomic<size_t> bytes_allocated_{0};
+};
+
+/**
+ * STL-compatible allocator over a RequestArena
+ *
+ * Lets standard containers place their storage in the request's arena:
+ * deallocate() is a no-op, destruction happens en masse with the arena.
+ * The arena must outlive every container using it.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(RequestArena* arena) : arena_(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+    T* allocate(size_t n) {
+        return arena_->allocate<T>(n);
+    }
+
+    void deallocate(T*, size_t) {
+        // Arena memory is freed en masse at request completion
+    }
+
+    RequestArena* arena() const { return arena_; }
+
+private:
+    RequestArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return !(a == b);
+}
+
+} // namespace krserve
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace krserve {
+
+/**
+ * Vectorized Sampling Kernels
+ *
+ * Native token sampling over a logits buffer: temperature softmax,
+ * top-k truncation and top-p (nucleus) truncation, returning the sampled
+ * token id without a round trip through Python. The logits pointer is
+ * typically the CPU-visible staging data delivered by
+ * BlitQueue::downloadAsync / downloadStreaming.
+ *
+ * On Apple platforms the softmax runs through Accelerate (vDSP scale /
+ * max / sum, vvexpf); elsewhere a scalar fallback keeps the class
+ * portable. Top-k uses a partial select (nth_element) rather than a full
+ * vocab sort, so the sort cost scales with k, not vocab size.
+ *
+ * Thread Safety:
+ * - All public methods are thread-safe (scratch buffers are guarded);
+ *   use one Sampler per decode stream to avoid lock contention
+ *
+ * Example:
+ *     Sampler::Config config;
+ *     config.vocab_size = 128000;
+ *     config.temperature = 0.7f;
+ *     config.top_k = 50;
+ *     config.top_p = 0.95f;
+ *     Sampler sampler(config);
+ *
+ *     auto download = blit_queue.downloadStreaming(logits_buf, 0, bytes);
+ *     blit_queue.waitForDownload(download.op_id);
+ *     uint32_t token = sampler.sample(
+ *         static_cast<const float*>(download.data));
+ */
+class Sampler {
+public:
+    /**
+     * Configuration for Sampler
+     */
+    struct Config {
+        // Logits length per sample (required)
+        uint32_t vocab_size = 0;
+
+        // Softmax temperature; <= 0 means greedy argmax
+        float temperature = 1.0f;
+
+        // Keep only the k most likely tokens (0 = disabled)
+        uint32_t top_k = 0;
+
+        // Keep the smallest set of tokens with cumulative probability
+        // >= top_p (1.0 = disabled)
+        float top_p = 1.0f;
+
+        // RNG seed (0 = seed from std::random_device)
+        uint64_t seed = 0;
+
+        // Enable statistics collection
+        bool enable_stats = true;
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t tokens_sampled;       // sample/sampleBatch tokens produced
+        uint64_t greedy_samples;       // Tokens taken via argmax
+        uint64_t topk_truncations;     // Samples where top-k trimmed the set
+        uint64_t topp_truncations;     // Samples where top-p trimmed further
+        uint64_t total_sample_time_us; // Total time in sampling
+        uint64_t drafts_verified;      // verifyDraft calls
+        uint64_t draft_tokens_accepted; // Draft tokens kept across all calls
+        uint64_t draft_tokens_rejected; // Draft tokens rejected (1 max per call)
+
+        // Fraction of proposed draft tokens accepted
+        double getAcceptanceRate() const {
+            uint64_t total = draft_tokens_accepted + draft_tokens_rejected;
+            if (total == 0) return 0.0;
+            return static_cast<double>(draft_tokens_accepted) / total;
+        }
+
+        // Average microseconds per sampled token
+        double getAvgSampleTimeUs() const {
+            if (tokens_sampled == 0) return 0.0;
+            return static_cast<double>(total_sample_time_us) / tokens_sampled;
+        }
+    };
+
+    /**
+     * Create a sampler
+     *
+     * @param config Sampler configuration
+     * @throws std::invalid_argument if config is invalid
+     */
+    explicit Sampler(const Config& config);
+
+    /**
+     * Destructor
+     */
+    ~Sampler();
+
+    // Non-copyable, non-movable (RAII pattern)
+    Sampler(const Sampler&) = delete;
+    Sampler& operator=(const Sampler&) = delete;
+    Sampler(Sampler&&) = delete;
+    Sampler& operator=(Sampler&&) = delete;
+
+    /**
+     * Sample one token with the configured parameters
+     *
+     * @param logits vocab_size float32 logits (CPU-visible)
+     * @return Sampled token id
+     */
+    uint32_t sample(const float* logits);
+
+    /**
+     * Sample one token with per-call parameters
+     *
+     * @param logits vocab_size float32 logits (CPU-visible)
+     * @param temperature Softmax temperature (<= 0 = greedy)
+     * @param top_k Top-k cutoff (0 = disabled)
+     * @param top_p Nucleus cutoff (1.0 = disabled)
+     * @return Sampled token id
+     */
+    uint32_t sample(const float* logits, float temperature,
+                    uint32_t top_k, float top_p);
+
+    /**
+     * Result of one speculative verification pass
+     */
+    struct VerificationResult {
+        // Draft tokens accepted (prefix length, 0..draft_len)
+        uint32_t accepted_len;
+
+        // Token to append after the accepted prefix: the resample on
+        // rejection, or the bonus token from the extra target row when
+        // every draft token was accepted
+        uint32_t next_token;
+
+        // True when all draft tokens were accepted (next_token is the
+        // bonus token)
+        bool all_accepted;
+    };
+
+    /**
+     * Verify a speculative draft against target-model logits
+     *
+     * One call replaces the per-token Python accept/reject loop: for
+     * each draft position the target row is softmaxed (Accelerate on
+     * Apple) and the draft token accepted with probability
+     * min(1, p_target / p_draft); the first rejection resamples from the
+     * normalized residual max(0, p_target - p_draft), which keeps the
+     * output distribution exactly that of the target model. When every
+     * draft token survives, the bonus token is sampled from the extra
+     * target row with the configured temperature/top-k/top-p.
+     *
+     * With draft_probs null (or temperature <= 0) verification is
+     * greedy: draft tokens are accepted while they match the target
+     * argmax, and the first mismatch takes the argmax instead.
+     *
+     * @param target_logits [draft_len + 1, vocab_size] float32 target
+     *        rows (CPU-visible, e.g. BlitQueue download staging data)
+     * @param draft_tokens draft_len proposed token ids
+     * @param draft_len Number of proposed tokens (> 0)
+     * @param draft_probs Optional [draft_len, vocab_size] draft-model
+     *        probabilities (softmaxed); null selects greedy verification
+     * @return Accepted prefix length plus the next token to append
+     */
+    VerificationResult verifyDraft(const float* target_logits,
+                                   const uint32_t* draft_tokens,
+                                   size_t draft_len,
+                                   const float* draft_probs = nullptr);
+
+    /**
+     * Sample one token per row of a [num_rows, vocab_size] logits matrix
+     * (batched decode step, one row per stream)
+     *
+     * @param logits Row-major float32 logits
+     * @param num_rows Batch rows
+     * @return One token id per row
+     */
+    std::vector<uint32_t> sampleBatch(const float* logits, size_t num_rows);
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * Check if Apple Accelerate is available
+     */
+    static bool isAccelerateAvailable();
+
+private:
+    /**
+     * Validate configuration
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    /**
+     * Greedy argmax over the logits (temperature <= 0 path)
+     */
+    uint32_t argmax(const float* logits) const;
+
+    /**
+     * Temperature softmax into probs_ (vDSP on Apple, scalar elsewhere)
+     */
+    void softmaxWithTemperature(const float* logits, float temperature);
+
+    /**
+     * Sample with locks already held; shared by sample/sampleBatch
+     */
+    uint32_t sampleLocked(const float* logits, float temperature,
+                          uint32_t top_k, float top_p);
+
+    /**
+     * Draw from the normalized residual max(0, probs_ - draft_row)
+     * (rejection resample; probs_ holds the target distribution and
+     * target_row is kept only for the zero-residual fallback)
+     */
+    uint32_t residualResample(const float* target_row, const float* draft_row);
+
+    Config config_;
+
+    // Scratch reused across calls (sized to vocab_size)
+    std::mutex scratch_mutex_;
+    std::vector<float> probs_;
+    std::vector<uint32_t> indices_;
+
+    std::mt19937_64 rng_;
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> tokens_sampled_{0};
+    mutable std::atomic<uint64_t> greedy_samples_{0};
+    mutable std::atomic<uint64_t> topk_truncations_{0};
+    mutable std::atomic<uint64_t> topp_truncations_{0};
+    mutable std::atomic<uint64_t> total_sample_time_us_{0};
+    mutable std::atomic<uint64_t> drafts_verified_{0};
+    mutable std::atomic<uint64_t> draft_tokens_accepted_{0};
+    mutable std::atomic<uint64_t> draft_tokens_rejected_{0};
+};
+
+} // namespace krserve
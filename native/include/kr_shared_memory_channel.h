@@ -0,0 +1,330 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <atomic>
+
+namespace krserve {
+
+/**
+ * Descriptor for one message in a shared-memory channel
+ *
+ * Messages never travel as bytes: the producer writes payload into the
+ * shared segment and publishes this 40-byte descriptor through the ring.
+ * The consumer maps offset/length back onto its own mapping of the same
+ * segment and reads in place.
+ */
+struct ShmDescriptor {
+    // Absolute payload-space offset (monotonic; map with offset % capacity)
+    uint64_t offset = 0;
+
+    // Payload length in bytes
+    uint64_t length = 0;
+
+    // Application tag (message type; opaque to the channel)
+    uint32_t tag = 0;
+
+    // Application flags (opaque to the channel)
+    uint32_t flags = 0;
+
+    // Monotonic sequence number assigned on send
+    uint64_t sequence = 0;
+
+    // Internal: payload watermark retired when this message is released
+    uint64_t retire_mark = 0;
+};
+
+/**
+ * Configuration for a shared-memory channel endpoint
+ */
+struct SharedMemoryChannelConfig {
+    // POSIX shm name (must start with '/'; shared by both endpoints)
+    std::string name = "/krserve_channel";
+
+    // Payload region capacity in MB
+    size_t payload_mb = 64;
+
+    // Descriptor ring slots (power of two)
+    uint32_t ring_slots = 1024;
+
+    // Create the segment (producer/owner) vs attach to an existing one
+    bool create = true;
+
+    // Unlink the shm name on destruction (owner side)
+    bool unlink_on_close = true;
+
+    // Enable statistics collection
+    bool enable_stats = true;
+};
+
+/**
+ * Statistics for shared-memory channel performance
+ */
+struct SharedMemoryChannelStatistics {
+    // Messages published into the ring
+    uint64_t messages_sent = 0;
+
+    // Messages popped from the ring
+    uint64_t messages_received = 0;
+
+    // Payload bytes published (reserve/commit and copy sends)
+    uint64_t bytes_sent = 0;
+
+    // Payload bytes consumed
+    uint64_t bytes_received = 0;
+
+    // Sends that found the descriptor ring full
+    uint64_t ring_full = 0;
+
+    // Reservations that found the payload region full
+    uint64_t payload_full = 0;
+
+    // Sends that went through reserve()/commit() (no memcpy by the channel)
+    uint64_t zero_copy_sends = 0;
+
+    // Get average message size in bytes
+    double getAvgMessageBytes() const {
+        if (messages_sent == 0) return 0.0;
+        return static_cast<double>(bytes_sent) / messages_sent;
+    }
+};
+
+/**
+ * Lock-free SPSC shared-memory channel for cross-process tensor handoff
+ *
+ * One model replica per process means prompts and logits used to cross
+ * process boundaries through sockets, serialized and copied twice. This
+ * channel moves them as offset+length descriptors instead: a named POSIX
+ * shared-memory segment holds a payload region plus a single-producer /
+ * single-consumer descriptor ring, both operated with lock-free atomics
+ * that are address-free and therefore valid across process mappings.
+ *
+ * The payload region is a byte ring managed in absolute (monotonic)
+ * offsets. The producer reserves space, writes in place — e.g. points a
+ * BlitQueue download straight at it — and commits a descriptor; the
+ * consumer receives the descriptor, reads in place, and releases it,
+ * retiring payload space in FIFO order. No bytes are copied by the
+ * channel on that path; trySend() is a convenience that adds the one
+ * memcpy into shared memory for small messages.
+ *
+ * Direction: one channel is one direction. Use a pair of channels
+ * (e.g. "/krserve_req" and "/krserve_resp") for duplex traffic.
+ *
+ * Thread-Safety:
+ * - Exactly one producer thread and one consumer thread (in any two
+ *   processes); the lock-free protocol relies on it
+ * - getStatistics() is safe from any thread
+ *
+ * Example (producer process):
+ *     SharedMemoryChannelConfig config;
+ *     config.name = "/krserve_logits";
+ *     config.create = true;
+ *     SharedMemoryChannel channel(config);
+ *
+ *     uint64_t offset = channel.reserve(logits_bytes);
+ *     // ... write logits at channel.payloadAt(offset) ...
+ *     channel.commit(offset, logits_bytes, TAG_LOGITS);
+ *
+ * Example (consumer process):
+ *     config.create = false;
+ *     SharedMemoryChannel channel(config);
+ *
+ *     ShmDescriptor desc;
+ *     if (channel.tryReceive(desc)) {
+ *         processLogits(channel.payloadAt(desc.offset), desc.length);
+ *         channel.release(desc);
+ *     }
+ */
+class SharedMemoryChannel {
+public:
+    // Sentinel returned by reserve() when the payload region is full
+    static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+    /**
+     * Create or attach a channel endpoint
+     * @param config Configuration (name and sizes must match the creator's)
+     * @throws std::invalid_argument if config validation fails
+     * @throws std::runtime_error if the segment cannot be created/attached
+     */
+    explicit SharedMemoryChannel(const SharedMemoryChannelConfig& config);
+    SharedMemoryChannel() : SharedMemoryChannel(SharedMemoryChannelConfig{}) {}
+
+    ~SharedMemoryChannel();
+
+    // Disable copy (owns a mapping)
+    SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+    SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+    /**
+     * Reserve contiguous payload space for in-place writing
+     *
+     * Producer side. The returned absolute offset stays reserved until
+     * committed and later released by the consumer. Space that would
+     * straddle the ring end is skipped so the reservation is always
+     * contiguous in the mapping.
+     *
+     * @param size Bytes to reserve
+     * @return Absolute offset, or INVALID_OFFSET if the region is full
+     *         (consumer hasn't released enough yet) or size exceeds
+     *         the payload capacity
+     */
+    uint64_t reserve(uint64_t size);
+
+    /**
+     * Publish a previously reserved region as one message
+     *
+     * Producer side. The descriptor becomes visible to the consumer
+     * with release semantics, so all payload writes before this call
+     * are visible when tryReceive() returns it.
+     *
+     * @param offset Offset returned by reserve()
+     * @param length Bytes actually written (<= reserved size)
+     * @param tag Application message tag
+     * @param flags Application flags
+     * @return false if the descriptor ring is full (retry later)
+     */
+    bool commit(uint64_t offset, uint64_t length, uint32_t tag, uint32_t flags = 0);
+
+    /**
+     * Copy a small message into the channel and publish it
+     *
+     * Convenience producer path: reserve + memcpy + commit. The copy
+     * lands directly in shared memory, so this is still one copy fewer
+     * than any socket transport.
+     *
+     * @param data Message bytes
+     * @param size Message length
+     * @param tag Application message tag
+     * @param flags Application flags
+     * @return false if the ring or payload region is full
+     */
+    bool trySend(const void* data, uint64_t size, uint32_t tag, uint32_t flags = 0);
+
+    /**
+     * Pop the next message descriptor if one is pending
+     *
+     * Consumer side, non-blocking. The payload at
+     * payloadAt(descriptor.offset) stays valid until release().
+     *
+     * @param out Filled with the next descriptor on success
+     * @return true if a message was popped
+     */
+    bool tryReceive(ShmDescriptor& out);
+
+    /**
+     * Retire a received message's payload space
+     *
+     * Consumer side. Must be called in receive order (SPSC FIFO); the
+     * producer may reuse the space afterwards.
+     *
+     * @param descriptor Descriptor from tryReceive()
+     */
+    void release(const ShmDescriptor& descriptor);
+
+    /**
+     * Map an absolute payload offset to this process's mapping
+     * @param offset Offset from reserve() or a received descriptor
+     * @return Pointer into the shared payload region
+     */
+    uint8_t* payloadAt(uint64_t offset) const;
+
+    /**
+     * Get payload region capacity in bytes
+     */
+    size_t payloadCapacity() const;
+
+    /**
+     * Get number of descriptors currently in the ring
+     */
+    size_t pendingCount() const;
+
+    /**
+     * Check whether this endpoint created (owns) the segment
+     */
+    bool isOwner() const { return owner_; }
+
+    /**
+     * Remove a channel's shm name without attaching to it
+     *
+     * Cleanup helper for crashed peers; safe if the name doesn't exist.
+     *
+     * @param name POSIX shm name (with leading '/')
+     */
+    static void unlinkSegment(const std::string& name);
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics (local endpoint's view)
+     */
+    SharedMemoryChannelStatistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const SharedMemoryChannelConfig& getConfig() const { return config_; }
+
+private:
+    // Shared segment layout: ChannelHeader, descriptor ring, payload
+    struct ChannelHeader;
+
+    // Configuration
+    SharedMemoryChannelConfig config_;
+
+    // Mapping state
+    bool owner_ = false;
+    int shm_fd_ = -1;
+    uint8_t* map_base_ = nullptr;
+    size_t map_size_ = 0;
+
+    // Views into the mapping
+    ChannelHeader* header_ = nullptr;
+    ShmDescriptor* ring_ = nullptr;
+    uint8_t* payload_ = nullptr;
+    uint64_t payload_bytes_ = 0;
+
+    // Statistics (local to this endpoint)
+    mutable std::atomic<uint64_t> messages_sent_{0};
+    mutable std::atomic<uint64_t> messages_received_{0};
+    mutable std::atomic<uint64_t> bytes_sent_{0};
+    mutable std::atomic<uint64_t> bytes_received_{0};
+    mutable std::atomic<uint64_t> ring_full_{0};
+    mutable std::atomic<uint64_t> payload_full_{0};
+    mutable std::atomic<uint64_t> zero_copy_sends_{0};
+
+    /**
+     * Publish a descriptor (shared by commit() and trySend())
+     * @param zero_copy Whether the payload was written in place
+     */
+    bool publish(uint64_t offset, uint64_t length, uint32_t tag,
+                 uint32_t flags, bool zero_copy);
+
+    /**
+     * Validate configuration parameters
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    /**
+     * Create the segment, size it, and initialize the header
+     */
+    void createSegment();
+
+    /**
+     * Attach to an existing segment and validate its header
+     */
+    void attachSegment();
+
+    /**
+     * Unmap and close the segment (unlinks if owner and configured)
+     */
+    void closeSegment();
+};
+
+} // namespace krserve
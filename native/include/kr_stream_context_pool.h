@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "kr_request_arena.h"
+#include "kr_parallel_tokenizer.h"
+
+namespace krserve {
+
+class StreamContextPool;
+
+/**
+ * Per-stream generation state bundle
+ *
+ * Everything a live output stream needs between admission and stream
+ * end, pre-sized so the decode loop never allocates: the streaming
+ * detokenizer (tail buffer), a vocab-sized sampling scratch array, a
+ * request arena for transient buffers, and per-stream counters.
+ * Contexts are created by StreamContextPool and cycle through its
+ * freelist; hold them only between acquireContext()/releaseContext().
+ */
+class StreamContext {
+public:
+    /**
+     * Get the id assigned at the most recent acquire
+     */
+    uint64_t streamId() const { return stream_id_; }
+
+    /**
+     * Get the stream's pooled detokenizer
+     *
+     * Null when the pool has no tokenizer attached (or no native
+     * vocabulary is loaded); feed()/flush() otherwise.
+     */
+    const std::shared_ptr<StreamingDecoder>& decoder() const { return decoder_; }
+
+    /**
+     * Get the vocab-sized sampling scratch array
+     *
+     * Stable storage for logits post-processing (softmax, masks) —
+     * hand it to Sampler paths instead of allocating per step.
+     */
+    float* samplingScratch() { return sampling_scratch_.data(); }
+
+    /**
+     * Get sampling scratch length in floats (the pool's vocab_size)
+     */
+    size_t samplingScratchSize() const { return sampling_scratch_.size(); }
+
+    /**
+     * Get the stream's request arena for transient allocations
+     */
+    RequestArena& arena() { return arena_; }
+
+    /**
+     * Tokens generated on this stream since acquire
+     */
+    uint64_t tokensGenerated() const { return tokens_generated_; }
+
+    /**
+     * Count generated tokens (per-stream stat, folded into nothing —
+     * read it before releaseContext())
+     */
+    void recordTokens(uint64_t count) { tokens_generated_ += count; }
+
+private:
+    friend class StreamContextPool;
+
+    StreamContext(ArenaPool* arena_pool, size_t vocab_size)
+        : sampling_scratch_(vocab_size), arena_(arena_pool) {}
+
+    /**
+     * O(1) wipe between streams: recycle arena blocks, zero counters.
+     * The scratch array is reused as-is (callers overwrite it) and the
+     * decoder is swapped by the pool, not reset here.
+     */
+    void resetForReuse() {
+        arena_.reset();
+        tokens_generated_ = 0;
+        stream_id_ = 0;
+    }
+
+    uint64_t stream_id_ = 0;
+    std::shared_ptr<StreamingDecoder> decoder_;
+    std::vector<float> sampling_scratch_;
+    RequestArena arena_;
+    uint64_t tokens_generated_ = 0;
+};
+
+/**
+ * Freelist of Per-Stream Generation Contexts
+ *
+ * Native replacement for recycling per-request state through
+ * python/object_pool.py: the expensive pieces (detokenizer tail
+ * buffers, vocab-sized sampling scratch, arena blocks) are bundled
+ * into StreamContext objects that cycle through a freelist. Acquire at
+ * admission, release at stream end — both O(1), so context
+ * setup/teardown stays constant-time at hundreds of concurrent short
+ * streams instead of showing up in TTFT.
+ *
+ * The pool owns a backing ArenaPool (blocks recycle across contexts)
+ * and optionally borrows a ParallelTokenizer: when one is attached,
+ * each acquired context carries a pooled StreamingDecoder, and release
+ * returns the decoder through the tokenizer's own pool so stream-token
+ * stats and vocabulary-swap checks keep working.
+ *
+ * Thread Safety:
+ * - acquireContext()/releaseContext() are thread-safe (short locked
+ *   freelist push/pop)
+ * - A StreamContext itself belongs to one stream at a time
+ *
+ * Example:
+ *     StreamContextPool::Config config;
+ *     config.vocab_size = 32768;
+ *     config.initial_contexts = 64;
+ *     StreamContextPool pool(config, &tokenizer);
+ *
+ *     auto ctx = pool.acquireContext();        // admission
+ *     // ... decode loop: ctx->decoder()->feed(token),
+ *     //     sample into ctx->samplingScratch(),
+ *     //     scratch vectors from ctx->arena() ...
+ *     pool.releaseContext(std::move(ctx));     // stream end
+ */
+class StreamContextPool {
+public:
+    /**
+     * Configuration for Stream Context Pool
+     */
+    struct Config {
+        // Sampling scratch length per context (model vocab size)
+        size_t vocab_size = 32768;
+
+        // Contexts created eagerly at construction (warm start)
+        size_t initial_contexts = 0;
+
+        // Contexts kept for reuse; beyond this, released contexts are
+        // dropped (their arena blocks still recycle via the arena pool)
+        size_t max_pooled_contexts = 512;
+
+        // Backing arena pool configuration
+        ArenaPool::Config arena;
+
+        // Enable statistics collection
+        bool enable_stats = true;
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t contexts_created;  // Contexts constructed (freelist misses + warm)
+        uint64_t acquires;          // acquireContext() calls
+        uint64_t releases;          // releaseContext() calls
+        uint64_t freelist_hits;     // Acquires served from the freelist
+        uint64_t contexts_dropped;  // Released contexts freed (freelist full)
+        size_t contexts_pooled;     // Contexts currently idle in the freelist
+        size_t contexts_active;     // Contexts currently held by streams
+
+        // Fraction of acquires served without construction
+        double getHitRate() const {
+            if (acquires == 0) return 0.0;
+            return static_cast<double>(freelist_hits) / acquires;
+        }
+    };
+
+    /**
+     * Create a stream context pool
+     *
+     * @param config Pool configuration
+     * @param tokenizer Tokenizer whose streaming decoders the contexts
+     *        carry (not owned, may be null; must outlive the pool)
+     * @throws std::invalid_argument if config is invalid
+     */
+    explicit StreamContextPool(const Config& config,
+                               ParallelTokenizer* tokenizer = nullptr);
+
+    /**
+     * Create a stream context pool with default configuration
+     */
+    StreamContextPool() : StreamContextPool(Config{}) {}
+
+    /**
+     * Destructor - frees pooled contexts
+     */
+    ~StreamContextPool();
+
+    // Non-copyable, non-movable (contexts reference the arena pool)
+    StreamContextPool(const StreamContextPool&) = delete;
+    StreamContextPool& operator=(const StreamContextPool&) = delete;
+    StreamContextPool(StreamContextPool&&) = delete;
+    StreamContextPool& operator=(StreamContextPool&&) = delete;
+
+    /**
+     * Acquire a context for a newly admitted stream
+     *
+     * Serves from the freelist when possible; otherwise constructs one
+     * (scratch array sized to vocab_size). When a tokenizer with a
+     * native vocabulary is attached, the context carries a pooled
+     * StreamingDecoder, handed out reset.
+     *
+     * @return Context bound to a fresh stream id
+     */
+    std::shared_ptr<StreamContext> acquireContext();
+
+    /**
+     * Return a context at stream end
+     *
+     * Resets the context in O(1) (arena blocks recycle, counters zero),
+     * returns its decoder to the tokenizer's pool, and parks it in the
+     * freelist — or drops it if the freelist is at max_pooled_contexts.
+     *
+     * @param context Context from acquireContext()
+     */
+    void releaseContext(std::shared_ptr<StreamContext> context);
+
+    /**
+     * Get number of contexts currently idle in the freelist
+     */
+    size_t pooledCount() const;
+
+    /**
+     * Get the backing arena pool (shared by all contexts)
+     */
+    ArenaPool& arenaPool() { return arena_pool_; }
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset statistics counters
+     */
+    void resetStatistics();
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+private:
+    /**
+     * Validate configuration
+     * @throws std::invalid_argument if invalid
+     */
+    void validateConfig() const;
+
+    Config config_;
+    ParallelTokenizer* tokenizer_;  // Not owned, may be null
+
+    // Backing block pool shared by every context's arena
+    ArenaPool arena_pool_;
+
+    // Idle contexts awaiting reuse
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<StreamContext>> free_contexts_;
+
+    // Stream id assignment (never reused)
+    std::atomic<uint64_t> next_stream_id_{1};
+
+    // Statistics (atomics for thread-safe updates)
+    mutable std::atomic<uint64_t> contexts_created_{0};
+    mutable std::atomic<uint64_t> acquires_{0};
+    mutable std::atomic<uint64_t> releases_{0};
+    mutable std::atomic<uint64_t> freelist_hits_{0};
+    mutable std::atomic<uint64_t> contexts_dropped_{0};
+    mutable std::atomic<uint64_t> contexts_active_{0};
+};
+
+} // namespace krserve
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace krserve {
+
+/**
+ * Lock-Free Trace Ring with Chrome-Trace Export
+ *
+ * Process-wide instrumentation surface shared by the native components.
+ * Each component's counter structs (BlitQueue::Metrics,
+ * CommandBufferRing::Statistics, ...) tell us averages; this shows the
+ * timeline — why one request in a thousand takes 300 ms.
+ *
+ * Design:
+ * - One SPSC ring per emitting thread, created lazily on first emit and
+ *   registered with the singleton. The emit path is a relaxed load, an
+ *   array store and a release increment — no locks, no allocation
+ * - A background drain thread (optional) moves events out of the rings
+ *   into a bounded buffer so long traces don't overflow the rings;
+ *   export drains whatever remains on demand
+ * - exportChromeTrace() serializes everything as Chrome trace-event JSON
+ *   (load in chrome://tracing or Perfetto)
+ *
+ * Event names and categories must be string literals (or otherwise
+ * outlive the trace) — only the pointers are stored on the hot path.
+ *
+ * Thread Safety:
+ * - emit paths are lock-free and safe from any thread
+ * - export/clear/start/stop take the registry lock (cold paths)
+ *
+ * Example:
+ *     auto& trace = TraceRing::instance();
+ *     trace.setEnabled(true);
+ *     trace.startDraining();
+ *
+ *     {
+ *         TraceSpan span("blit_upload", "blit", op_id);
+ *         // ... work ...
+ *     }
+ *
+ *     std::string json = trace.exportChromeTrace();
+ */
+class TraceRing {
+public:
+    /**
+     * Configuration for Trace Ring
+     */
+    struct Config {
+        // Events per thread ring (rounded up to a power of two)
+        uint32_t events_per_thread = 8192;
+
+        // Background drain period
+        uint32_t drain_interval_ms = 10;
+
+        // Cap on drained events held for export (oldest dropped beyond this)
+        size_t max_buffered_events = 1 << 20;
+    };
+
+    /**
+     * Span phase (subset of Chrome trace-event phases)
+     */
+    enum class Phase : uint8_t {
+        Begin = 0,      // "B" (same-thread span)
+        End = 1,        // "E"
+        Instant = 2,    // "i"
+        AsyncBegin = 3, // "b" (cross-thread span, matched by cat+id+name)
+        AsyncEnd = 4,   // "e"
+    };
+
+    /**
+     * Runtime statistics for monitoring
+     */
+    struct Statistics {
+        uint64_t events_emitted;   // Events written into rings
+        uint64_t events_dropped;   // Events lost to full rings
+        uint64_t events_buffered;  // Events drained and held for export
+        uint32_t threads_registered; // Rings created
+        bool enabled;              // Emit paths active
+        bool draining;             // Background drain thread running
+    };
+
+    /**
+     * Get the process-wide instance
+     */
+    static TraceRing& instance();
+
+    // Non-copyable, non-movable (process singleton)
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+    TraceRing(TraceRing&&) = delete;
+    TraceRing& operator=(TraceRing&&) = delete;
+
+    /**
+     * Reconfigure ring sizes and drain behavior
+     *
+     * Applies to rings created after the call; existing per-thread rings
+     * keep their capacity.
+     *
+     * @param config New configuration
+     * @throws std::invalid_argument if config is invalid
+     */
+    void configure(const Config& config);
+
+    /**
+     * Enable or disable event emission (disabled emit is a single
+     * relaxed load, so instrumentation can stay compiled in)
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Check if emission is enabled
+     */
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Emit a span begin event
+     *
+     * @param name Span name (string literal)
+     * @param category Component category, e.g. "blit", "ring" (literal)
+     * @param request_id Request/op id correlating spans across components
+     */
+    void beginSpan(const char* name, const char* category, uint64_t request_id);
+
+    /**
+     * Emit a span end event (pairs with beginSpan on the same thread)
+     */
+    void endSpan(const char* name, const char* category, uint64_t request_id);
+
+    /**
+     * Emit an instant event (no duration)
+     */
+    void instant(const char* name, const char* category, uint64_t request_id);
+
+    /**
+     * Emit an async span begin (may end on a different thread, e.g. a
+     * Metal completion handler; matched by category + request_id + name)
+     */
+    void beginAsync(const char* name, const char* category, uint64_t request_id);
+
+    /**
+     * Emit an async span end (pairs with beginAsync)
+     */
+    void endAsync(const char* name, const char* category, uint64_t request_id);
+
+    /**
+     * Start the background drain thread
+     *
+     * Moves events from the per-thread rings into the export buffer every
+     * drain_interval_ms so rings don't overflow during long captures.
+     */
+    void startDraining();
+
+    /**
+     * Stop the background drain thread (remaining ring contents are
+     * still picked up by exportChromeTrace)
+     */
+    void stopDraining();
+
+    /**
+     * Export all captured events as Chrome trace-event JSON
+     *
+     * Drains the rings first. The result loads in chrome://tracing or
+     * Perfetto; request ids appear in each event's args.
+     *
+     * @return JSON document ({"traceEvents": [...]})
+     */
+    std::string exportChromeTrace();
+
+    /**
+     * Drop all buffered and ring-resident events
+     */
+    void clear();
+
+    /**
+     * Get current statistics
+     * @return Copy of current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Get configuration
+     * @return Current configuration
+     */
+    Config getConfig() const;
+
+    /**
+     * Monotonic timestamp in nanoseconds (mach_absolute_time on Apple)
+     */
+    static uint64_t nowNanos();
+
+private:
+    TraceRing();
+    ~TraceRing();
+
+    /**
+     * One fixed event slot
+     */
+    struct Event {
+        uint64_t timestamp_ns;
+        uint64_t request_id;
+        const char* name;
+        const char* category;
+        Phase phase;
+    };
+
+    /**
+     * Event plus its origin thread, as held in the export buffer
+     */
+    struct BufferedEvent {
+        Event event;
+        uint32_t thread_index;
+    };
+
+    /**
+     * Per-thread SPSC ring: the owning thread produces at head, the
+     * drainer consumes at tail
+     */
+    struct ThreadRing {
+        explicit ThreadRing(uint32_t capacity_pow2, uint32_t index);
+
+        std::unique_ptr<Event[]> events;
+        uint32_t capacity;      // Power of two
+        uint32_t thread_index;
+        std::atomic<uint64_t> head{0};  // Producer cursor
+        std::atomic<uint64_t> tail{0};  // Consumer cursor
+        std::atomic<uint64_t> emitted{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    /**
+     * Get (or lazily create and register) the calling thread's ring
+     */
+    ThreadRing* localRing();
+
+    /**
+     * Lock-free emit into the calling thread's ring
+     */
+    void emit(const char* name, const char* category,
+              uint64_t request_id, Phase phase);
+
+    /**
+     * Move all ring contents into the export buffer
+     */
+    void drainAll();
+
+    /**
+     * Background drain loop
+     */
+    void drainLoop();
+
+    std::atomic<bool> enabled_{false};
+
+    mutable std::mutex registry_mutex_;
+    Config config_;
+    std::vector<std::unique_ptr<ThreadRing>> rings_;
+
+    mutable std::mutex buffer_mutex_;
+    std::vector<BufferedEvent> buffered_;
+    uint64_t buffer_overflow_drops_ = 0;
+
+    std::thread drain_thread_;
+    std::atomic<bool> drain_running_{false};
+    std::mutex drain_mutex_;
+    std::condition_variable drain_cv_;
+};
+
+/**
+ * RAII span: begin on construction, end on destruction
+ *
+ * Example:
+ *     void BlitQueue::upload(...) {
+ *         TraceSpan span("blit_upload", "blit", op_id);
+ *         // ...
+ *     }
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* category, uint64_t request_id)
+        : name_(name), category_(category), request_id_(request_id) {
+        TraceRing::instance().beginSpan(name_, category_, request_id_);
+    }
+
+    ~TraceSpan() {
+        TraceRing::instance().endSpan(name_, category_, request_id_);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t request_id_;
+};
+
+} // namespace krserve
@@ -10,9 +10,36 @@
 #include <queue>
 #include <condition_variable>
 #include <functional>
+#include <unordered_map>
 
 namespace krserve {
 
+/**
+ * Zero-copy view of one tensor inside a mapped safetensors file
+ *
+ * Offsets are absolute into the mapped MTLBuffer, so a tensor can be bound
+ * directly via setBuffer:offset: without copying anything out.
+ */
+struct SafetensorsTensorView {
+    std::string dtype;          // Safetensors dtype string (e.g. "F16", "BF16")
+    std::vector<size_t> shape;  // Tensor shape
+    size_t offset = 0;          // Absolute byte offset into the mapped buffer
+    size_t length = 0;          // Byte length of tensor data
+};
+
+/**
+ * A safetensors file mapped as a single zero-copy MTLBuffer
+ *
+ * Holds the whole-file buffer plus per-tensor views. The buffer keeps the
+ * underlying mmap alive; tensors become invalid once the model is released.
+ */
+struct SafetensorsModel {
+    id<MTLBuffer> buffer = nil;  // Entire file, zero-copy mapped
+    size_t file_size = 0;        // Total mapped size in bytes
+    size_t data_offset = 0;      // Start of the tensor data section
+    std::unordered_map<std::string, SafetensorsTensorView> tensors;
+};
+
 /**
  * Configuration for Weight Manager
  */
@@ -44,6 +71,17 @@ struct WeightManagerConfig {
     // Max pinned memory allowed (in MB, 0 = unlimited)
     size_t max_pinned_mb = 0;
 
+    // Learn layer access order and prefetch predicted successors
+    // instead of blindly prefetching layer_index+1/+2 (MoE, spec-decode)
+    bool adaptive_prefetch = false;
+
+    // Number of predicted successor layers to prefetch per access
+    uint32_t prefetch_candidates = 2;
+
+    // Source bytes per streaming-dequantization chunk; bounds transient
+    // memory at dequant_chunk_kb x prefetch_threads
+    size_t dequant_chunk_kb = 512;
+
     // Enable statistics collection
     bool enable_stats = true;
 };
@@ -82,6 +120,27 @@ struct WeightManagerStatistics {
     // Active prefetch tasks
     uint32_t active_prefetch_tasks = 0;
 
+    // Layer accesses recorded into the transition table
+    uint64_t accesses_recorded = 0;
+
+    // Prefetches driven by the learned transition table
+    uint64_t predicted_prefetches = 0;
+
+    // Prefetches that fell back to sequential (no history yet)
+    uint64_t sequential_fallbacks = 0;
+
+    // Parallel warm-in passes completed
+    uint64_t parallel_loads = 0;
+
+    // Streaming dequantization passes completed
+    uint64_t dequant_ops = 0;
+
+    // Dequantization chunks fanned out across the thread pool
+    uint64_t dequant_chunks = 0;
+
+    // fp16 bytes produced by streaming dequantization
+    uint64_t dequant_bytes_out = 0;
+
     // Get page fault reduction ratio
     double getPageFaultReduction() const {
         if (page_faults_before == 0) return 0.0;
@@ -207,6 +266,34 @@ public:
      */
     void prefetchLayer(int layer_index, const std::vector<id<MTLBuffer>>& weights);
 
+    /**
+     * Record an observed layer access for the adaptive prefetcher
+     *
+     * Feeds the transition table: each call counts one (previous_layer ->
+     * layer_index) edge. Call this from the inference loop as each layer's
+     * weights are actually touched. MoE and speculative-decode models don't
+     * visit layers in strict order, so the learned table beats sequential
+     * next-layer prefetch for them.
+     *
+     * No-op unless config.adaptive_prefetch is enabled.
+     *
+     * @param layer_index Layer whose weights were just accessed
+     *
+     * Example:
+     *     // During inference loop
+     *     manager.recordLayerAccess(i);
+     *     manager.prefetchLayer(i, all_layers);  // uses predictions
+     */
+    void recordLayerAccess(int layer_index);
+
+    /**
+     * Clear the learned access-pattern transition table
+     *
+     * Use when switching models or routing configurations so stale
+     * transitions don't drive wasted prefetches.
+     */
+    void resetAccessPattern();
+
     /**
      * Warm up model by touching memory
      *
@@ -240,6 +327,92 @@ public:
      */
     id<MTLBuffer> loadWeightsMapped(const std::string& path, id<MTLDevice> device);
 
+    /**
+     * Load a safetensors file with zero-copy per-tensor views
+     *
+     * Maps the whole file into one MTLBuffer (same mmap path as
+     * loadWeightsMapped), parses the safetensors header natively, and
+     * returns name -> offset/length views into the mapped buffer. No
+     * tensor bytes are copied — a 14 GB model "loads" in header-parse
+     * time plus first-touch page faults, which warmupModel() amortizes.
+     *
+     * @param path File path to .safetensors file
+     * @param device Metal device for buffer creation
+     * @return Model with mapped buffer and tensor views
+     * @throws std::runtime_error if the file cannot be mapped or the
+     *         header is malformed
+     *
+     * Example:
+     *     auto model = manager.loadSafetensorsMapped(
+     *         "/path/to/model.safetensors", device);
+     *     const auto& view = model.tensors.at("model.embed_tokens.weight");
+     *     // Bind model.buffer at view.offset — zero-copy
+     */
+    SafetensorsModel loadSafetensorsMapped(const std::string& path, id<MTLDevice> device);
+
+    /**
+     * Warm a mapped safetensors model in parallel
+     *
+     * Splits the tensor data section into prefetch_threads contiguous
+     * shards and fans them out across the thread pool; each worker issues
+     * madvise(MADV_SEQUENTIAL) on its shard and touches every page, so
+     * the NVMe readahead streams run in parallel instead of one serial
+     * first-touch pass. While the workers fault pages in, the calling
+     * thread pins critical_layers via the existing pinLayers() path, so
+     * pinning overlaps the warm-in. Blocks until all shards are resident.
+     *
+     * @param model Model from loadSafetensorsMapped()
+     * @param critical_layers Layer buffers to pin while warming (optional;
+     *        first config.critical_layers are pinned)
+     *
+     * Example:
+     *     auto model = manager.loadSafetensorsMapped(path, device);
+     *     manager.warmSafetensorsParallel(model, layer_buffers);
+     *     // All weights resident, critical layers pinned
+     */
+    void warmSafetensorsParallel(const SafetensorsModel& model,
+                                 const std::vector<id<MTLBuffer>>& critical_layers = {});
+
+    /**
+     * Stream an int4-quantized tensor to fp16 in a destination buffer
+     *
+     * Dequantizes group-quantized 4-bit weights (two elements per byte,
+     * low nibble first; value = scale * q + bias, one fp16 scale/bias
+     * per group) directly into dest — no full-tensor intermediate copy.
+     * The element range is split into dequant_chunk_kb source chunks
+     * fanned out across the prefetch thread pool: each worker issues
+     * madvise(MADV_WILLNEED) on its source slice so page-in of the next
+     * range overlaps expansion of the current one, unpacks through a
+     * chunk-sized float scratch buffer, and narrows to fp16 with vImage.
+     * Transient memory is bounded by chunk size x worker count, and
+     * wall time drops roughly by the worker count. Blocks until the
+     * whole tensor has been expanded.
+     *
+     * @param packed Packed int4 source (e.g. a mapped tensor view)
+     * @param element_count Quantized element count (multiple of group_size)
+     * @param scales fp16 scales, one per group (element_count / group_size)
+     * @param biases fp16 biases, one per group
+     * @param group_size Quantization group size (e.g. 32 or 64; even)
+     * @param dest Destination buffer receiving fp16 output
+     * @param dest_offset Byte offset into dest
+     * @return Bytes written (element_count * 2)
+     * @throws std::invalid_argument on null inputs, bad sizes, or a
+     *         destination too small for the output
+     *
+     * Example:
+     *     const auto& view = model.tensors.at("layers.0.mlp.w1.weight");
+     *     manager.dequantizeInt4ToFp16(
+     *         base + view.offset, elements, scales, biases, 64, fp16_buf);
+     */
+    size_t dequantizeInt4ToFp16(
+        const void* packed,
+        size_t element_count,
+        const void* scales,
+        const void* biases,
+        size_t group_size,
+        id<MTLBuffer> dest,
+        size_t dest_offset = 0);
+
     /**
      * Get current statistics
      * @return Copy of current statistics
@@ -284,6 +457,18 @@ private:
     mutable std::atomic<uint64_t> prefetch_ops_{0};
     mutable std::atomic<uint64_t> pin_failures_{0};
     mutable std::atomic<uint32_t> active_prefetch_tasks_{0};
+    mutable std::atomic<uint64_t> accesses_recorded_{0};
+    mutable std::atomic<uint64_t> predicted_prefetches_{0};
+    mutable std::atomic<uint64_t> sequential_fallbacks_{0};
+    mutable std::atomic<uint64_t> parallel_loads_{0};
+    mutable std::atomic<uint64_t> dequant_ops_{0};
+    mutable std::atomic<uint64_t> dequant_chunks_{0};
+    mutable std::atomic<uint64_t> dequant_bytes_out_{0};
+
+    // Access-pattern predictor: transitions_[from][to] = observed count
+    std::unordered_map<int, std::unordered_map<int, uint64_t>> transitions_;
+    int last_accessed_layer_ = -1;
+    mutable std::mutex transitions_mutex_;
 
     // Pinned memory tracking
     struct PinnedMemory {
@@ -346,10 +531,23 @@ private:
 
     /**
      * Async prefetch buffer in background thread
+     *
+     * Issues madvise(MADV_WILLNEED) on the buffer's mapped range so the
+     * kernel starts paging in immediately, then touches pages to confirm
+     * residency.
+     *
      * @param buffer Metal buffer to prefetch
      */
     void prefetchAsync(id<MTLBuffer> buffer);
 
+    /**
+     * Predict most likely successor layers from the transition table
+     * @param layer_index Current layer
+     * @param max_candidates Maximum predictions to return
+     * @return Successor layers, most frequently observed first
+     */
+    std::vector<int> predictNextLayers(int layer_index, uint32_t max_candidates) const;
+
     /**
      * Check if we're within memory limits
      * @param additional_bytes Bytes to pin
@@ -2,19 +2,31 @@
 #import <Foundation/Foundation.h>
 #include "../include/kr_command_buffer_pool.h"
 #include <vector>
+#include <unordered_map>
 #include <mutex>
 #include <atomic>
 
 namespace krserve {
 
+namespace {
+
+// Pool identity for the thread-local cache map. Never reused, so a
+// stale entry left by a destroyed pool can't alias a new one.
+std::atomic<uint64_t> g_next_pool_id{1};
+
+} // anonymous namespace
+
 class CommandBufferPool::Impl {
 public:
-    explicit Impl(size_t pool_size)
+    explicit Impl(size_t pool_size, bool warm, size_t thread_cache_size)
         : max_pool_size_(pool_size)
+        , thread_cache_size_(thread_cache_size)
+        , pool_id_(g_next_pool_id.fetch_add(1, std::memory_order_relaxed))
         , total_acquired_(0)
         , total_released_(0)
         , cache_hits_(0)
         , cache_misses_(0)
+        , thread_cache_hits_(0)
     {
         // Get default Metal device
         device_ = MTLCreateSystemDefaultDevice();
@@ -30,11 +42,22 @@ public:
 
         // Pre-allocate pool storage
         pool_.reserve(pool_size);
+
+        // Warm option: take the ~0.5ms first-creation cost per buffer
+        // here, at construction, instead of on the serving path
+        if (warm) {
+            for (size_t i = 0; i < pool_size; ++i) {
+                id<MTLCommandBuffer> buffer = [queue_ commandBuffer];
+                if (!buffer) break;
+                pool_.push_back(buffer);
+            }
+        }
     }
 
     ~Impl() {
         std::lock_guard<std::mutex> lock(mutex_);
         pool_.clear();
+        thread_caches_.clear();
         queue_ = nil;
         device_ = nil;
     }
@@ -42,17 +65,33 @@ public:
     void* acquire() {
         total_acquired_.fetch_add(1, std::memory_order_relaxed);
 
-        std::lock_guard<std::mutex> lock(mutex_);
+        // Fast path: the calling thread's own free list. Its mutex is
+        // only ever contended by reset()/getStats(), not by other
+        // submitting threads.
+        ThreadCache* cache = localCache();
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            if (!cache->buffers.empty()) {
+                id<MTLCommandBuffer> buffer = cache->buffers.back();
+                cache->buffers.pop_back();
+                cache_hits_.fetch_add(1, std::memory_order_relaxed);
+                thread_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+                return (__bridge_retained void*)buffer;
+            }
+        }
 
-        // Try to reuse from pool
-        if (!pool_.empty()) {
-            id<MTLCommandBuffer> buffer = pool_.back();
-            pool_.pop_back();
-            cache_hits_.fetch_add(1, std::memory_order_relaxed);
-            return (__bridge_retained void*)buffer;
+        // Global overflow pool
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!pool_.empty()) {
+                id<MTLCommandBuffer> buffer = pool_.back();
+                pool_.pop_back();
+                cache_hits_.fetch_add(1, std::memory_order_relaxed);
+                return (__bridge_retained void*)buffer;
+            }
         }
 
-        // Pool empty - create new buffer
+        // Everything empty - create new buffer
         cache_misses_.fetch_add(1, std::memory_order_relaxed);
         id<MTLCommandBuffer> buffer = [queue_ commandBuffer];
         return (__bridge_retained void*)buffer;
@@ -67,9 +106,19 @@ public:
 
         id<MTLCommandBuffer> buffer = (__bridge_transfer id<MTLCommandBuffer>)buffer_ptr;
 
+        // Prefer the calling thread's free list while it has room
+        ThreadCache* cache = localCache();
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            if (cache->buffers.size() < thread_cache_size_) {
+                cache->buffers.push_back(buffer);
+                return;
+            }
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
 
-        // Return to pool if not full
+        // Return to global pool if not full
         if (pool_.size() < max_pool_size_) {
             pool_.push_back(buffer);
         }
@@ -79,25 +128,68 @@ public:
     void reset() {
         std::lock_guard<std::mutex> lock(mutex_);
         pool_.clear();
+        for (auto& cache : thread_caches_) {
+            std::lock_guard<std::mutex> cache_lock(cache->mutex);
+            cache->buffers.clear();
+        }
     }
 
     CommandBufferPool::Stats getStats() const {
         std::lock_guard<std::mutex> lock(mutex_);
+        size_t available = pool_.size();
+        for (const auto& cache : thread_caches_) {
+            std::lock_guard<std::mutex> cache_lock(cache->mutex);
+            available += cache->buffers.size();
+        }
         return {
             .pool_size = max_pool_size_,
-            .available_buffers = pool_.size(),
+            .available_buffers = available,
             .total_acquired = total_acquired_.load(std::memory_order_relaxed),
             .total_released = total_released_.load(std::memory_order_relaxed),
             .cache_hits = cache_hits_.load(std::memory_order_relaxed),
-            .cache_misses = cache_misses_.load(std::memory_order_relaxed)
+            .cache_misses = cache_misses_.load(std::memory_order_relaxed),
+            .thread_cache_hits = thread_cache_hits_.load(std::memory_order_relaxed),
+            .thread_caches = thread_caches_.size()
         };
     }
 
 private:
+    /**
+     * One thread's free list. The mutex is uncontended on the owner's
+     * acquire/release path; reset() and getStats() are the only other
+     * lockers.
+     */
+    struct ThreadCache {
+        mutable std::mutex mutex;
+        std::vector<id<MTLCommandBuffer>> buffers;
+    };
+
+    /**
+     * Get (or lazily create and register) the calling thread's cache
+     */
+    ThreadCache* localCache() {
+        static thread_local std::unordered_map<uint64_t, ThreadCache*> tls;
+        auto it = tls.find(pool_id_);
+        if (it != tls.end()) {
+            return it->second;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto owned = std::make_unique<ThreadCache>();
+        owned->buffers.reserve(thread_cache_size_);
+        ThreadCache* cache = owned.get();
+        thread_caches_.push_back(std::move(owned));
+        tls.emplace(pool_id_, cache);
+        return cache;
+    }
+
     id<MTLDevice> device_;
     id<MTLCommandQueue> queue_;
     std::vector<id<MTLCommandBuffer>> pool_;
+    std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
     size_t max_pool_size_;
+    size_t thread_cache_size_;
+    uint64_t pool_id_;
 
     mutable std::mutex mutex_;
 
@@ -105,11 +197,12 @@ private:
     std::atomic<uint64_t> total_released_;
     std::atomic<uint64_t> cache_hits_;
     std::atomic<uint64_t> cache_misses_;
+    std::atomic<uint64_t> thread_cache_hits_;
 };
 
 // Public API implementation
-CommandBufferPool::CommandBufferPool(size_t pool_size)
-    : impl_(std::make_unique<Impl>(pool_size))
+CommandBufferPool::CommandBufferPool(size_t pool_size, bool warm, size_t thread_cache_size)
+    : impl_(std::make_unique<Impl>(pool_size, warm, thread_cache_size))
 {
 }
 
@@ -1,8 +1,10 @@
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
 #include "../include/kr_blit_queue.h"
+#include "../include/kr_trace_ring.h"
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <atomic>
 #include <chrono>
@@ -79,6 +81,24 @@ public:
         // Reserve space for pending operations tracking
         pending_ops_.reserve(config_.max_pending_ops);
 
+        // Pre-allocate the streaming staging ring (shared storage buffers
+        // are page-aligned; contents stay mapped for the queue's lifetime)
+        if (config_.staging_ring_slots > 0 && config_.staging_slot_kb > 0) {
+            staging_slot_count_ = config_.staging_ring_slots;
+            staging_slots_ = std::make_unique<StagingSlot[]>(staging_slot_count_);
+            const size_t slot_bytes = config_.staging_slot_kb * 1024;
+            for (size_t i = 0; i < staging_slot_count_; ++i) {
+                StagingSlot& slot = staging_slots_[i];
+                slot.buffer = [device_ newBufferWithLength:slot_bytes
+                                                   options:MTLResourceStorageModeShared];
+                if (!slot.buffer) {
+                    throw std::runtime_error("Failed to allocate streaming staging slot");
+                }
+                slot.buffer.label = @"krserve.blit.staging_slot";
+                slot.in_use.store(false, std::memory_order_relaxed);
+            }
+        }
+
         std::cerr << "[BlitQueue] Initialized: "
                   << "max_pending=" << config_.max_pending_ops
                   << ", shared_events=" << (config_.use_shared_events ? "yes" : "no")
@@ -109,6 +129,12 @@ public:
         pending_ops_.clear();
         completed_ops_.clear();
 
+        // Release staging ring (ARC handles buffer cleanup)
+        staging_slots_.reset();
+        staging_slot_count_ = 0;
+        transient_staging_.clear();
+        streaming_slot_map_.clear();
+
         // Release Metal objects (ARC handles cleanup)
         shared_event_ = nil;
         blit_queue_ = nil;
@@ -149,6 +175,7 @@ public:
         const uint64_t event_value = next_event_value_.fetch_add(1, std::memory_order_relaxed);
 
         auto start_time = std::chrono::steady_clock::now();
+        TraceRing::instance().beginAsync("blit_upload", "blit", op_id);
 
         // Create blit command buffer
         id<MTLCommandBuffer> cmd_buffer = [blit_queue_ commandBuffer];
@@ -175,6 +202,7 @@ public:
         // Add completion handler for metrics and callbacks
         [cmd_buffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
             auto end_time = std::chrono::steady_clock::now();
+            TraceRing::instance().endAsync("blit_upload", "blit", op_id);
             this->onBlitComplete(op_id, start_time, end_time, true, source_size, completion);
         }];
 
@@ -200,12 +228,179 @@ public:
         return op_id;
     }
 
+    uint64_t uploadBatchAsync(
+        const std::vector<BlitQueue::UploadRegion>& regions,
+        CompletionHandler completion
+    ) {
+        if (!config_.enabled) {
+            throw std::runtime_error("BlitQueue is disabled");
+        }
+
+        if (regions.empty()) {
+            throw std::invalid_argument("uploadBatchAsync: regions is empty");
+        }
+
+        // Validate every region up front — the batch commits atomically,
+        // so a bad region must fail before anything is encoded.
+        size_t total_size = 0;
+        for (const auto& region : regions) {
+            if (!region.source_data || !region.dest_buffer || region.source_size == 0) {
+                throw std::invalid_argument("uploadBatchAsync: invalid region");
+            }
+
+            id<MTLBuffer> dest_buffer = (__bridge id<MTLBuffer>)region.dest_buffer;
+            if (region.dest_offset + region.source_size > [dest_buffer length]) {
+                throw std::invalid_argument("uploadBatchAsync: region would exceed buffer bounds");
+            }
+
+            total_size += region.source_size;
+        }
+
+        // One staging buffer holds all regions back-to-back
+        id<MTLBuffer> staging_buffer = [device_ newBufferWithLength:total_size
+                                                            options:MTLResourceStorageModeShared];
+        if (!staging_buffer) {
+            throw std::runtime_error("Failed to create staging buffer for batch upload");
+        }
+
+        char* staging_base = static_cast<char*>([staging_buffer contents]);
+        size_t staging_offset = 0;
+        for (const auto& region : regions) {
+            memcpy(staging_base + staging_offset, region.source_data, region.source_size);
+            staging_offset += region.source_size;
+        }
+
+        const uint64_t op_id = next_op_id_.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t event_value = next_event_value_.fetch_add(1, std::memory_order_relaxed);
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        // One command buffer, one encoder, N copies
+        id<MTLCommandBuffer> cmd_buffer = [blit_queue_ commandBuffer];
+        cmd_buffer.label = [NSString stringWithFormat:@"krserve.blit.upload_batch.%llu", op_id];
+        TraceRing::instance().beginAsync("blit_upload_batch", "blit", op_id);
+
+        id<MTLBlitCommandEncoder> encoder = [cmd_buffer blitCommandEncoder];
+        encoder.label = @"krserve.blit.encoder.upload_batch";
+
+        staging_offset = 0;
+        for (const auto& region : regions) {
+            id<MTLBuffer> dest_buffer = (__bridge id<MTLBuffer>)region.dest_buffer;
+            [encoder copyFromBuffer:staging_buffer
+                       sourceOffset:staging_offset
+                           toBuffer:dest_buffer
+                  destinationOffset:region.dest_offset
+                               size:region.source_size];
+            staging_offset += region.source_size;
+        }
+
+        [encoder endEncoding];
+
+        // One shared-event signal for the whole batch
+        if (config_.use_shared_events && shared_event_) {
+            [cmd_buffer encodeSignalEvent:shared_event_ value:event_value];
+        }
+
+        const size_t region_count = regions.size();
+        [cmd_buffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+            auto end_time = std::chrono::steady_clock::now();
+            TraceRing::instance().endAsync("blit_upload_batch", "blit", op_id);
+            this->onBlitComplete(op_id, start_time, end_time, true, total_size, completion);
+            this->coalesced_regions_.fetch_add(region_count, std::memory_order_relaxed);
+        }];
+
+        // Commit command buffer (non-blocking): one commit for the batch
+        [cmd_buffer commit];
+
+        // Track pending operation (one op covers all regions)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ops_[op_id] = {
+                .op_id = op_id,
+                .event_value = event_value,
+                .start_time = start_time,
+                .end_time = {},
+                .is_upload = true,
+                .data_size = total_size,
+                .completion = completion
+            };
+        }
+
+        total_uploads_.fetch_add(1, std::memory_order_relaxed);
+        batched_uploads_.fetch_add(1, std::memory_order_relaxed);
+
+        return op_id;
+    }
+
+    BlitQueue::EventHandle getEventHandle(uint64_t operation_id) const {
+        if (!config_.enabled || !config_.use_shared_events || !shared_event_) {
+            return {};
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = pending_ops_.find(operation_id);
+        if (it == pending_ops_.end()) {
+            it = completed_ops_.find(operation_id);
+            if (it == completed_ops_.end()) {
+                return {};
+            }
+        }
+
+        return {
+            .event = (__bridge void*)shared_event_,
+            .value = it->second.event_value
+        };
+    }
+
+    BlitQueue::EventHandle nextSignalHandle() {
+        if (!config_.enabled || !config_.use_shared_events || !shared_event_) {
+            return {};
+        }
+
+        return {
+            .event = (__bridge void*)shared_event_,
+            .value = next_event_value_.fetch_add(1, std::memory_order_relaxed)
+        };
+    }
+
+    uint64_t downloadAsyncAfter(
+        const BlitQueue::EventHandle& after,
+        void* source_buffer_ptr,
+        size_t source_offset,
+        void* dest_data,
+        size_t dest_size,
+        CompletionHandler completion
+    ) {
+        if (!after.isValid()) {
+            throw std::invalid_argument("downloadAsyncAfter: invalid event handle");
+        }
+
+        uint64_t op_id = downloadAsyncInternal(
+            source_buffer_ptr, source_offset, dest_data, dest_size,
+            completion, &after);
+        chained_downloads_.fetch_add(1, std::memory_order_relaxed);
+        return op_id;
+    }
+
     uint64_t downloadAsync(
         void* source_buffer_ptr,
         size_t source_offset,
         void* dest_data,
         size_t dest_size,
         CompletionHandler completion
+    ) {
+        return downloadAsyncInternal(source_buffer_ptr, source_offset,
+                                     dest_data, dest_size, completion, nullptr);
+    }
+
+    uint64_t downloadAsyncInternal(
+        void* source_buffer_ptr,
+        size_t source_offset,
+        void* dest_data,
+        size_t dest_size,
+        CompletionHandler completion,
+        const BlitQueue::EventHandle* after
     ) {
         if (!config_.enabled) {
             throw std::runtime_error("BlitQueue is disabled");
@@ -237,6 +432,14 @@ public:
         // Create blit command buffer
         id<MTLCommandBuffer> cmd_buffer = [blit_queue_ commandBuffer];
         cmd_buffer.label = [NSString stringWithFormat:@"krserve.blit.download.%llu", op_id];
+        TraceRing::instance().beginAsync("blit_download", "blit", op_id);
+
+        // GPU-side dependency: the blit waits for `after` on-GPU, so the
+        // producing compute buffer orders this download with no CPU stall
+        if (after && after->isValid()) {
+            [cmd_buffer encodeWaitForEvent:(__bridge id<MTLSharedEvent>)after->event
+                                     value:after->value];
+        }
 
         // Create blit encoder
         id<MTLBlitCommandEncoder> encoder = [cmd_buffer blitCommandEncoder];
@@ -262,6 +465,7 @@ public:
             memcpy(dest_data, [staging_buffer contents], dest_size);
 
             auto end_time = std::chrono::steady_clock::now();
+            TraceRing::instance().endAsync("blit_download", "blit", op_id);
             this->onBlitComplete(op_id, start_time, end_time, false, dest_size, completion);
         }];
 
@@ -287,6 +491,132 @@ public:
         return op_id;
     }
 
+    BlitQueue::StreamingDownload downloadStreaming(
+        void* source_buffer_ptr,
+        size_t source_offset,
+        size_t size,
+        CompletionHandler completion
+    ) {
+        if (!config_.enabled) {
+            throw std::runtime_error("BlitQueue is disabled");
+        }
+
+        if (!source_buffer_ptr || size == 0) {
+            throw std::invalid_argument("Invalid streaming download parameters");
+        }
+
+        id<MTLBuffer> source_buffer = (__bridge id<MTLBuffer>)source_buffer_ptr;
+        if (source_offset + size > [source_buffer length]) {
+            throw std::invalid_argument("Streaming download would exceed buffer bounds");
+        }
+
+        // Claim a ring slot (lock-free CAS scan from a rotating cursor)
+        const size_t slot_bytes = config_.staging_slot_kb * 1024;
+        id<MTLBuffer> staging_buffer = nil;
+        size_t slot_index = SIZE_MAX;
+
+        if (size <= slot_bytes && staging_slot_count_ > 0) {
+            const size_t slot_count = staging_slot_count_;
+            size_t start = next_slot_.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < slot_count; ++i) {
+                size_t index = (start + i) % slot_count;
+                bool expected = false;
+                if (staging_slots_[index].in_use.compare_exchange_strong(
+                        expected, true, std::memory_order_acquire)) {
+                    slot_index = index;
+                    staging_buffer = staging_slots_[index].buffer;
+                    break;
+                }
+            }
+        }
+
+        // Ring exhausted or request oversized: transient fallback keeps the
+        // same contract (stable pointer until releaseStreamingSlot)
+        if (!staging_buffer) {
+            staging_buffer = [device_ newBufferWithLength:size
+                                                  options:MTLResourceStorageModeShared];
+            if (!staging_buffer) {
+                throw std::runtime_error("Failed to create fallback staging buffer");
+            }
+            staging_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const uint64_t op_id = next_op_id_.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t event_value = next_event_value_.fetch_add(1, std::memory_order_relaxed);
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        id<MTLCommandBuffer> cmd_buffer = [blit_queue_ commandBuffer];
+        cmd_buffer.label = [NSString stringWithFormat:@"krserve.blit.stream.%llu", op_id];
+
+        id<MTLBlitCommandEncoder> encoder = [cmd_buffer blitCommandEncoder];
+        encoder.label = @"krserve.blit.encoder.stream";
+
+        [encoder copyFromBuffer:source_buffer
+                   sourceOffset:source_offset
+                       toBuffer:staging_buffer
+              destinationOffset:0
+                           size:size];
+
+        [encoder endEncoding];
+
+        if (config_.use_shared_events && shared_event_) {
+            [cmd_buffer encodeSignalEvent:shared_event_ value:event_value];
+        }
+
+        // No memcpy in the completion handler — the caller reads the slot
+        // memory directly, that's the point of the streaming path
+        [cmd_buffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+            auto end_time = std::chrono::steady_clock::now();
+            this->onBlitComplete(op_id, start_time, end_time, false, size, completion);
+        }];
+
+        [cmd_buffer commit];
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ops_[op_id] = {
+                .op_id = op_id,
+                .event_value = event_value,
+                .start_time = start_time,
+                .end_time = {},
+                .is_upload = false,
+                .data_size = size,
+                .completion = completion
+            };
+            streaming_slot_map_[op_id] = slot_index;
+            if (slot_index == SIZE_MAX) {
+                transient_staging_[op_id] = staging_buffer;
+            }
+        }
+
+        total_downloads_.fetch_add(1, std::memory_order_relaxed);
+        streaming_downloads_.fetch_add(1, std::memory_order_relaxed);
+
+        return {
+            .op_id = op_id,
+            .data = [staging_buffer contents]
+        };
+    }
+
+    void releaseStreamingSlot(uint64_t op_id) {
+        size_t slot_index = SIZE_MAX;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = streaming_slot_map_.find(op_id);
+            if (it == streaming_slot_map_.end()) {
+                return;
+            }
+            slot_index = it->second;
+            streaming_slot_map_.erase(it);
+            transient_staging_.erase(op_id);  // No-op for ring-slot downloads
+        }
+
+        if (slot_index != SIZE_MAX) {
+            staging_slots_[slot_index].in_use.store(false, std::memory_order_release);
+        }
+    }
+
     bool waitForCompletion(uint64_t operation_id, uint64_t timeout_ms) {
         if (!config_.enabled) {
             return true;
@@ -415,7 +745,12 @@ public:
             .sync_wait_count = sync_wait_count_.load(std::memory_order_relaxed),
             .avg_sync_wait_ms = sync_wait_count_ > 0
                 ? (total_sync_wait_ms_ / sync_wait_count_)
-                : 0.0
+                : 0.0,
+            .batched_uploads = batched_uploads_.load(std::memory_order_relaxed),
+            .coalesced_regions = coalesced_regions_.load(std::memory_order_relaxed),
+            .chained_downloads = chained_downloads_.load(std::memory_order_relaxed),
+            .streaming_downloads = streaming_downloads_.load(std::memory_order_relaxed),
+            .staging_fallbacks = staging_fallbacks_.load(std::memory_order_relaxed)
         };
     }
 
@@ -428,6 +763,11 @@ public:
         total_overlap_ms_ = 0.0;
         sync_wait_count_.store(0, std::memory_order_relaxed);
         total_sync_wait_ms_ = 0.0;
+        batched_uploads_.store(0, std::memory_order_relaxed);
+        coalesced_regions_.store(0, std::memory_order_relaxed);
+        chained_downloads_.store(0, std::memory_order_relaxed);
+        streaming_downloads_.store(0, std::memory_order_relaxed);
+        staging_fallbacks_.store(0, std::memory_order_relaxed);
         completed_ops_.clear();
     }
 
@@ -454,6 +794,17 @@ private:
     std::unordered_map<uint64_t, BlitOperation> pending_ops_;
     std::unordered_map<uint64_t, BlitOperation> completed_ops_;
 
+    // Streaming staging ring
+    struct StagingSlot {
+        id<MTLBuffer> buffer = nil;
+        std::atomic<bool> in_use{false};
+    };
+    std::unique_ptr<StagingSlot[]> staging_slots_;  // Fixed array (atomics aren't movable)
+    size_t staging_slot_count_ = 0;
+    std::atomic<size_t> next_slot_{0};
+    std::unordered_map<uint64_t, size_t> streaming_slot_map_;     // op -> slot (SIZE_MAX = transient)
+    std::unordered_map<uint64_t, id<MTLBuffer>> transient_staging_;  // fallback buffers kept alive
+
     // Thread safety
     mutable std::mutex mutex_;
 
@@ -469,6 +820,11 @@ private:
     double total_overlap_ms_;
     std::atomic<uint64_t> sync_wait_count_;
     double total_sync_wait_ms_;
+    std::atomic<uint64_t> batched_uploads_{0};
+    std::atomic<uint64_t> coalesced_regions_{0};
+    std::atomic<uint64_t> chained_downloads_{0};
+    std::atomic<uint64_t> streaming_downloads_{0};
+    std::atomic<uint64_t> staging_fallbacks_{0};
 
     /**
      * Called when blit operation completes (from MTLCommandBuffer callback)
@@ -585,6 +941,13 @@ uint64_t BlitQueue::uploadAsync(
     return impl_->uploadAsync(source_data, source_size, dest_buffer, dest_offset, completion);
 }
 
+uint64_t BlitQueue::uploadBatchAsync(
+    const std::vector<UploadRegion>& regions,
+    CompletionHandler completion
+) {
+    return impl_->uploadBatchAsync(regions, completion);
+}
+
 uint64_t BlitQueue::downloadAsync(
     void* source_buffer,
     size_t source_offset,
@@ -595,6 +958,57 @@ uint64_t BlitQueue::downloadAsync(
     return impl_->downloadAsync(source_buffer, source_offset, dest_data, dest_size, completion);
 }
 
+uint64_t BlitQueue::downloadAsyncAfter(
+    const EventHandle& after,
+    void* source_buffer,
+    size_t source_offset,
+    void* dest_data,
+    size_t dest_size,
+    CompletionHandler completion
+) {
+    return impl_->downloadAsyncAfter(after, source_buffer, source_offset,
+                                     dest_data, dest_size, completion);
+}
+
+BlitQueue::StreamingDownload BlitQueue::downloadStreaming(
+    void* source_buffer,
+    size_t source_offset,
+    size_t size,
+    CompletionHandler completion
+) {
+    return impl_->downloadStreaming(source_buffer, source_offset, size, completion);
+}
+
+void BlitQueue::releaseStreamingSlot(uint64_t op_id) {
+    impl_->releaseStreamingSlot(op_id);
+}
+
+BlitQueue::EventHandle BlitQueue::getEventHandle(uint64_t operation_id) const {
+    return impl_->getEventHandle(operation_id);
+}
+
+BlitQueue::EventHandle BlitQueue::nextSignalHandle() {
+    return impl_->nextSignalHandle();
+}
+
+void BlitQueue::encodeWait(void* command_buffer, const EventHandle& handle) {
+    if (!command_buffer || !handle.isValid()) {
+        return;
+    }
+    id<MTLCommandBuffer> cmd_buffer = (__bridge id<MTLCommandBuffer>)command_buffer;
+    [cmd_buffer encodeWaitForEvent:(__bridge id<MTLSharedEvent>)handle.event
+                             value:handle.value];
+}
+
+void BlitQueue::encodeSignal(void* command_buffer, const EventHandle& handle) {
+    if (!command_buffer || !handle.isValid()) {
+        return;
+    }
+    id<MTLCommandBuffer> cmd_buffer = (__bridge id<MTLCommandBuffer>)command_buffer;
+    [cmd_buffer encodeSignalEvent:(__bridge id<MTLSharedEvent>)handle.event
+                            value:handle.value];
+}
+
 bool BlitQueue::waitForCompletion(uint64_t operation_id, uint64_t timeout_ms) {
     return impl_->waitForCompletion(operation_id, timeout_ms);
 }
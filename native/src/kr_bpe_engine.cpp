@@ -0,0 +1,865 @@
+#include "../include/kr_bpe_engine.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <iostream>
+#include <limits>
+#include <cctype>
+#include <cstring>
+
+// Zero-copy compiled-vocabulary mapping
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace krserve {
+
+namespace {
+
+// ============================================================================
+// Compiled vocabulary format
+// ============================================================================
+//
+// One contiguous file, mapped read-only and shared across forked workers:
+//
+//   [CompiledHeader]
+//   [TableSlot x vocab_slots]     open-addressing index: token -> id
+//   [TableSlot x merge_slots]     open-addressing index: pair key -> rank
+//   [uint64 x (max_token_id + 2)] decode blob offsets (id -> bytes)
+//   [string blob]                 key bytes referenced by the slots
+//   [decode blob]                 raw token bytes referenced by offsets
+//
+// The index is a flat power-of-two open-addressing table at <= 50% load
+// (linear probing), so a lookup is one hash plus a short contiguous scan
+// of 16-byte slots — the cache behavior the merge loop wants. Blobs sit
+// last so every typed array in the file stays 8-byte aligned.
+
+constexpr char COMPILED_MAGIC[8] = {'K', 'R', 'B', 'P', 'E', 'V', '1', '\0'};
+constexpr uint32_t COMPILED_VERSION = 1;
+
+// str_len sentinel for an unoccupied slot
+constexpr uint32_t SLOT_EMPTY = std::numeric_limits<uint32_t>::max();
+
+struct CompiledHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vocab_count;
+    uint32_t merge_count;
+    uint32_t vocab_slots;          // Power of two
+    uint32_t merge_slots;          // Power of two
+    uint32_t max_token_id;
+    uint64_t vocab_table_offset;
+    uint64_t merge_table_offset;
+    uint64_t decode_offsets_offset;
+    uint64_t string_blob_offset;
+    uint64_t string_blob_size;
+    uint64_t decode_blob_offset;
+    uint64_t decode_blob_size;
+    uint64_t total_size;
+};
+
+struct TableSlot {
+    uint64_t str_offset;           // Into the string blob
+    uint32_t str_len;              // SLOT_EMPTY = unoccupied
+    uint32_t value;                // Token id or merge rank
+};
+
+static_assert(sizeof(TableSlot) == 16, "TableSlot must pack to 16 bytes");
+
+/**
+ * FNV-1a 64-bit over the key bytes (same non-cryptographic family the
+ * KV block pool uses for prefix hashing)
+ */
+inline uint64_t fnv1aHash(const char* data, size_t len) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Round up to the next power of two (minimum 2)
+ */
+inline uint32_t nextPowerOfTwo(uint32_t v) {
+    if (v < 2) return 2;
+    --v;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return v + 1;
+}
+
+/**
+ * Insert a key into an open-addressing slot table (build time only)
+ */
+void insertSlot(std::vector<TableSlot>& slots, const std::string& key,
+                uint64_t str_offset, uint32_t value) {
+    const uint32_t mask = static_cast<uint32_t>(slots.size()) - 1;
+    uint32_t index = static_cast<uint32_t>(fnv1aHash(key.data(), key.size())) & mask;
+    while (slots[index].str_len != SLOT_EMPTY) {
+        index = (index + 1) & mask;
+    }
+    slots[index].str_offset = str_offset;
+    slots[index].str_len = static_cast<uint32_t>(key.size());
+    slots[index].value = value;
+}
+
+/**
+ * Probe an open-addressing slot table (lookup)
+ */
+inline uint32_t probeSlots(const TableSlot* slots, uint32_t slot_count,
+                           const char* strings, const char* key,
+                           size_t key_len) {
+    const uint32_t mask = slot_count - 1;
+    uint32_t index = static_cast<uint32_t>(fnv1aHash(key, key_len)) & mask;
+    for (uint32_t step = 0; step < slot_count; ++step) {
+        const TableSlot& slot = slots[index];
+        if (slot.str_len == SLOT_EMPTY) {
+            return std::numeric_limits<uint32_t>::max();
+        }
+        if (slot.str_len == key_len &&
+            std::memcmp(strings + slot.str_offset, key, key_len) == 0) {
+            return slot.value;
+        }
+        index = (index + 1) & mask;
+    }
+    return std::numeric_limits<uint32_t>::max();
+}
+
+/**
+ * Encode a unicode code point as UTF-8
+ */
+std::string codepointToUtf8(uint32_t cp) {
+    std::string out;
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * Decode one UTF-8 escape or character from a JSON string literal
+ *
+ * Minimal JSON string unescaper — enough for vocab.json token keys.
+ */
+std::string unescapeJsonString(const std::string& raw) {
+    std::string out;
+    out.reserve(raw.size());
+
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+
+        if (i + 1 >= raw.size()) break;
+        char esc = raw[++i];
+        switch (esc) {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/';  break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u': {
+                if (i + 4 >= raw.size()) break;
+                uint32_t cp = static_cast<uint32_t>(
+                    std::stoul(raw.substr(i + 1, 4), nullptr, 16));
+                i += 4;
+
+                // Handle UTF-16 surrogate pairs
+                if (cp >= 0xD800 && cp <= 0xDBFF &&
+                    i + 6 < raw.size() && raw[i + 1] == '\\' && raw[i + 2] == 'u') {
+                    uint32_t low = static_cast<uint32_t>(
+                        std::stoul(raw.substr(i + 3, 4), nullptr, 16));
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                out += codepointToUtf8(cp);
+                break;
+            }
+            default:
+                out += esc;
+                break;
+        }
+    }
+
+    return out;
+}
+
+// ============================================================================
+// GPT-2 pre-tokenization character classes
+// ============================================================================
+
+// Sorted [first, last] codepoint ranges for \p{L}, \p{N}, and \s
+#include "kr_unicode_tables.inc"
+
+inline bool inRanges(const CodepointRange* ranges, size_t count, uint32_t cp) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cp > ranges[mid].last) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < count && cp >= ranges[lo].first;
+}
+
+inline bool isLetterCp(uint32_t cp) {
+    return inRanges(UNICODE_LETTER_RANGES,
+                    sizeof(UNICODE_LETTER_RANGES) / sizeof(CodepointRange), cp);
+}
+
+inline bool isNumberCp(uint32_t cp) {
+    return inRanges(UNICODE_NUMBER_RANGES,
+                    sizeof(UNICODE_NUMBER_RANGES) / sizeof(CodepointRange), cp);
+}
+
+inline bool isSpaceCp(uint32_t cp) {
+    return inRanges(UNICODE_SPACE_RANGES,
+                    sizeof(UNICODE_SPACE_RANGES) / sizeof(CodepointRange), cp);
+}
+
+/**
+ * Decode one UTF-8 codepoint starting at `i`
+ *
+ * Invalid or truncated sequences decode as the single raw byte so no
+ * input can derail the scanner; BPE byte-encodes everything downstream
+ * either way.
+ */
+inline uint32_t decodeUtf8(const std::string& text, size_t i, size_t& char_len) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    char_len = 1;
+    if ((c & 0x80) == 0) return c;
+
+    size_t len = 0;
+    uint32_t cp = 0;
+    if ((c & 0xE0) == 0xC0) { len = 2; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { len = 3; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { len = 4; cp = c & 0x07; }
+    else return c;
+
+    if (len > text.size() - i) return c;
+    for (size_t k = 1; k < len; ++k) {
+        unsigned char cont = static_cast<unsigned char>(text[i + k]);
+        if ((cont & 0xC0) != 0x80) return c;
+        cp = (cp << 6) | (cont & 0x3F);
+    }
+    char_len = len;
+    return cp;
+}
+
+/**
+ * Match a GPT-2 contraction ('s|'t|'re|'ve|'m|'ll|'d) at `i`
+ *
+ * The pattern is lowercase-only, exactly as trained. Returns the match
+ * length including the apostrophe, or 0.
+ */
+inline size_t matchContraction(const std::string& text, size_t i) {
+    const size_t remaining = text.size() - i;
+    if (remaining < 2 || text[i] != '\'') return 0;
+    const char c1 = text[i + 1];
+    if (c1 == 's' || c1 == 't' || c1 == 'm' || c1 == 'd') return 2;
+    if (remaining >= 3) {
+        const char c2 = text[i + 2];
+        if ((c1 == 'r' && c2 == 'e') ||
+            (c1 == 'v' && c2 == 'e') ||
+            (c1 == 'l' && c2 == 'l')) {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+BpeEngine::BpeEngine() {
+    buildByteTables();
+}
+
+BpeEngine::~BpeEngine() {
+    unmapCompiled();
+}
+
+// Build GPT-2 byte <-> unicode tables
+//
+// Printable bytes map to themselves; the rest are shifted into the
+// 0x100+ private range so every byte has a visible unicode stand-in.
+void BpeEngine::buildByteTables() {
+    std::vector<int> bs;
+    for (int b = '!'; b <= '~'; ++b) bs.push_back(b);
+    for (int b = 0xA1; b <= 0xAC; ++b) bs.push_back(b);
+    for (int b = 0xAE; b <= 0xFF; ++b) bs.push_back(b);
+
+    std::vector<int> cs = bs;
+    int n = 0;
+    for (int b = 0; b < 256; ++b) {
+        bool found = false;
+        for (int x : bs) {
+            if (x == b) { found = true; break; }
+        }
+        if (!found) {
+            bs.push_back(b);
+            cs.push_back(256 + n);
+            ++n;
+        }
+    }
+
+    for (size_t i = 0; i < bs.size(); ++i) {
+        std::string encoded = codepointToUtf8(static_cast<uint32_t>(cs[i]));
+        byte_encoder_[static_cast<size_t>(bs[i])] = encoded;
+        byte_decoder_[encoded] = static_cast<uint8_t>(bs[i]);
+    }
+}
+
+void BpeEngine::loadFromFiles(const std::string& vocab_path, const std::string& merges_path) {
+    // --- Parse vocab.json (flat {"token": id, ...} object) ---
+    std::ifstream vocab_file(vocab_path, std::ios::binary);
+    if (!vocab_file) {
+        throw std::runtime_error("BpeEngine: failed to open vocab file: " + vocab_path);
+    }
+
+    std::stringstream vocab_ss;
+    vocab_ss << vocab_file.rdbuf();
+    const std::string json = vocab_ss.str();
+
+    std::unordered_map<std::string, uint32_t> vocab;
+    size_t pos = 0;
+    const size_t len = json.size();
+
+    while (pos < len) {
+        // Find next string key
+        while (pos < len && json[pos] != '"') ++pos;
+        if (pos >= len) break;
+        ++pos;
+
+        // Scan key (respecting escapes)
+        std::string raw_key;
+        while (pos < len && json[pos] != '"') {
+            if (json[pos] == '\\' && pos + 1 < len) {
+                raw_key += json[pos];
+                raw_key += json[pos + 1];
+                pos += 2;
+            } else {
+                raw_key += json[pos];
+                ++pos;
+            }
+        }
+        ++pos; // closing quote
+
+        // Expect ':' then integer value
+        while (pos < len && (json[pos] == ':' || std::isspace(static_cast<unsigned char>(json[pos])))) ++pos;
+        size_t num_start = pos;
+        while (pos < len && std::isdigit(static_cast<unsigned char>(json[pos]))) ++pos;
+        if (pos == num_start) continue; // not a key:int pair (e.g. nested value)
+
+        uint32_t id = static_cast<uint32_t>(
+            std::stoul(json.substr(num_start, pos - num_start)));
+        vocab[unescapeJsonString(raw_key)] = id;
+    }
+
+    if (vocab.empty()) {
+        throw std::runtime_error("BpeEngine: no entries parsed from vocab file: " + vocab_path);
+    }
+
+    // --- Parse merges.txt (one "left right" pair per line, rank order) ---
+    std::ifstream merges_file(merges_path, std::ios::binary);
+    if (!merges_file) {
+        throw std::runtime_error("BpeEngine: failed to open merges file: " + merges_path);
+    }
+
+    std::vector<std::pair<std::string, std::string>> merges;
+    std::string line;
+    while (std::getline(merges_file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        size_t space = line.find(' ');
+        if (space == std::string::npos) continue;
+        merges.emplace_back(line.substr(0, space), line.substr(space + 1));
+    }
+
+    loadFromTables(vocab, merges);
+}
+
+void BpeEngine::loadFromTables(
+    const std::unordered_map<std::string, uint32_t>& vocab,
+    const std::vector<std::pair<std::string, std::string>>& merges
+) {
+    if (vocab.empty()) {
+        throw std::invalid_argument("BpeEngine: vocabulary is empty");
+    }
+
+    unmapCompiled();
+    vocab_ = vocab;
+
+    merge_ranks_.clear();
+    merge_ranks_.reserve(merges.size());
+    for (size_t rank = 0; rank < merges.size(); ++rank) {
+        merge_ranks_[merges[rank].first + '\x01' + merges[rank].second] =
+            static_cast<uint32_t>(rank);
+    }
+    merge_count_ = merge_ranks_.size();
+
+    finalizeLoad();
+
+    std::cerr << "[BpeEngine] Loaded vocabulary: "
+              << vocab_.size() << " tokens, "
+              << merge_ranks_.size() << " merges"
+              << std::endl;
+}
+
+void BpeEngine::compileToFile(const std::string& path) const {
+    if (!loaded_ || vocab_.empty()) {
+        throw std::runtime_error(
+            "BpeEngine: load a source vocabulary (loadFromFiles/loadFromTables) "
+            "before compiling");
+    }
+
+    // <= 50% load factor keeps linear-probe chains short
+    const uint32_t vocab_slots =
+        nextPowerOfTwo(static_cast<uint32_t>(vocab_.size()) * 2);
+    const uint32_t merge_slots =
+        nextPowerOfTwo(static_cast<uint32_t>(merge_ranks_.size()) * 2);
+
+    // Build the string blob and both slot tables in memory
+    std::string strings;
+    std::vector<TableSlot> vocab_table(vocab_slots,
+                                       TableSlot{0, SLOT_EMPTY, 0});
+    std::vector<TableSlot> merge_table(merge_slots,
+                                       TableSlot{0, SLOT_EMPTY, 0});
+
+    for (const auto& entry : vocab_) {
+        insertSlot(vocab_table, entry.first, strings.size(), entry.second);
+        strings += entry.first;
+    }
+    for (const auto& entry : merge_ranks_) {
+        insertSlot(merge_table, entry.first, strings.size(), entry.second);
+        strings += entry.first;
+    }
+
+    // Decode table: offsets into one bytes blob, one entry per id plus a
+    // terminator so entry i spans [offsets[i], offsets[i+1])
+    std::string decode_blob;
+    std::vector<uint64_t> decode_offsets;
+    decode_offsets.reserve(id_to_bytes_.size() + 1);
+    for (const std::string& bytes : id_to_bytes_) {
+        decode_offsets.push_back(decode_blob.size());
+        decode_blob += bytes;
+    }
+    decode_offsets.push_back(decode_blob.size());
+
+    CompiledHeader header{};
+    std::memcpy(header.magic, COMPILED_MAGIC, sizeof(header.magic));
+    header.version = COMPILED_VERSION;
+    header.vocab_count = static_cast<uint32_t>(vocab_.size());
+    header.merge_count = static_cast<uint32_t>(merge_ranks_.size());
+    header.vocab_slots = vocab_slots;
+    header.merge_slots = merge_slots;
+    header.max_token_id = static_cast<uint32_t>(id_to_bytes_.size()) - 1;
+    header.vocab_table_offset = sizeof(CompiledHeader);
+    header.merge_table_offset =
+        header.vocab_table_offset + vocab_slots * sizeof(TableSlot);
+    header.decode_offsets_offset =
+        header.merge_table_offset + merge_slots * sizeof(TableSlot);
+    header.string_blob_offset =
+        header.decode_offsets_offset + decode_offsets.size() * sizeof(uint64_t);
+    header.string_blob_size = strings.size();
+    header.decode_blob_offset = header.string_blob_offset + strings.size();
+    header.decode_blob_size = decode_blob.size();
+    header.total_size = header.decode_blob_offset + decode_blob.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(
+            "BpeEngine: failed to open compiled vocab for writing: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(vocab_table.data()),
+              static_cast<std::streamsize>(vocab_table.size() * sizeof(TableSlot)));
+    out.write(reinterpret_cast<const char*>(merge_table.data()),
+              static_cast<std::streamsize>(merge_table.size() * sizeof(TableSlot)));
+    out.write(reinterpret_cast<const char*>(decode_offsets.data()),
+              static_cast<std::streamsize>(decode_offsets.size() * sizeof(uint64_t)));
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    out.write(decode_blob.data(), static_cast<std::streamsize>(decode_blob.size()));
+    if (!out) {
+        throw std::runtime_error(
+            "BpeEngine: failed while writing compiled vocab: " + path);
+    }
+
+    std::cerr << "[BpeEngine] Compiled vocabulary: "
+              << vocab_.size() << " tokens, "
+              << merge_ranks_.size() << " merges, "
+              << (header.total_size / (1024.0 * 1024.0)) << " MB -> "
+              << path << std::endl;
+}
+
+void BpeEngine::loadFromCompiledFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(
+            "BpeEngine: failed to open compiled vocab: " + path);
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(CompiledHeader)) {
+        ::close(fd);
+        throw std::runtime_error(
+            "BpeEngine: compiled vocab is missing or truncated: " + path);
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+
+    // Read-only shared mapping: one copy of the tables in the page cache
+    // no matter how many workers fork after this (same approach as
+    // WeightManager::loadWeightsMapped)
+    void* base = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // Mapping keeps its own reference
+    if (base == MAP_FAILED) {
+        throw std::runtime_error(
+            "BpeEngine: mmap failed for compiled vocab: " + path);
+    }
+
+    const auto* header = static_cast<const CompiledHeader*>(base);
+    if (std::memcmp(header->magic, COMPILED_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != COMPILED_VERSION ||
+        header->total_size != file_size) {
+        ::munmap(base, file_size);
+        throw std::runtime_error(
+            "BpeEngine: compiled vocab has wrong magic/version/size: " + path);
+    }
+
+    unmapCompiled();
+    map_base_ = static_cast<uint8_t*>(base);
+    map_size_ = file_size;
+
+    compiled_vocab_slots_ = map_base_ + header->vocab_table_offset;
+    compiled_merge_slots_ = map_base_ + header->merge_table_offset;
+    compiled_strings_ =
+        reinterpret_cast<const char*>(map_base_ + header->string_blob_offset);
+    compiled_vocab_slot_count_ = header->vocab_slots;
+    compiled_merge_slot_count_ = header->merge_slots;
+
+    // Materialize only the id -> bytes decode table; the encode-path
+    // indexes stay zero-copy in the mapping
+    const auto* offsets = reinterpret_cast<const uint64_t*>(
+        map_base_ + header->decode_offsets_offset);
+    const char* decode_blob =
+        reinterpret_cast<const char*>(map_base_ + header->decode_blob_offset);
+    const size_t id_count = static_cast<size_t>(header->max_token_id) + 1;
+    id_to_bytes_.clear();
+    id_to_bytes_.reserve(id_count);
+    for (size_t i = 0; i < id_count; ++i) {
+        id_to_bytes_.emplace_back(decode_blob + offsets[i],
+                                  offsets[i + 1] - offsets[i]);
+    }
+
+    // Drop the heap maps; all lookups go through the mapping now
+    vocab_.clear();
+    merge_ranks_.clear();
+    merge_count_ = header->merge_count;
+    compiled_ = true;
+    loaded_ = true;
+
+    std::cerr << "[BpeEngine] Mapped compiled vocabulary: "
+              << header->vocab_count << " tokens, "
+              << header->merge_count << " merges, "
+              << (file_size / (1024.0 * 1024.0)) << " MB (zero-copy)"
+              << std::endl;
+}
+
+void BpeEngine::unmapCompiled() {
+    if (map_base_) {
+        ::munmap(map_base_, map_size_);
+    }
+    map_base_ = nullptr;
+    map_size_ = 0;
+    compiled_vocab_slots_ = nullptr;
+    compiled_merge_slots_ = nullptr;
+    compiled_strings_ = nullptr;
+    compiled_vocab_slot_count_ = 0;
+    compiled_merge_slot_count_ = 0;
+    compiled_ = false;
+}
+
+void BpeEngine::finalizeLoad() {
+    // Build id -> raw bytes table (byte-decode each vocab entry)
+    uint32_t max_id = 0;
+    for (const auto& entry : vocab_) {
+        max_id = std::max(max_id, entry.second);
+    }
+
+    id_to_bytes_.assign(static_cast<size_t>(max_id) + 1, std::string{});
+
+    for (const auto& entry : vocab_) {
+        const std::string& token = entry.first;
+        std::string bytes;
+        bytes.reserve(token.size());
+
+        // Walk UTF-8 characters and map each back to its source byte.
+        // Characters not in the byte decoder (special tokens) pass through.
+        size_t i = 0;
+        while (i < token.size()) {
+            unsigned char c = static_cast<unsigned char>(token[i]);
+            size_t char_len = 1;
+            if ((c & 0xE0) == 0xC0) char_len = 2;
+            else if ((c & 0xF0) == 0xE0) char_len = 3;
+            else if ((c & 0xF8) == 0xF0) char_len = 4;
+            char_len = std::min(char_len, token.size() - i);
+
+            std::string ch = token.substr(i, char_len);
+            auto it = byte_decoder_.find(ch);
+            if (it != byte_decoder_.end()) {
+                bytes += static_cast<char>(it->second);
+            } else {
+                bytes += ch;
+            }
+            i += char_len;
+        }
+
+        id_to_bytes_[entry.second] = std::move(bytes);
+    }
+
+    loaded_ = true;
+}
+
+std::vector<std::string> BpeEngine::preTokenize(const std::string& text) const {
+    // GPT-2 pre-tokenization pattern:
+    //
+    //   's|'t|'re|'ve|'m|'ll|'d
+    //   | ?\p{L}+| ?\p{N}+| ?[^\s\p{L}\p{N}]+
+    //   |\s+(?!\S)|\s+
+    //
+    // Scanned by hand over codepoints instead of through a regex engine.
+    // The alternation order is load-bearing: it splits punctuation off
+    // words, keeps letter/digit runs apart, attaches a single leading
+    // ASCII space to the following token, and leaves longer whitespace
+    // runs (minus that attached space) as their own pre-tokens. The ids
+    // this produces must match the reference tokenizer the vocab/merges
+    // were trained with — divergence here silently degrades the model.
+    std::vector<std::string> words;
+    const size_t len = text.size();
+    size_t i = 0;
+
+    while (i < len) {
+        // Contractions split off only at match start; an apostrophe
+        // reached mid-run stays inside its [^\s\p{L}\p{N}]+ token
+        const size_t contraction = matchContraction(text, i);
+        if (contraction > 0) {
+            words.emplace_back(text.substr(i, contraction));
+            i += contraction;
+            continue;
+        }
+
+        size_t char_len;
+        const uint32_t cp = decodeUtf8(text, i, char_len);
+
+        if (isSpaceCp(cp)) {
+            // Scan the whitespace run, tracking its final codepoint
+            const size_t ws_start = i;
+            size_t last_start = i;
+            size_t last_len = char_len;
+            size_t j = i + char_len;
+            while (j < len) {
+                size_t cl;
+                const uint32_t wcp = decodeUtf8(text, j, cl);
+                if (!isSpaceCp(wcp)) break;
+                last_start = j;
+                last_len = cl;
+                j += cl;
+            }
+
+            if (j >= len) {
+                // \s+ with nothing after it: the whole run is one token
+                words.emplace_back(text.substr(ws_start, j - ws_start));
+                i = j;
+                continue;
+            }
+
+            // \s+(?!\S) backs off the final codepoint before a non-space
+            if (last_start > ws_start) {
+                words.emplace_back(text.substr(ws_start, last_start - ws_start));
+            }
+            if (text[last_start] != ' ') {
+                // Only a literal space can join the next token via ` ?`
+                words.emplace_back(text.substr(last_start, last_len));
+                i = j;
+                continue;
+            }
+            i = last_start;  // Fall through: space attaches to the word
+        }
+
+        // ` ?\p{L}+`, ` ?\p{N}+`, or ` ?[^\s\p{L}\p{N}]+`
+        const size_t start = i;
+        if (text[i] == ' ') ++i;  // Reachable only with a non-space next
+
+        size_t cl;
+        const uint32_t first = decodeUtf8(text, i, cl);
+        i += cl;
+        if (isLetterCp(first)) {
+            while (i < len) {
+                const uint32_t next = decodeUtf8(text, i, cl);
+                if (!isLetterCp(next)) break;
+                i += cl;
+            }
+        } else if (isNumberCp(first)) {
+            while (i < len) {
+                const uint32_t next = decodeUtf8(text, i, cl);
+                if (!isNumberCp(next)) break;
+                i += cl;
+            }
+        } else {
+            while (i < len) {
+                const uint32_t next = decodeUtf8(text, i, cl);
+                if (isSpaceCp(next) || isLetterCp(next) || isNumberCp(next)) break;
+                i += cl;
+            }
+        }
+        words.emplace_back(text.substr(start, i - start));
+    }
+
+    return words;
+}
+
+uint32_t BpeEngine::pairRank(const std::string& left, const std::string& right) const {
+    const std::string key = left + '\x01' + right;
+
+    if (compiled_) {
+        return probeSlots(static_cast<const TableSlot*>(compiled_merge_slots_),
+                          compiled_merge_slot_count_, compiled_strings_,
+                          key.data(), key.size());
+    }
+
+    auto it = merge_ranks_.find(key);
+    if (it == merge_ranks_.end()) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    return it->second;
+}
+
+uint32_t BpeEngine::lookupToken(const std::string& symbol) const {
+    if (compiled_) {
+        return probeSlots(static_cast<const TableSlot*>(compiled_vocab_slots_),
+                          compiled_vocab_slot_count_, compiled_strings_,
+                          symbol.data(), symbol.size());
+    }
+
+    auto it = vocab_.find(symbol);
+    if (it == vocab_.end()) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    return it->second;
+}
+
+void BpeEngine::bpeWord(const std::string& word, std::vector<uint32_t>& output) const {
+    // Byte-encode the word into initial single-byte symbols
+    std::vector<std::string> symbols;
+    symbols.reserve(word.size());
+    for (unsigned char c : word) {
+        symbols.push_back(byte_encoder_[c]);
+    }
+
+    if (symbols.empty()) {
+        return;
+    }
+
+    // Merge loop: repeatedly merge the lowest-ranked adjacent pair
+    while (symbols.size() > 1) {
+        uint32_t best_rank = std::numeric_limits<uint32_t>::max();
+        size_t best_index = 0;
+
+        for (size_t i = 0; i + 1 < symbols.size(); ++i) {
+            uint32_t rank = pairRank(symbols[i], symbols[i + 1]);
+            if (rank < best_rank) {
+                best_rank = rank;
+                best_index = i;
+            }
+        }
+
+        if (best_rank == std::numeric_limits<uint32_t>::max()) {
+            break; // No more applicable merges
+        }
+
+        symbols[best_index] += symbols[best_index + 1];
+        symbols.erase(symbols.begin() + static_cast<long>(best_index) + 1);
+    }
+
+    // Map merged symbols to token ids (per-byte fallback for unknowns)
+    for (const std::string& symbol : symbols) {
+        uint32_t id = lookupToken(symbol);
+        if (id != std::numeric_limits<uint32_t>::max()) {
+            output.push_back(id);
+            continue;
+        }
+
+        // Fallback: emit each byte's single-symbol token if present
+        size_t i = 0;
+        while (i < symbol.size()) {
+            unsigned char c = static_cast<unsigned char>(symbol[i]);
+            size_t char_len = 1;
+            if ((c & 0xE0) == 0xC0) char_len = 2;
+            else if ((c & 0xF0) == 0xE0) char_len = 3;
+            else if ((c & 0xF8) == 0xF0) char_len = 4;
+            char_len = std::min(char_len, symbol.size() - i);
+
+            uint32_t byte_id = lookupToken(symbol.substr(i, char_len));
+            if (byte_id != std::numeric_limits<uint32_t>::max()) {
+                output.push_back(byte_id);
+            }
+            i += char_len;
+        }
+    }
+}
+
+std::vector<uint32_t> BpeEngine::encode(const std::string& text) const {
+    std::vector<uint32_t> tokens;
+
+    if (!loaded_ || text.empty()) {
+        return tokens;
+    }
+
+    tokens.reserve(text.size() / 3); // ~3 bytes per token heuristic
+
+    for (const std::string& word : preTokenize(text)) {
+        bpeWord(word, tokens);
+    }
+
+    return tokens;
+}
+
+const std::string& BpeEngine::decodeToken(uint32_t token_id) const {
+    static const std::string empty;
+    if (token_id >= id_to_bytes_.size()) {
+        return empty;
+    }
+    return id_to_bytes_[token_id];
+}
+
+} // namespace krserve
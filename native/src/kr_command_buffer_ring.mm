@@ -1,26 +1,47 @@
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
 #include "../include/kr_command_buffer_ring.h"
-#include <vector>
+#include "../include/kr_trace_ring.h"
+#include <memory>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
+#include <thread>
 #include <chrono>
 #include <iostream>
 #include <algorithm>
-#include <numeric>
 
 namespace krserve {
 
+namespace {
+
+// Slot lifecycle: FREE -> IN_USE (CPU encoding) -> IN_FLIGHT (GPU) -> FREE
+constexpr uint32_t SLOT_FREE = 0;
+constexpr uint32_t SLOT_IN_USE = 1;
+constexpr uint32_t SLOT_IN_FLIGHT = 2;
+
+// Spin iterations before yielding the CPU in the acquire loop
+constexpr uint32_t SPIN_BUDGET = 256;
+
+// Adaptive sizing: acquisitions per evaluation window, and the wait
+// fraction (1/8 of the window) that triggers a growth step
+constexpr uint64_t RESIZE_WINDOW = 64;
+constexpr uint64_t GROW_WAIT_DIVISOR = 8;
+
+} // anonymous namespace
+
 /**
  * Buffer slot in the ring
  *
- * Tracks individual command buffer state and completion.
+ * State transitions are driven entirely by atomics: acquireBuffer() claims
+ * a slot with a FREE -> IN_USE CAS, releaseBuffer() moves it to IN_FLIGHT,
+ * and the Metal completion handler publishes it back to FREE. No mutex is
+ * taken anywhere on the per-token acquire/release path.
  */
 struct BufferSlot {
-    id<MTLCommandBuffer> buffer;  // Metal command buffer
-    bool in_use;                  // Is buffer currently in-flight?
-    uint64_t fence_value;         // Monotonic fence for completion tracking
+    id<MTLCommandBuffer> buffer = nil;   // Valid only while IN_USE/IN_FLIGHT
+    std::atomic<uint32_t> state{SLOT_FREE};
+    std::atomic<uint32_t> lane{0};       // Lane holding the slot (while non-FREE)
+    std::atomic<uint64_t> fence_value{0};
     std::chrono::steady_clock::time_point acquire_time;  // When buffer was acquired
     std::chrono::steady_clock::time_point release_time;  // When buffer was released
 };
@@ -29,13 +50,15 @@ struct BufferSlot {
  * Implementation class using Pimpl idiom
  *
  * Encapsulates Objective-C++ Metal objects from C++ header.
- * Provides thread-safe ring buffer with automatic rotation.
+ * Provides a lock-free ring: atomic slot states with completion flags set
+ * from the Metal completion handler, and a spin-then-yield acquire path so
+ * per-token submission cost no longer scales with stream count.
  */
 class CommandBufferRing::Impl {
 public:
     explicit Impl(const Config& config)
         : config_(config)
-        , current_index_(0)
+        , next_index_(0)
         , fence_value_(0)
         , total_acquired_(0)
         , total_released_(0)
@@ -61,30 +84,27 @@ public:
         // Validate configuration
         validateConfig();
 
-        // Pre-allocate ring buffer slots
-        ring_.reserve(config_.ring_size);
-
-        for (size_t i = 0; i < config_.ring_size; ++i) {
-            BufferSlot slot;
-            slot.buffer = nil;  // Will be created on-demand
-            slot.in_use = false;
-            slot.fence_value = 0;
-            ring_.push_back(slot);
-        }
+        // Pre-allocate slots up to the growth ceiling so adaptive resizing
+        // never allocates on the hot path; only [0, active_size_) rotate
+        capacity_ = config_.adaptive_sizing
+            ? std::max(config_.max_ring_size, config_.ring_size)
+            : config_.ring_size;
+        ring_ = std::make_unique<BufferSlot[]>(capacity_);
+        active_size_.store(config_.ring_size, std::memory_order_relaxed);
 
         std::cerr << "[CommandBufferRing] Initialized: "
                   << config_.ring_size << " buffers ("
                   << (config_.ring_size == 2 ? "double" : "triple")
-                  << " buffering)"
-                  << std::endl;
+                  << " buffering, lock-free"
+                  << (config_.adaptive_sizing
+                      ? ", adaptive up to " + std::to_string(capacity_) : "")
+                  << ")" << std::endl;
     }
 
     ~Impl() {
         // Wait for all in-flight buffers
         waitAll();
 
-        std::lock_guard<std::mutex> lock(mutex_);
-
         // Log final statistics
         if (config_.track_statistics) {
             const uint64_t acquired = total_acquired_.load(std::memory_order_relaxed);
@@ -103,106 +123,100 @@ public:
             }
         }
 
-        // Release all buffers (ARC will handle cleanup)
-        ring_.clear();
+        ring_.reset();
         queue_ = nil;
         device_ = nil;
     }
 
-    void* acquireBuffer() {
-        auto acquire_start = std::chrono::steady_clock::now();
-
-        std::unique_lock<std::mutex> lock(mutex_);
-
-        // Wait for available buffer
-        bool buffer_available = false;
-        if (config_.timeout_ms > 0) {
-            // Wait with timeout
-            auto timeout = std::chrono::milliseconds(config_.timeout_ms);
-            buffer_available = cv_.wait_for(lock, timeout, [this] {
-                return hasAvailableBuffer();
-            });
-
-            if (!buffer_available) {
-                timeout_events_.fetch_add(1, std::memory_order_relaxed);
-                throw std::runtime_error("CommandBufferRing: timeout waiting for available buffer");
-            }
-        } else {
-            // Wait indefinitely
-            cv_.wait(lock, [this] {
-                return hasAvailableBuffer();
-            });
-            buffer_available = true;
-        }
-
-        // Track wait time if we had to wait
-        if (!hasAvailableBuffer_nolock()) {
-            auto wait_end = std::chrono::steady_clock::now();
-            auto wait_duration = std::chrono::duration_cast<std::chrono::microseconds>(
-                wait_end - acquire_start
-            ).count();
-
-            wait_events_.fetch_add(1, std::memory_order_relaxed);
-            total_wait_time_us_.fetch_add(wait_duration, std::memory_order_relaxed);
-
-            uint64_t current_max = max_wait_time_us_.load(std::memory_order_relaxed);
-            while (wait_duration > current_max &&
-                   !max_wait_time_us_.compare_exchange_weak(current_max, wait_duration)) {
-                // Loop until we successfully update max
-            }
-
-            if (config_.log_wait_events) {
-                std::cerr << "[CommandBufferRing] Waited " << wait_duration
-                          << " μs for buffer availability"
-                          << std::endl;
+    void* acquireBuffer(CommandBufferRing::Lane lane) {
+        const auto acquire_start = std::chrono::steady_clock::now();
+        TraceSpan trace("ring_acquire", "ring", 0);
+
+        uint32_t spins = 0;
+        bool waited = false;
+        bool throttled = false;
+
+        while (true) {
+            const size_t active = active_size_.load(std::memory_order_relaxed);
+
+            // Prefill lane budget: leave decode_reserved_slots for decode.
+            // The counter check is advisory (claim below is what's atomic),
+            // which is fine — an off-by-one under a race costs one slot for
+            // one rotation, not correctness.
+            if (lane == CommandBufferRing::Lane::Prefill) {
+                const size_t budget = (active > config_.decode_reserved_slots)
+                    ? active - config_.decode_reserved_slots : 1;
+                if (prefill_active_.load(std::memory_order_relaxed) >= budget) {
+                    if (!throttled) {
+                        throttled = true;
+                        prefill_throttles_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    waited = true;
+                    spinOrTimeout(acquire_start, spins);
+                    continue;
+                }
             }
-        }
 
-        // Find next available buffer (round-robin)
-        size_t start_index = current_index_;
-        size_t attempts = 0;
-
-        while (attempts < ring_.size()) {
-            BufferSlot& slot = ring_[current_index_];
-
-            if (!slot.in_use) {
-                // Found available buffer!
+            // Scan the ring once, starting from the shared rotation cursor
+            for (size_t attempt = 0; attempt < active; ++attempt) {
+                const size_t index = next_index_.fetch_add(1, std::memory_order_relaxed)
+                                     % active;
+                BufferSlot& slot = ring_[index];
+
+                uint32_t expected = SLOT_FREE;
+                if (!slot.state.compare_exchange_strong(
+                        expected, SLOT_IN_USE,
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                    continue;
+                }
 
-                // Create buffer if needed (lazy allocation)
-                if (slot.buffer == nil) {
-                    slot.buffer = [queue_ commandBuffer];
-                    if (!slot.buffer) {
-                        throw std::runtime_error("Failed to create Metal command buffer");
-                    }
+                // Slot claimed — we are its exclusive owner until release.
+                // Command buffers are single-use after commit, so create a
+                // fresh one per acquisition.
+                slot.buffer = [queue_ commandBuffer];
+                if (!slot.buffer) {
+                    slot.state.store(SLOT_FREE, std::memory_order_release);
+                    throw std::runtime_error("Failed to create Metal command buffer");
                 }
 
-                // Mark as in-use
-                slot.in_use = true;
-                slot.fence_value = ++fence_value_;
+                const uint64_t fence = fence_value_.fetch_add(1, std::memory_order_relaxed) + 1;
+                slot.fence_value.store(fence, std::memory_order_relaxed);
                 slot.acquire_time = std::chrono::steady_clock::now();
+                slot.lane.store(static_cast<uint32_t>(lane), std::memory_order_relaxed);
+                TraceRing::instance().instant("ring_slot_claimed", "ring", fence);
+
+                if (lane == CommandBufferRing::Lane::Prefill) {
+                    prefill_active_.fetch_add(1, std::memory_order_relaxed);
+                    prefill_acquired_.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    decode_acquired_.fetch_add(1, std::memory_order_relaxed);
+                }
 
-                // Advance index for next acquisition (round-robin)
-                size_t acquired_index = current_index_;
-                current_index_ = (current_index_ + 1) % ring_.size();
-
-                // Track rotation if we wrapped around
-                if (current_index_ < acquired_index) {
+                // Track rotation when the cursor wraps past slot 0
+                if (index == 0) {
                     rotations_.fetch_add(1, std::memory_order_relaxed);
                 }
 
                 total_acquired_.fetch_add(1, std::memory_order_relaxed);
 
+                if (waited && config_.track_statistics) {
+                    recordWait(acquire_start);
+                }
+
+                if (config_.adaptive_sizing) {
+                    recordResizeSample(waited);
+                }
+
                 // Return buffer (bridge_retained so caller can use it)
                 return (__bridge_retained void*)slot.buffer;
             }
 
-            // Try next slot
-            current_index_ = (current_index_ + 1) % ring_.size();
-            ++attempts;
+            // All slots busy: spin briefly, then yield to let completion
+            // handlers run. No condition variable — the completion handler
+            // only flips an atomic, so wakeup is just the next scan.
+            waited = true;
+            spinOrTimeout(acquire_start, spins);
         }
-
-        // Should never reach here (wait condition guarantees available buffer)
-        throw std::runtime_error("CommandBufferRing: internal error - no buffer available after wait");
     }
 
     void releaseBuffer(void* buffer_ptr) {
@@ -213,13 +227,12 @@ public:
         // Convert void* back to id<MTLCommandBuffer>
         id<MTLCommandBuffer> buffer = (__bridge_transfer id<MTLCommandBuffer>)buffer_ptr;
 
-        std::unique_lock<std::mutex> lock(mutex_);
-
-        // Find buffer in ring
+        // Find the owning slot (IN_USE + matching buffer; ring stays small)
         BufferSlot* slot = nullptr;
-        for (auto& s : ring_) {
-            if (s.buffer == buffer) {
-                slot = &s;
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ring_[i].state.load(std::memory_order_acquire) == SLOT_IN_USE &&
+                ring_[i].buffer == buffer) {
+                slot = &ring_[i];
                 break;
             }
         }
@@ -231,64 +244,62 @@ public:
         }
 
         slot->release_time = std::chrono::steady_clock::now();
+        slot->state.store(SLOT_IN_FLIGHT, std::memory_order_release);
 
-        // Register completion handler (called when GPU finishes)
-        __block CommandBufferRing::Impl* impl_ptr = this;
-        __block BufferSlot* slot_ptr = slot;
-
+        // Completion handler flips the slot back to FREE — a single atomic
+        // store, no lock, no wakeup machinery. Acquirers observe it on
+        // their next scan.
+        BufferSlot* slot_ptr = slot;
         [buffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull completedBuffer) {
-            // Completion handler executes on Metal's internal thread
-            std::unique_lock<std::mutex> completion_lock(impl_ptr->mutex_);
-
-            // Mark buffer as available
-            slot_ptr->in_use = false;
-
-            // Notify waiting threads
-            impl_ptr->cv_.notify_one();
+            slot_ptr->buffer = nil;
+            if (slot_ptr->lane.load(std::memory_order_relaxed) ==
+                static_cast<uint32_t>(CommandBufferRing::Lane::Prefill)) {
+                this->prefill_active_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            slot_ptr->state.store(SLOT_FREE, std::memory_order_release);
         }];
 
         // Commit buffer to GPU
         [buffer commit];
 
         total_released_.fetch_add(1, std::memory_order_relaxed);
-
-        // Unlock before notify to avoid waking threads that immediately re-lock
-        lock.unlock();
     }
 
     void waitAll() {
-        std::unique_lock<std::mutex> lock(mutex_);
-
-        // Wait until all buffers are available
-        cv_.wait(lock, [this] {
-            for (const auto& slot : ring_) {
-                if (slot.in_use) {
-                    return false;
+        // Spin-then-sleep until every slot has drained back to FREE
+        while (true) {
+            bool all_free = true;
+            for (size_t i = 0; i < capacity_; ++i) {
+                if (ring_[i].state.load(std::memory_order_acquire) != SLOT_FREE) {
+                    all_free = false;
+                    break;
                 }
             }
-            return true;
-        });
+            if (all_free) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
 
         std::cerr << "[CommandBufferRing] All buffers completed" << std::endl;
     }
 
     CommandBufferRing::Statistics getStatistics() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-
         const uint64_t acquired = total_acquired_.load(std::memory_order_relaxed);
         const uint64_t released = total_released_.load(std::memory_order_relaxed);
         const uint64_t waits = wait_events_.load(std::memory_order_relaxed);
         const uint64_t total_wait = total_wait_time_us_.load(std::memory_order_relaxed);
         const uint64_t rots = rotations_.load(std::memory_order_relaxed);
 
-        // Count available vs in-flight buffers
+        // Count available vs in-flight buffers (over the active window)
+        const size_t active = active_size_.load(std::memory_order_relaxed);
         size_t available_count = 0;
         size_t in_flight_count = 0;
-        for (const auto& slot : ring_) {
-            if (slot.in_use) {
-                ++in_flight_count;
-            } else {
+        for (size_t i = 0; i < active; ++i) {
+            if (ring_[i].state.load(std::memory_order_relaxed) == SLOT_FREE) {
                 ++available_count;
+            } else {
+                ++in_flight_count;
             }
         }
 
@@ -297,7 +308,7 @@ public:
 
         // Calculate buffer utilization (% of time buffers are in use)
         double utilization = (acquired > 0)
-            ? (in_flight_count / static_cast<double>(ring_.size())) * 100.0
+            ? (in_flight_count / static_cast<double>(active)) * 100.0
             : 0.0;
 
         // Calculate rotation rate (rotations per second)
@@ -308,8 +319,10 @@ public:
         // Calculate submission overhead (time between acquire and release)
         double avg_submission_overhead = 0.0;
         size_t completed_buffers = 0;
-        for (const auto& slot : ring_) {
-            if (!slot.in_use && slot.fence_value > 0) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            const BufferSlot& slot = ring_[i];
+            if (slot.state.load(std::memory_order_relaxed) == SLOT_FREE &&
+                slot.fence_value.load(std::memory_order_relaxed) > 0) {
                 auto overhead = std::chrono::duration_cast<std::chrono::microseconds>(
                     slot.release_time - slot.acquire_time
                 ).count();
@@ -322,7 +335,7 @@ public:
         }
 
         return {
-            .ring_size = ring_.size(),
+            .ring_size = config_.ring_size,
             .available_count = available_count,
             .in_flight_count = in_flight_count,
             .total_acquired = acquired,
@@ -334,12 +347,17 @@ public:
             .buffer_utilization = utilization,
             .submission_overhead_us = avg_submission_overhead,
             .rotations = rots,
-            .rotation_rate = rotation_rate
+            .rotation_rate = rotation_rate,
+            .active_ring_size = active,
+            .grow_events = grow_events_.load(std::memory_order_relaxed),
+            .shrink_events = shrink_events_.load(std::memory_order_relaxed),
+            .decode_acquired = decode_acquired_.load(std::memory_order_relaxed),
+            .prefill_acquired = prefill_acquired_.load(std::memory_order_relaxed),
+            .prefill_throttles = prefill_throttles_.load(std::memory_order_relaxed)
         };
     }
 
     void resetStatistics() {
-        std::lock_guard<std::mutex> lock(mutex_);
         total_acquired_.store(0, std::memory_order_relaxed);
         total_released_.store(0, std::memory_order_relaxed);
         wait_events_.store(0, std::memory_order_relaxed);
@@ -347,6 +365,11 @@ public:
         rotations_.store(0, std::memory_order_relaxed);
         total_wait_time_us_.store(0, std::memory_order_relaxed);
         max_wait_time_us_.store(0, std::memory_order_relaxed);
+        grow_events_.store(0, std::memory_order_relaxed);
+        shrink_events_.store(0, std::memory_order_relaxed);
+        decode_acquired_.store(0, std::memory_order_relaxed);
+        prefill_acquired_.store(0, std::memory_order_relaxed);
+        prefill_throttles_.store(0, std::memory_order_relaxed);
         start_time_ = std::chrono::steady_clock::now();
     }
 
@@ -358,16 +381,26 @@ private:
     id<MTLDevice> device_;
     id<MTLCommandQueue> queue_;
 
-    // Ring buffer
-    std::vector<BufferSlot> ring_;
-    size_t current_index_;  // Current position in ring (round-robin)
-    uint64_t fence_value_;  // Monotonic counter for completion tracking
-
-    // Thread safety
-    mutable std::mutex mutex_;
-    std::condition_variable cv_;
-
-    // Statistics (atomic for lock-free reads in some cases)
+    // Ring buffer (pre-allocated to capacity_; active_size_ slots rotate)
+    std::unique_ptr<BufferSlot[]> ring_;
+    size_t capacity_ = 0;
+    std::atomic<size_t> active_size_{0};
+    std::atomic<size_t> next_index_;   // Shared rotation cursor (round-robin)
+    std::atomic<uint64_t> fence_value_; // Monotonic counter for completion tracking
+
+    // Lane accounting
+    std::atomic<size_t> prefill_active_{0};
+    std::atomic<uint64_t> decode_acquired_{0};
+    std::atomic<uint64_t> prefill_acquired_{0};
+    std::atomic<uint64_t> prefill_throttles_{0};
+
+    // Adaptive sizing window
+    std::atomic<uint64_t> window_acquires_{0};
+    std::atomic<uint64_t> window_waits_{0};
+    std::atomic<uint64_t> grow_events_{0};
+    std::atomic<uint64_t> shrink_events_{0};
+
+    // Statistics (all lock-free)
     std::atomic<uint64_t> total_acquired_;
     std::atomic<uint64_t> total_released_;
     std::atomic<uint64_t> wait_events_;
@@ -385,8 +418,20 @@ private:
         if (config_.ring_size < 2) {
             throw std::invalid_argument("ring_size must be >= 2 (double buffering)");
         }
-        if (config_.ring_size > 3) {
-            throw std::invalid_argument("ring_size must be <= 3 (triple buffering)");
+        if (config_.ring_size > 32) {
+            throw std::invalid_argument("ring_size must be <= 32");
+        }
+        if (config_.adaptive_sizing) {
+            if (config_.max_ring_size < config_.ring_size) {
+                throw std::invalid_argument("max_ring_size must be >= ring_size");
+            }
+            if (config_.max_ring_size > 32) {
+                throw std::invalid_argument("max_ring_size must be <= 32");
+            }
+        }
+        if (config_.decode_reserved_slots >= config_.ring_size) {
+            throw std::invalid_argument(
+                "decode_reserved_slots must be < ring_size");
         }
 
         std::cerr << "[CommandBufferRing] Configuration:\n"
@@ -397,25 +442,84 @@ private:
     }
 
     /**
-     * Check if any buffer is available (thread-safe)
-     * @return true if at least one buffer is available
+     * Spin-then-yield backoff shared by the busy paths; throws on timeout
+     * @return true after backing off (callers just rescan)
+     */
+    bool spinOrTimeout(std::chrono::steady_clock::time_point acquire_start,
+                       uint32_t& spins) {
+        if (config_.timeout_ms > 0) {
+            const auto elapsed = std::chrono::steady_clock::now() - acquire_start;
+            if (elapsed >= std::chrono::milliseconds(config_.timeout_ms)) {
+                timeout_events_.fetch_add(1, std::memory_order_relaxed);
+                throw std::runtime_error(
+                    "CommandBufferRing: timeout waiting for available buffer");
+            }
+        }
+
+        if (++spins < SPIN_BUDGET) {
+            // Busy-spin: completion latency is typically microseconds
+        } else {
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    /**
+     * Feed one acquisition into the adaptive-sizing window
+     *
+     * Every RESIZE_WINDOW acquisitions: grow one slot if more than 1/8 of
+     * them waited (prefill burst), shrink one slot back toward the
+     * configured floor if none did (idle decode). Counters are relaxed —
+     * a raced window costs one deferred resize step, nothing more.
      */
-    bool hasAvailableBuffer() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return hasAvailableBuffer_nolock();
+    void recordResizeSample(bool waited) {
+        if (waited) {
+            window_waits_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const uint64_t acquires =
+            window_acquires_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (acquires < RESIZE_WINDOW) {
+            return;
+        }
+
+        window_acquires_.store(0, std::memory_order_relaxed);
+        const uint64_t waits = window_waits_.exchange(0, std::memory_order_relaxed);
+
+        const size_t active = active_size_.load(std::memory_order_relaxed);
+        if (waits > RESIZE_WINDOW / GROW_WAIT_DIVISOR && active < capacity_) {
+            active_size_.store(active + 1, std::memory_order_relaxed);
+            grow_events_.fetch_add(1, std::memory_order_relaxed);
+        } else if (waits == 0 && active > config_.ring_size) {
+            // Shrunk-out slots may still be in flight; they simply drain
+            // and stop rotating
+            active_size_.store(active - 1, std::memory_order_relaxed);
+            shrink_events_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     /**
-     * Check if any buffer is available (caller must hold mutex)
-     * @return true if at least one buffer is available
+     * Record a contended acquisition in the wait statistics
      */
-    bool hasAvailableBuffer_nolock() const {
-        for (const auto& slot : ring_) {
-            if (!slot.in_use) {
-                return true;
-            }
+    void recordWait(std::chrono::steady_clock::time_point acquire_start) {
+        const auto wait_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - acquire_start
+        ).count();
+
+        wait_events_.fetch_add(1, std::memory_order_relaxed);
+        total_wait_time_us_.fetch_add(wait_duration, std::memory_order_relaxed);
+
+        uint64_t current_max = max_wait_time_us_.load(std::memory_order_relaxed);
+        while (static_cast<uint64_t>(wait_duration) > current_max &&
+               !max_wait_time_us_.compare_exchange_weak(current_max, wait_duration)) {
+            // Loop until we successfully update max
+        }
+
+        if (config_.log_wait_events) {
+            std::cerr << "[CommandBufferRing] Waited " << wait_duration
+                      << " μs for buffer availability"
+                      << std::endl;
         }
-        return false;
     }
 };
 
@@ -431,7 +535,11 @@ CommandBufferRing::CommandBufferRing(const Config& config)
 CommandBufferRing::~CommandBufferRing() = default;
 
 void* CommandBufferRing::acquireBuffer() {
-    return impl_->acquireBuffer();
+    return impl_->acquireBuffer(Lane::Decode);
+}
+
+void* CommandBufferRing::acquireBuffer(Lane lane) {
+    return impl_->acquireBuffer(lane);
 }
 
 void CommandBufferRing::releaseBuffer(void* buffer) {
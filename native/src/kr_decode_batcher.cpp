@@ -0,0 +1,223 @@
+#include "kr_decode_batcher.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace krserve {
+
+// ============================================================================
+// Construction / Validation
+// ============================================================================
+
+DecodeBatcher::DecodeBatcher(const Config& config,
+                             CommandBufferRing* ring,
+                             BlitQueue* blit)
+    : config_(config)
+    , ring_(ring)
+    , blit_(blit) {
+    validateConfig();
+    streams_.reserve(config_.max_streams);
+
+    std::cerr << "[DecodeBatcher] Initialized (max_streams="
+              << config_.max_streams << ")" << std::endl;
+}
+
+DecodeBatcher::~DecodeBatcher() = default;
+
+void DecodeBatcher::validateConfig() const {
+    if (ring_ == nullptr) {
+        throw std::invalid_argument("DecodeBatcher requires a CommandBufferRing");
+    }
+    if (blit_ == nullptr) {
+        throw std::invalid_argument("DecodeBatcher requires a BlitQueue");
+    }
+    if (config_.max_streams == 0) {
+        throw std::invalid_argument("max_streams must be > 0");
+    }
+}
+
+// ============================================================================
+// Stream Registration
+// ============================================================================
+
+void DecodeBatcher::registerStream(const DecodeStreamSlot& slot) {
+    if (slot.upload_src != nullptr) {
+        if (slot.upload_bytes == 0 || slot.upload_dst == nullptr) {
+            throw std::invalid_argument(
+                "upload_src requires upload_bytes > 0 and upload_dst");
+        }
+    }
+    if (slot.download_src != nullptr && slot.download_bytes == 0) {
+        throw std::invalid_argument("download_src requires download_bytes > 0");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (streams_.size() >= config_.max_streams) {
+        throw std::invalid_argument(
+            "stream limit reached (max_streams=" +
+            std::to_string(config_.max_streams) + ")");
+    }
+    for (const auto& entry : streams_) {
+        if (entry.slot.stream_id == slot.stream_id) {
+            throw std::invalid_argument(
+                "stream " + std::to_string(slot.stream_id) +
+                " is already registered");
+        }
+    }
+
+    StreamEntry entry;
+    entry.slot = slot;
+    if (slot.download_src != nullptr) {
+        entry.staging = std::make_unique<uint8_t[]>(slot.download_bytes);
+    }
+    streams_.push_back(std::move(entry));
+}
+
+bool DecodeBatcher::unregisterStream(uint64_t stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = std::find_if(streams_.begin(), streams_.end(),
+                           [stream_id](const StreamEntry& entry) {
+                               return entry.slot.stream_id == stream_id;
+                           });
+    if (it == streams_.end()) {
+        return false;
+    }
+    streams_.erase(it);
+    return true;
+}
+
+size_t DecodeBatcher::streamCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.size();
+}
+
+// ============================================================================
+// Step Submission
+// ============================================================================
+
+DecodeStepResult DecodeBatcher::submitDecodeStep(const EncodeHook& encode_compute) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (streams_.empty()) {
+        throw std::runtime_error("submitDecodeStep() with no registered streams");
+    }
+
+    DecodeStepResult result;
+
+    // Phase 1: coalesce every stream's upload into one blit batch. One
+    // commit and one shared-event signal regardless of stream count.
+    std::vector<BlitQueue::UploadRegion> regions;
+    regions.reserve(streams_.size());
+    for (const auto& entry : streams_) {
+        if (entry.slot.upload_src == nullptr) continue;
+        BlitQueue::UploadRegion region;
+        region.source_data = entry.slot.upload_src;
+        region.source_size = entry.slot.upload_bytes;
+        region.dest_buffer = entry.slot.upload_dst;
+        region.dest_offset = entry.slot.upload_dst_offset;
+        regions.push_back(region);
+    }
+
+    BlitQueue::EventHandle upload_done;
+    if (!regions.empty()) {
+        result.upload_op = blit_->uploadBatchAsync(regions);
+        upload_done = blit_->getEventHandle(result.upload_op);
+    }
+
+    // Phase 2: one decode-lane command buffer for the whole step. The
+    // wait defers the shared compute until the upload batch lands — on
+    // the GPU timeline, not with a CPU stall.
+    void* cmd = ring_->acquireBuffer(CommandBufferRing::Lane::Decode);
+    if (upload_done.isValid()) {
+        BlitQueue::encodeWait(cmd, upload_done);
+    }
+
+    if (encode_compute) {
+        encode_compute(cmd);
+    }
+
+    // Phase 3: signal after the compute, then hand the buffer back to
+    // the ring — releaseBuffer() commits it, the step's single
+    // submission.
+    result.compute_done = blit_->nextSignalHandle();
+    if (result.compute_done.isValid()) {
+        BlitQueue::encodeSignal(cmd, result.compute_done);
+    }
+    ring_->releaseBuffer(cmd);
+
+    // Phase 4: fan results back out. Each download chains on the compute
+    // signal and lands in the stream's stable staging slot.
+    result.readbacks.reserve(streams_.size());
+    uint64_t downloads = 0;
+    for (auto& entry : streams_) {
+        DecodeStreamReadback readback;
+        readback.stream_id = entry.slot.stream_id;
+        if (entry.slot.download_src != nullptr && result.compute_done.isValid()) {
+            readback.op_id = blit_->downloadAsyncAfter(
+                result.compute_done,
+                entry.slot.download_src,
+                entry.slot.download_offset,
+                entry.staging.get(),
+                entry.slot.download_bytes);
+            readback.data = entry.staging.get();
+            readback.bytes = entry.slot.download_bytes;
+            downloads++;
+        }
+        result.readbacks.push_back(readback);
+    }
+
+    if (config_.enable_stats) {
+        steps_submitted_.fetch_add(1, std::memory_order_relaxed);
+        streams_submitted_.fetch_add(streams_.size(), std::memory_order_relaxed);
+        uploads_coalesced_.fetch_add(regions.size(), std::memory_order_relaxed);
+        downloads_issued_.fetch_add(downloads, std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+bool DecodeBatcher::waitForStep(const DecodeStepResult& step, uint32_t timeout_ms) {
+    // Downloads chain on the compute signal, so waiting on them covers
+    // the upload and compute phases too; an upload-only step falls back
+    // to waiting on the upload batch itself.
+    bool all_completed = true;
+    bool waited = false;
+    for (const auto& readback : step.readbacks) {
+        if (readback.op_id == 0) continue;
+        waited = true;
+        if (!blit_->waitForCompletion(readback.op_id, timeout_ms)) {
+            all_completed = false;
+        }
+    }
+    if (!waited && step.upload_op != 0) {
+        all_completed = blit_->waitForCompletion(step.upload_op, timeout_ms);
+    }
+    return all_completed;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+DecodeBatcher::Statistics DecodeBatcher::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Statistics{
+        .steps_submitted = steps_submitted_.load(std::memory_order_relaxed),
+        .streams_submitted = streams_submitted_.load(std::memory_order_relaxed),
+        .uploads_coalesced = uploads_coalesced_.load(std::memory_order_relaxed),
+        .downloads_issued = downloads_issued_.load(std::memory_order_relaxed),
+        .streams_registered = streams_.size(),
+    };
+}
+
+void DecodeBatcher::resetStatistics() {
+    steps_submitted_.store(0, std::memory_order_relaxed);
+    streams_submitted_.store(0, std::memory_order_relaxed);
+    uploads_coalesced_.store(0, std::memory_order_relaxed);
+    downloads_issued_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace krserve
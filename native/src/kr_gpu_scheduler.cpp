@@ -0,0 +1,277 @@
+#include "kr_gpu_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace krserve {
+
+namespace {
+
+uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+GpuScheduler::GpuScheduler(const Config& config, KVBlockPool* kv_pool)
+    : config_(config), kv_pool_(kv_pool) {
+    validateConfig();
+
+    workers_.reserve(config_.num_workers);
+    for (uint32_t i = 0; i < config_.num_workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    std::cerr << "[GpuScheduler] Created: " << config_.num_workers
+              << " workers, max_batch_size=" << config_.max_batch_size
+              << ", admission_reserve_blocks=" << config_.admission_reserve_blocks
+              << (kv_pool_ ? "" : " (admission control disabled: no KV pool)")
+              << std::endl;
+}
+
+GpuScheduler::~GpuScheduler() = default;
+
+void GpuScheduler::validateConfig() const {
+    if (config_.num_workers == 0) {
+        throw std::invalid_argument("num_workers must be > 0");
+    }
+    if (config_.max_batch_size == 0) {
+        throw std::invalid_argument("max_batch_size must be > 0");
+    }
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+void GpuScheduler::submit(const Request& request) {
+    if (request.priority >= NUM_PRIORITIES) {
+        throw std::invalid_argument("priority must be 0 (urgent), 1 (default), or 2 (low)");
+    }
+
+    QueuedRequest queued;
+    queued.request = request;
+    queued.enqueue_time_us = nowMicros();
+
+    size_t worker_idx =
+        next_submit_worker_.fetch_add(1, std::memory_order_relaxed) %
+        workers_.size();
+    Worker& worker = *workers_[worker_idx];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[request.priority].push_back(std::move(queued));
+    }
+
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    if (config_.enable_stats) {
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Batch composition
+// ============================================================================
+
+uint32_t GpuScheduler::availableBlocks() const {
+    if (!kv_pool_) {
+        return UINT32_MAX;  // No pool: admission is unconstrained
+    }
+    auto stats = kv_pool_->getStatistics();
+    uint32_t max_blocks = kv_pool_->getConfig().max_blocks;
+    if (stats.blocks_in_use >= max_blocks) {
+        return 0;
+    }
+    return max_blocks - static_cast<uint32_t>(stats.blocks_in_use);
+}
+
+bool GpuScheduler::popHighestPriority(QueuedRequest& out) {
+    // Scan priorities high to low; within a priority take the oldest
+    // submission across all worker deques (FIFO fairness survives the
+    // round-robin spread)
+    for (uint32_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        Worker* best_worker = nullptr;
+        uint64_t best_time = UINT64_MAX;
+
+        for (auto& worker_ptr : workers_) {
+            Worker& worker = *worker_ptr;
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (!queue.empty() && queue.front().enqueue_time_us < best_time) {
+                best_time = queue.front().enqueue_time_us;
+                best_worker = &worker;
+            }
+        }
+
+        if (best_worker) {
+            std::lock_guard<std::mutex> lock(best_worker->mutex);
+            auto& queue = best_worker->queues[priority];
+            if (!queue.empty()) {
+                out = std::move(queue.front());
+                queue.pop_front();
+                return true;
+            }
+            // Raced with a worker pop; rescan this priority
+            --priority;
+        }
+    }
+    return false;
+}
+
+std::vector<uint64_t> GpuScheduler::composeBatch() {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+
+    // Admit while the batch has room and KV pages cover the request plus
+    // the reserve. Stop at the first request that doesn't fit: admitting
+    // a smaller later request instead would starve the blocked one.
+    while (active_order_.size() < config_.max_batch_size) {
+        QueuedRequest queued;
+        if (!popHighestPriority(queued)) {
+            break;
+        }
+
+        uint32_t available = availableBlocks();
+        uint32_t needed = queued.request.blocks_needed + config_.admission_reserve_blocks;
+        if (available < needed) {
+            // Put it back at the front of its priority on worker 0 so it
+            // stays head of line for the next step
+            {
+                Worker& worker = *workers_[0];
+                std::lock_guard<std::mutex> worker_lock(worker.mutex);
+                worker.queues[queued.request.priority].push_front(std::move(queued));
+            }
+            if (config_.enable_stats) {
+                admission_deferrals_.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+
+        uint64_t id = queued.request.request_id;
+        active_.insert(id);
+        active_order_.push_back(id);
+        active_blocks_[id] = queued.request.blocks_needed;
+
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        if (config_.enable_stats) {
+            admitted_.fetch_add(1, std::memory_order_relaxed);
+            uint64_t now = nowMicros();
+            if (now > queued.enqueue_time_us) {
+                total_queue_wait_us_.fetch_add(now - queued.enqueue_time_us,
+                                               std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (config_.enable_stats) {
+        batches_composed_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return active_order_;
+}
+
+void GpuScheduler::completeRequest(uint64_t request_id) {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    auto it = active_.find(request_id);
+    if (it == active_.end()) {
+        return;
+    }
+    active_.erase(it);
+    active_blocks_.erase(request_id);
+    active_order_.erase(
+        std::remove(active_order_.begin(), active_order_.end(), request_id),
+        active_order_.end());
+    if (config_.enable_stats) {
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Worker-pool mode (direct pop with stealing)
+// ============================================================================
+
+bool GpuScheduler::popRequest(uint32_t worker_id, Request& request) {
+    if (worker_id >= workers_.size()) {
+        throw std::invalid_argument("worker_id out of range");
+    }
+
+    // Own deques first, highest priority, FIFO from the front
+    {
+        Worker& own = *workers_[worker_id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        for (uint32_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+            auto& queue = own.queues[priority];
+            if (!queue.empty()) {
+                request = queue.front().request;
+                queue.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    // Steal from the back of the other workers' deques (opposite end from
+    // the owner's pops to minimize contention)
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(worker_id + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        for (uint32_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+            auto& queue = victim.queues[priority];
+            if (!queue.empty()) {
+                request = queue.back().request;
+                queue.pop_back();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                if (config_.enable_stats) {
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Introspection
+// ============================================================================
+
+uint32_t GpuScheduler::queuedCount() const {
+    return queued_.load(std::memory_order_relaxed);
+}
+
+uint32_t GpuScheduler::activeCount() const {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    return static_cast<uint32_t>(active_order_.size());
+}
+
+GpuScheduler::Statistics GpuScheduler::getStatistics() const {
+    return Statistics{
+        .submitted = submitted_.load(std::memory_order_relaxed),
+        .admitted = admitted_.load(std::memory_order_relaxed),
+        .completed = completed_.load(std::memory_order_relaxed),
+        .admission_deferrals = admission_deferrals_.load(std::memory_order_relaxed),
+        .steals = steals_.load(std::memory_order_relaxed),
+        .batches_composed = batches_composed_.load(std::memory_order_relaxed),
+        .total_queue_wait_us = total_queue_wait_us_.load(std::memory_order_relaxed),
+        .queued = queued_.load(std::memory_order_relaxed),
+        .active = activeCount(),
+    };
+}
+
+void GpuScheduler::resetStatistics() {
+    submitted_.store(0, std::memory_order_relaxed);
+    admitted_.store(0, std::memory_order_relaxed);
+    completed_.store(0, std::memory_order_relaxed);
+    admission_deferrals_.store(0, std::memory_order_relaxed);
+    steals_.store(0, std::memory_order_relaxed);
+    batches_composed_.store(0, std::memory_order_relaxed);
+    total_queue_wait_us_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace krserve
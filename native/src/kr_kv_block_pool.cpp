@@ -0,0 +1,371 @@
+#include "../include/kr_kv_block_pool.h"
+#include <iostream>
+#include <stdexcept>
+
+namespace krserve {
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+KVBlockPool::KVBlockPool(const Config& config, MetalMemoryPool* memory_pool)
+    : config_(config)
+    , memory_pool_(memory_pool)
+{
+    validateConfig();
+
+    block_bytes_ = static_cast<size_t>(config_.block_size_tokens) *
+                   config_.bytes_per_token;
+
+    blocks_.reserve(config_.max_blocks);
+
+    shards_.reserve(config_.num_shards);
+    for (uint32_t i = 0; i < config_.num_shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+
+    std::cerr << "[KVBlockPool] Initialized: " << config_.max_blocks
+              << " blocks max, " << config_.block_size_tokens
+              << " tokens/block, " << (block_bytes_ / 1024) << " KB/block"
+              << std::endl;
+}
+
+KVBlockPool::~KVBlockPool() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+
+    uint32_t outstanding = blocks_in_use_.load();
+    if (outstanding > 0) {
+        std::cerr << "[KVBlockPool] WARNING: " << outstanding
+                  << " blocks still referenced at destruction" << std::endl;
+    }
+
+    for (auto& block : blocks_) {
+        if (block->buffer) {
+            memory_pool_->releaseBuffer(block->buffer);
+            block->buffer = nullptr;
+        }
+    }
+}
+
+void KVBlockPool::validateConfig() const {
+    if (config_.block_size_tokens == 0) {
+        throw std::invalid_argument("block_size_tokens must be > 0");
+    }
+    if (config_.bytes_per_token == 0) {
+        throw std::invalid_argument("bytes_per_token must be > 0");
+    }
+    if (config_.max_blocks == 0) {
+        throw std::invalid_argument("max_blocks must be > 0");
+    }
+    if (config_.num_shards == 0 ||
+        (config_.num_shards & (config_.num_shards - 1)) != 0) {
+        throw std::invalid_argument("num_shards must be a power of two");
+    }
+    if (!memory_pool_) {
+        throw std::invalid_argument("memory_pool must not be null");
+    }
+}
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+uint64_t KVBlockPool::hashTokens(const uint32_t* tokens, size_t count) {
+    // FNV-1a over token bytes — a cache key, not a cryptographic boundary
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t token = tokens[i];
+        for (int b = 0; b < 4; ++b) {
+            hash ^= (token >> (b * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+    // Reserve 0 as the "unregistered" sentinel
+    return hash == 0 ? 1 : hash;
+}
+
+KVBlockPool::Shard& KVBlockPool::shardFor(uint64_t prefix_hash) {
+    return *shards_[prefix_hash & (config_.num_shards - 1)];
+}
+
+// ============================================================================
+// Allocation / release
+// ============================================================================
+
+std::vector<uint32_t> KVBlockPool::allocateBlocks(uint32_t num_blocks) {
+    std::vector<uint32_t> result;
+    if (num_blocks == 0) {
+        return result;
+    }
+    result.reserve(num_blocks);
+
+    while (result.size() < num_blocks) {
+        uint32_t block_id = UINT32_MAX;
+
+        {
+            std::lock_guard<std::mutex> lock(blocks_mutex_);
+
+            if (!free_list_.empty()) {
+                // Reuse a freed page
+                block_id = free_list_.back();
+                free_list_.pop_back();
+            } else if (blocks_.size() < config_.max_blocks) {
+                // Carve a new page from the backing pool
+                void* buffer = memory_pool_->acquireBuffer(block_bytes_);
+                if (buffer) {
+                    block_id = static_cast<uint32_t>(blocks_.size());
+                    auto block = std::make_unique<Block>();
+                    block->buffer = buffer;
+                    blocks_.push_back(std::move(block));
+                }
+            }
+        }
+
+        if (block_id == UINT32_MAX) {
+            // No free pages: evict a zero-ref cached chain and retry
+            if (!evictOneChain()) {
+                break;
+            }
+            continue;
+        }
+
+        Block& block = *blocks_[block_id];
+        block.refcount.store(1, std::memory_order_relaxed);
+        block.prefix_hash = 0;
+        block.registered = false;
+
+        result.push_back(block_id);
+        blocks_allocated_++;
+        blocks_in_use_++;
+    }
+
+    if (result.size() < num_blocks) {
+        // Pool fully referenced — roll back partial allocation
+        allocation_failures_++;
+        if (config_.enable_stats) {
+            std::cerr << "[KVBlockPool] Allocation failed: needed "
+                      << num_blocks << " blocks, all pages referenced"
+                      << std::endl;
+        }
+        releaseBlocks(result);
+        result.clear();
+    }
+
+    return result;
+}
+
+void KVBlockPool::retainBlocks(const std::vector<uint32_t>& blocks) {
+    for (uint32_t block_id : blocks) {
+        if (block_id >= blocks_.size()) {
+            continue;
+        }
+        uint32_t prev = blocks_[block_id]->refcount.fetch_add(
+            1, std::memory_order_acq_rel);
+        if (prev == 0) {
+            blocks_in_use_++;
+        }
+    }
+}
+
+void KVBlockPool::releaseBlocks(const std::vector<uint32_t>& blocks) {
+    for (uint32_t block_id : blocks) {
+        if (block_id >= blocks_.size()) {
+            continue;
+        }
+
+        Block& block = *blocks_[block_id];
+        uint32_t prev = block.refcount.fetch_sub(1, std::memory_order_acq_rel);
+        if (prev != 1) {
+            continue;  // Still referenced by another sequence
+        }
+
+        blocks_in_use_--;
+
+        if (!block.registered) {
+            // Unregistered page: straight back to the free list
+            freeBlock(block_id);
+            continue;
+        }
+
+        // Registered chain: becomes an eviction candidate once every block
+        // in the chain is zero-ref. Callers release chains as units, so
+        // checking on the chain's last block suffices.
+        uint64_t hash = block.prefix_hash;
+        Shard& shard = shardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.chains.find(hash);
+        if (it == shard.chains.end()) {
+            // Chain was evicted concurrently; page is already being freed
+            continue;
+        }
+
+        bool all_zero = true;
+        for (uint32_t id : it->second) {
+            if (blocks_[id]->refcount.load(std::memory_order_acquire) != 0) {
+                all_zero = false;
+                break;
+            }
+        }
+
+        if (all_zero && shard.lru_pos.find(hash) == shard.lru_pos.end()) {
+            shard.zero_ref_lru.push_back(hash);
+            shard.lru_pos[hash] = std::prev(shard.zero_ref_lru.end());
+        }
+    }
+}
+
+void KVBlockPool::freeBlock(uint32_t block_id) {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    free_list_.push_back(block_id);
+    blocks_freed_++;
+}
+
+// ============================================================================
+// Prefix sharing
+// ============================================================================
+
+std::vector<uint32_t> KVBlockPool::lookupPrefix(uint64_t prefix_hash) {
+    Shard& shard = shardFor(prefix_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.chains.find(prefix_hash);
+    if (it == shard.chains.end()) {
+        prefix_misses_++;
+        return {};
+    }
+
+    // Adopt the chain: one reference per block for the caller
+    for (uint32_t block_id : it->second) {
+        uint32_t prev = blocks_[block_id]->refcount.fetch_add(
+            1, std::memory_order_acq_rel);
+        if (prev == 0) {
+            blocks_in_use_++;
+        }
+        blocks_shared_++;
+    }
+
+    // No longer an eviction candidate
+    auto pos = shard.lru_pos.find(prefix_hash);
+    if (pos != shard.lru_pos.end()) {
+        shard.zero_ref_lru.erase(pos->second);
+        shard.lru_pos.erase(pos);
+    }
+
+    prefix_hits_++;
+    return it->second;
+}
+
+void KVBlockPool::registerPrefix(uint64_t prefix_hash,
+                                 const std::vector<uint32_t>& blocks) {
+    if (prefix_hash == 0 || blocks.empty()) {
+        return;
+    }
+
+    Shard& shard = shardFor(prefix_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // First writer wins — an existing chain holds identical KV data
+    if (shard.chains.find(prefix_hash) != shard.chains.end()) {
+        return;
+    }
+
+    for (uint32_t block_id : blocks) {
+        if (block_id >= blocks_.size()) {
+            return;
+        }
+    }
+
+    shard.chains[prefix_hash] = blocks;
+    for (uint32_t block_id : blocks) {
+        blocks_[block_id]->prefix_hash = prefix_hash;
+        blocks_[block_id]->registered = true;
+    }
+    cached_chains_++;
+}
+
+bool KVBlockPool::evictOneChain() {
+    // Round-robin over shards so eviction pressure spreads evenly
+    for (uint32_t attempt = 0; attempt < config_.num_shards; ++attempt) {
+        size_t index = next_eviction_shard_.fetch_add(1, std::memory_order_relaxed) &
+                       (config_.num_shards - 1);
+        Shard& shard = *shards_[index];
+
+        std::vector<uint32_t> victim;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.zero_ref_lru.empty()) {
+                continue;
+            }
+
+            uint64_t hash = shard.zero_ref_lru.front();
+            shard.zero_ref_lru.pop_front();
+            shard.lru_pos.erase(hash);
+
+            auto it = shard.chains.find(hash);
+            if (it == shard.chains.end()) {
+                continue;
+            }
+            victim = std::move(it->second);
+            shard.chains.erase(it);
+            cached_chains_--;
+        }
+
+        for (uint32_t block_id : victim) {
+            Block& block = *blocks_[block_id];
+            block.registered = false;
+            block.prefix_hash = 0;
+            freeBlock(block_id);
+        }
+
+        evictions_++;
+        return true;
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Accessors
+// ============================================================================
+
+void* KVBlockPool::blockBuffer(uint32_t block_id) const {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    if (block_id >= blocks_.size()) {
+        return nullptr;
+    }
+    return blocks_[block_id]->buffer;
+}
+
+KVBlockPool::Statistics KVBlockPool::getStatistics() const {
+    Statistics stats;
+    stats.blocks_allocated = blocks_allocated_.load();
+    stats.blocks_freed = blocks_freed_.load();
+    stats.prefix_hits = prefix_hits_.load();
+    stats.prefix_misses = prefix_misses_.load();
+    stats.blocks_shared = blocks_shared_.load();
+    stats.evictions = evictions_.load();
+    stats.allocation_failures = allocation_failures_.load();
+    stats.blocks_in_use = blocks_in_use_.load();
+    stats.cached_chains = cached_chains_.load();
+    stats.bytes_per_block = block_bytes_;
+
+    {
+        std::lock_guard<std::mutex> lock(blocks_mutex_);
+        stats.blocks_free = static_cast<uint32_t>(free_list_.size());
+    }
+
+    return stats;
+}
+
+void KVBlockPool::resetStatistics() {
+    blocks_allocated_ = 0;
+    blocks_freed_ = 0;
+    prefix_hits_ = 0;
+    prefix_misses_ = 0;
+    blocks_shared_ = 0;
+    evictions_ = 0;
+    allocation_failures_ = 0;
+}
+
+} // namespace krserve
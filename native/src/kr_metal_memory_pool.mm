@@ -2,6 +2,8 @@
 #import <Foundation/Foundation.h>
 #include "../include/kr_metal_memory_pool.h"
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <atomic>
 #include <algorithm>
@@ -23,6 +25,15 @@ public:
         , total_released_(0)
         , exhaustion_events_(0)
         , fallback_events_(0)
+        , buffers_acquired_(0)
+        , buffers_released_(0)
+        , buffer_cache_hits_(0)
+        , buffer_fallbacks_(0)
+        , bytes_in_use_(0)
+        , pressure_events_(0)
+        , heaps_purged_(0)
+        , heaps_recommitted_(0)
+        , heaps_grown_(0)
     {
         // Get default Metal device
         device_ = MTLCreateSystemDefaultDevice();
@@ -58,11 +69,45 @@ public:
         std::cerr << "[MetalMemoryPool] Initialized: "
                   << pool_.size() << " heaps × "
                   << config_.heap_size_mb << " MB ("
-                  << (pool_.size() * config_.heap_size_mb) << " MB total)"
-                  << std::endl;
+                  << (pool_.size() * config_.heap_size_mb) << " MB total"
+                  << (config_.elastic
+                      ? ", elastic up to " + std::to_string(config_.max_heaps) : "")
+                  << ")" << std::endl;
+
+        // Elastic mode: respond to system memory pressure by parking idle
+        // heaps as purgeable (jetsam relief for co-tenants on shared hosts)
+        if (config_.elastic) {
+            pressure_source_ = dispatch_source_create(
+                DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+            if (pressure_source_) {
+                dispatch_source_set_event_handler(pressure_source_, ^{
+                    this->handleMemoryPressure();
+                });
+                dispatch_resume(pressure_source_);
+            } else {
+                std::cerr << "[MetalMemoryPool] WARNING: memory-pressure source "
+                          << "unavailable; elastic purging disabled" << std::endl;
+            }
+        }
     }
 
     ~Impl() {
+        if (pressure_source_) {
+            // Cancellation is asynchronous and the pressure handler
+            // captures `this`: wait for the cancellation handler, which
+            // libdispatch runs only after any in-flight event handler
+            // has finished, before tearing down heap state under it.
+            dispatch_semaphore_t cancelled = dispatch_semaphore_create(0);
+            dispatch_source_set_cancel_handler(pressure_source_, ^{
+                dispatch_semaphore_signal(cancelled);
+            });
+            dispatch_source_cancel(pressure_source_);
+            dispatch_semaphore_wait(cancelled, DISPATCH_TIME_FOREVER);
+            pressure_source_ = nullptr;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
 
         // Leak detection
@@ -81,7 +126,16 @@ public:
                       << std::endl;
         }
 
-        // Release all heaps (ARC will handle cleanup)
+        if (!outstanding_buffers_.empty()) {
+            std::cerr << "[MetalMemoryPool] WARNING: "
+                      << outstanding_buffers_.size()
+                      << " suballocated buffers still outstanding at shutdown"
+                      << std::endl;
+        }
+
+        // Release all heaps and buffers (ARC will handle cleanup)
+        free_lists_.clear();
+        outstanding_buffers_.clear();
         pool_.clear();
         available_.clear();
         device_ = nil;
@@ -98,24 +152,30 @@ public:
                 logExhaustion();
             }
 
-            // Fallback: create temporary heap (not pooled)
-            fallback_events_.fetch_add(1, std::memory_order_relaxed);
+            // Elastic: grow the pool up to the ceiling before falling back
+            if (id<MTLHeap> grown = growPool()) {
+                available_.push_back(grown);
+            } else {
+                // Fallback: create temporary heap (not pooled)
+                fallback_events_.fetch_add(1, std::memory_order_relaxed);
 
-            @try {
-                id<MTLHeap> temp_heap = createHeap(config_.heap_size_mb);
-                total_acquired_.fetch_add(1, std::memory_order_relaxed);
-                return (__bridge_retained void*)temp_heap;
-            } @catch (NSException* exception) {
-                std::cerr << "[MetalMemoryPool] CRITICAL: Fallback allocation failed: "
-                          << [[exception reason] UTF8String]
-                          << std::endl;
-                return nullptr;
+                @try {
+                    id<MTLHeap> temp_heap = createHeap(config_.heap_size_mb);
+                    total_acquired_.fetch_add(1, std::memory_order_relaxed);
+                    return (__bridge_retained void*)temp_heap;
+                } @catch (NSException* exception) {
+                    std::cerr << "[MetalMemoryPool] CRITICAL: Fallback allocation failed: "
+                              << [[exception reason] UTF8String]
+                              << std::endl;
+                    return nullptr;
+                }
             }
         }
 
         // Get heap from pool
         id<MTLHeap> heap = available_.back();
         available_.pop_back();
+        ensureCommitted(heap);
 
         total_acquired_.fetch_add(1, std::memory_order_relaxed);
 
@@ -123,6 +183,108 @@ public:
         return (__bridge_retained void*)heap;
     }
 
+    void* acquireBuffer(size_t size) {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        const size_t heap_bytes = config_.heap_size_mb * 1024 * 1024;
+        if (size > heap_bytes) {
+            std::cerr << "[MetalMemoryPool] acquireBuffer: " << size
+                      << " bytes exceeds heap size (" << heap_bytes << " bytes)"
+                      << std::endl;
+            return nullptr;
+        }
+
+        const size_t class_size = sizeClassFor(size);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Fast path: reuse a buffer from this size class's free list
+        auto& free_list = free_lists_[class_size];
+        if (!free_list.empty()) {
+            id<MTLBuffer> buffer = free_list.back();
+            free_list.pop_back();
+
+            buffer_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+            return checkOutBuffer(buffer, class_size, /* from_heap = */ true);
+        }
+
+        // Slow path: carve a new buffer from the first heap with room
+        for (id<MTLHeap> heap : pool_) {
+            ensureCommitted(heap);
+            if ([heap maxAvailableSizeWithAlignment:256] < class_size) {
+                continue;
+            }
+
+            id<MTLBuffer> buffer = [heap newBufferWithLength:class_size
+                                                     options:MTLResourceStorageModePrivate];
+            if (buffer) {
+                return checkOutBuffer(buffer, class_size, /* from_heap = */ true);
+            }
+        }
+
+        // All pooled heaps full: elastic growth before falling back
+        exhaustion_events_.fetch_add(1, std::memory_order_relaxed);
+        if (id<MTLHeap> grown = growPool()) {
+            available_.push_back(grown);
+            id<MTLBuffer> buffer = [grown newBufferWithLength:class_size
+                                                      options:MTLResourceStorageModePrivate];
+            if (buffer) {
+                return checkOutBuffer(buffer, class_size, /* from_heap = */ true);
+            }
+        }
+
+        // Fallback device allocation (not pooled)
+        buffer_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+
+        if (config_.log_exhaustion) {
+            logExhaustion();
+        }
+
+        id<MTLBuffer> buffer = [device_ newBufferWithLength:class_size
+                                                    options:MTLResourceStorageModePrivate];
+        if (!buffer) {
+            std::cerr << "[MetalMemoryPool] CRITICAL: Fallback buffer allocation failed ("
+                      << class_size << " bytes)"
+                      << std::endl;
+            return nullptr;
+        }
+
+        return checkOutBuffer(buffer, class_size, /* from_heap = */ false);
+    }
+
+    void releaseBuffer(void* buffer_ptr) {
+        if (!buffer_ptr) {
+            return;
+        }
+
+        // Balance the __bridge_retained from checkOutBuffer
+        id<MTLBuffer> buffer = (__bridge_transfer id<MTLBuffer>)buffer_ptr;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = outstanding_buffers_.find(buffer_ptr);
+        if (it == outstanding_buffers_.end()) {
+            std::cerr << "[MetalMemoryPool] WARNING: releaseBuffer called with "
+                      << "unknown buffer (double release?)"
+                      << std::endl;
+            return;
+        }
+
+        const BufferRecord record = it->second;
+        outstanding_buffers_.erase(it);
+
+        buffers_released_.fetch_add(1, std::memory_order_relaxed);
+        bytes_in_use_.fetch_sub(record.class_size, std::memory_order_relaxed);
+
+        if (record.from_heap) {
+            // Recycle via size-class free list
+            free_lists_[record.class_size].push_back(buffer);
+        }
+        // else: fallback buffer is released via ARC
+    }
+
     void releaseHeap(void* heap_ptr) {
         if (!heap_ptr) {
             return;
@@ -202,7 +364,17 @@ public:
             .exhaustion_events = exhaustion_events_.load(std::memory_order_relaxed),
             .fallback_events = fallback_events_.load(std::memory_order_relaxed),
             .pool_size = pool_.size(),
-            .available_count = available_.size()
+            .available_count = available_.size(),
+            .buffers_acquired = buffers_acquired_.load(std::memory_order_relaxed),
+            .buffers_released = buffers_released_.load(std::memory_order_relaxed),
+            .buffer_cache_hits = buffer_cache_hits_.load(std::memory_order_relaxed),
+            .buffer_fallbacks = buffer_fallbacks_.load(std::memory_order_relaxed),
+            .buffers_in_use = outstanding_buffers_.size(),
+            .bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed),
+            .pressure_events = pressure_events_.load(std::memory_order_relaxed),
+            .heaps_purged = heaps_purged_.load(std::memory_order_relaxed),
+            .heaps_recommitted = heaps_recommitted_.load(std::memory_order_relaxed),
+            .heaps_grown = heaps_grown_.load(std::memory_order_relaxed)
         };
     }
 
@@ -212,6 +384,14 @@ public:
         total_released_.store(0, std::memory_order_relaxed);
         exhaustion_events_.store(0, std::memory_order_relaxed);
         fallback_events_.store(0, std::memory_order_relaxed);
+        buffers_acquired_.store(0, std::memory_order_relaxed);
+        buffers_released_.store(0, std::memory_order_relaxed);
+        buffer_cache_hits_.store(0, std::memory_order_relaxed);
+        buffer_fallbacks_.store(0, std::memory_order_relaxed);
+        pressure_events_.store(0, std::memory_order_relaxed);
+        heaps_purged_.store(0, std::memory_order_relaxed);
+        heaps_recommitted_.store(0, std::memory_order_relaxed);
+        heaps_grown_.store(0, std::memory_order_relaxed);
     }
 
 private:
@@ -225,6 +405,19 @@ private:
     std::vector<id<MTLHeap>> pool_;       // All allocated heaps
     std::vector<id<MTLHeap>> available_;  // Available heaps (subset of pool_)
 
+    // Suballocation state (acquireBuffer/releaseBuffer path)
+    struct BufferRecord {
+        id<MTLBuffer> buffer;  // Strong reference while outstanding
+        size_t class_size;     // Rounded size-class size in bytes
+        bool from_heap;        // true = carved from pooled heap, false = fallback
+    };
+    std::unordered_map<size_t, std::vector<id<MTLBuffer>>> free_lists_;  // class size -> free buffers
+    std::unordered_map<void*, BufferRecord> outstanding_buffers_;        // checked-out buffers
+
+    // Elastic pooling state
+    dispatch_source_t pressure_source_ = nullptr;
+    std::unordered_set<void*> purged_heaps_;  // (__bridge void*)heap, volatile state
+
     // Thread safety
     mutable std::mutex mutex_;
 
@@ -233,6 +426,45 @@ private:
     std::atomic<uint64_t> total_released_;
     std::atomic<uint64_t> exhaustion_events_;
     std::atomic<uint64_t> fallback_events_;
+    std::atomic<uint64_t> buffers_acquired_;
+    std::atomic<uint64_t> buffers_released_;
+    std::atomic<uint64_t> buffer_cache_hits_;
+    std::atomic<uint64_t> buffer_fallbacks_;
+    std::atomic<size_t> bytes_in_use_;
+    std::atomic<uint64_t> pressure_events_;
+    std::atomic<uint64_t> heaps_purged_;
+    std::atomic<uint64_t> heaps_recommitted_;
+    std::atomic<uint64_t> heaps_grown_;
+
+    /**
+     * Round a requested size up to its power-of-two size class
+     * @param size Requested size in bytes
+     * @return Size-class size in bytes (>= min_buffer_class_kb)
+     */
+    size_t sizeClassFor(size_t size) const {
+        size_t class_size = config_.min_buffer_class_kb * 1024;
+        while (class_size < size) {
+            class_size <<= 1;
+        }
+        return class_size;
+    }
+
+    /**
+     * Record an outstanding buffer and hand it out (caller must hold mutex)
+     * @param buffer Buffer to check out
+     * @param class_size Size-class size in bytes
+     * @param from_heap Whether the buffer came from a pooled heap
+     * @return Bridged pointer for the caller
+     */
+    void* checkOutBuffer(id<MTLBuffer> buffer, size_t class_size, bool from_heap) {
+        void* ptr = (__bridge_retained void*)buffer;
+        outstanding_buffers_[ptr] = BufferRecord{buffer, class_size, from_heap};
+
+        buffers_acquired_.fetch_add(1, std::memory_order_relaxed);
+        bytes_in_use_.fetch_add(class_size, std::memory_order_relaxed);
+
+        return ptr;
+    }
 
     /**
      * Validate configuration
@@ -251,6 +483,18 @@ private:
         if (config_.num_heaps > 16) {
             throw std::invalid_argument("num_heaps must be <= 16");
         }
+        if (config_.elastic) {
+            if (config_.max_heaps < config_.num_heaps) {
+                throw std::invalid_argument("max_heaps must be >= num_heaps");
+            }
+            if (config_.max_heaps > 32) {
+                throw std::invalid_argument("max_heaps must be <= 32");
+            }
+        }
+        if (config_.min_buffer_class_kb == 0 ||
+            (config_.min_buffer_class_kb & (config_.min_buffer_class_kb - 1)) != 0) {
+            throw std::invalid_argument("min_buffer_class_kb must be a power of two");
+        }
 
         // Validate warmup sizes
         for (size_t size : config_.warmup_sizes) {
@@ -291,6 +535,104 @@ private:
         return heap;
     }
 
+    /**
+     * Park idle heaps as purgeable under system memory pressure
+     *
+     * A heap is idle when it sits in available_ and none of the
+     * outstanding suballocated buffers were carved from it. Its recycled
+     * free-list buffers are dropped first (their contents are dead), then
+     * the heap goes volatile — the kernel may reclaim the pages, and
+     * ensureCommitted() brings the heap back the next time it's needed.
+     */
+    void handleMemoryPressure() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pressure_events_.fetch_add(1, std::memory_order_relaxed);
+
+        size_t purged = 0;
+        for (id<MTLHeap> heap : available_) {
+            void* key = (__bridge void*)heap;
+            if (purged_heaps_.count(key)) {
+                continue;
+            }
+            if (heapHasOutstandingBuffers(heap)) {
+                continue;
+            }
+
+            // Drop recycled buffers carved from this heap so the heap is
+            // actually empty when it goes volatile
+            for (auto& entry : free_lists_) {
+                auto& list = entry.second;
+                list.erase(std::remove_if(list.begin(), list.end(),
+                                          [heap](id<MTLBuffer> buffer) {
+                                              return [buffer heap] == heap;
+                                          }),
+                           list.end());
+            }
+
+            [heap setPurgeableState:MTLPurgeableStateVolatile];
+            purged_heaps_.insert(key);
+            heaps_purged_.fetch_add(1, std::memory_order_relaxed);
+            ++purged;
+        }
+
+        std::cerr << "[MetalMemoryPool] Memory pressure: parked " << purged
+                  << " idle heap(s) purgeable ("
+                  << (purged * config_.heap_size_mb) << " MB reclaimable)"
+                  << std::endl;
+    }
+
+    /**
+     * Check whether any outstanding suballocated buffer was carved from
+     * this heap (caller must hold mutex)
+     */
+    bool heapHasOutstandingBuffers(id<MTLHeap> heap) const {
+        for (const auto& entry : outstanding_buffers_) {
+            if (entry.second.from_heap && [entry.second.buffer heap] == heap) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Re-commit a heap that was parked purgeable (caller must hold mutex)
+     */
+    void ensureCommitted(id<MTLHeap> heap) {
+        void* key = (__bridge void*)heap;
+        auto it = purged_heaps_.find(key);
+        if (it == purged_heaps_.end()) {
+            return;
+        }
+        purged_heaps_.erase(it);
+        [heap setPurgeableState:MTLPurgeableStateNonVolatile];
+        heaps_recommitted_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Add one heap to the pool if elastic growth allows it (caller must
+     * hold mutex)
+     * @return The new heap, or nil if at the ceiling / growth failed
+     */
+    id<MTLHeap> growPool() {
+        if (!config_.elastic || pool_.size() >= config_.max_heaps) {
+            return nil;
+        }
+
+        @try {
+            id<MTLHeap> heap = createHeap(config_.heap_size_mb);
+            pool_.push_back(heap);
+            heaps_grown_.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "[MetalMemoryPool] Grew pool to " << pool_.size()
+                      << " heaps (ceiling " << config_.max_heaps << ")"
+                      << std::endl;
+            return heap;
+        } @catch (NSException* exception) {
+            std::cerr << "[MetalMemoryPool] Growth failed: "
+                      << [[exception reason] UTF8String] << std::endl;
+            return nil;
+        }
+    }
+
     /**
      * Log pool exhaustion warning
      */
@@ -327,6 +669,14 @@ void MetalMemoryPool::releaseHeap(void* heap) {
     impl_->releaseHeap(heap);
 }
 
+void* MetalMemoryPool::acquireBuffer(size_t size) {
+    return impl_->acquireBuffer(size);
+}
+
+void MetalMemoryPool::releaseBuffer(void* buffer) {
+    impl_->releaseBuffer(buffer);
+}
+
 void MetalMemoryPool::warmup() {
     impl_->warmup();
 }
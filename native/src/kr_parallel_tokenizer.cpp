@@ -1,4 +1,5 @@
 #include "../include/kr_parallel_tokenizer.h"
+#include "../include/kr_bpe_engine.h"
 
 #include <chrono>
 #include <algorithm>
@@ -58,6 +59,34 @@ inline size_t findUtf8Boundary(const char* text, size_t pos, size_t max_len) {
     return pos; // Fallback
 }
 
+/**
+ * Expected byte length of a UTF-8 sequence from its lead byte
+ * (invalid lead bytes count as length 1 so they pass through)
+ */
+inline size_t utf8SequenceLength(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead & 0xE0) == 0xC0) return 2;
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+/**
+ * Length of the prefix that ends on a complete UTF-8 character
+ *
+ * Everything up to this point is safe to emit; the remainder (at most
+ * 3 bytes) is an incomplete sequence awaiting continuation bytes.
+ */
+inline size_t utf8SafePrefix(const char* data, size_t len) {
+    if (len == 0) return 0;
+
+    // Boundary of the last (possibly incomplete) character
+    size_t last = findUtf8Boundary(data, len - 1, len);
+    size_t expected = utf8SequenceLength(static_cast<unsigned char>(data[last]));
+
+    return (last + expected <= len) ? len : last;
+}
+
 } // anonymous namespace
 
 // Static methods
@@ -375,6 +404,219 @@ std::vector<std::vector<uint32_t>> ParallelTokenizer::encodeBatch(
     return results;
 }
 
+// Load native BPE vocabulary from files
+void ParallelTokenizer::loadVocabulary(
+    const std::string& vocab_path,
+    const std::string& merges_path
+) {
+    auto engine = std::make_shared<BpeEngine>();
+    engine->loadFromFiles(vocab_path, merges_path);
+    engine_ = std::move(engine);
+}
+
+// Load native BPE vocabulary from pre-parsed tables
+void ParallelTokenizer::loadVocabularyFromTables(
+    const std::unordered_map<std::string, uint32_t>& vocab,
+    const std::vector<std::pair<std::string, std::string>>& merges
+) {
+    auto engine = std::make_shared<BpeEngine>();
+    engine->loadFromTables(vocab, merges);
+    engine_ = std::move(engine);
+}
+
+// Load a compiled (mmap-able) vocabulary
+void ParallelTokenizer::loadCompiledVocabulary(const std::string& path) {
+    auto engine = std::make_shared<BpeEngine>();
+    engine->loadFromCompiledFile(path);
+    engine_ = std::move(engine);
+}
+
+// Compile the loaded vocabulary for later zero-copy loads
+void ParallelTokenizer::compileVocabulary(const std::string& output_path) const {
+    if (!hasNativeEngine()) {
+        throw std::runtime_error(
+            "ParallelTokenizer: no native vocabulary loaded (call loadVocabulary first)");
+    }
+    engine_->compileToFile(output_path);
+}
+
+bool ParallelTokenizer::hasNativeEngine() const {
+    return engine_ && engine_->isLoaded();
+}
+
+// Encode single text with the native BPE engine
+std::vector<uint32_t> ParallelTokenizer::encodeNative(const std::string& text) {
+    if (!hasNativeEngine()) {
+        throw std::runtime_error(
+            "ParallelTokenizer: no native vocabulary loaded (call loadVocabulary first)");
+    }
+
+    uint64_t start_time = config_.enable_stats ? getCurrentTimeMicros() : 0;
+
+    std::vector<uint32_t> result;
+
+    // For small texts, encode directly (chunking overhead not worth it)
+    if (text.size() < config_.min_chunk_size * config_.num_threads) {
+        result = engine_->encode(text);
+    } else {
+#if HAS_OPENMP
+        // Split on UTF-8 boundaries and encode chunks in parallel.
+        // Chunk boundaries fall inside whitespace-separated words only at
+        // the split points, which matches the chunked-callback behavior of
+        // encode() — callers needing exact parity should use the batch path.
+        auto chunks = splitIntoChunks(text, config_.num_threads);
+        std::vector<std::vector<uint32_t>> chunk_results(chunks.size());
+
+        BpeEngine* engine = engine_.get();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunk_results[i] = engine->encode(chunks[i]);
+        }
+
+        result = mergeTokens(chunk_results);
+#else
+        result = engine_->encode(text);
+#endif
+    }
+
+    if (config_.enable_stats) {
+        total_encodes_.fetch_add(1, std::memory_order_relaxed);
+        native_encodes_.fetch_add(1, std::memory_order_relaxed);
+        recordTiming(start_time, result.size(), text.size());
+    }
+
+    return result;
+}
+
+// Encode batch with the native BPE engine
+std::vector<std::vector<uint32_t>> ParallelTokenizer::encodeBatchNative(
+    const std::vector<std::string>& texts
+) {
+    if (!hasNativeEngine()) {
+        throw std::runtime_error(
+            "ParallelTokenizer: no native vocabulary loaded (call loadVocabulary first)");
+    }
+
+    uint64_t start_time = config_.enable_stats ? getCurrentTimeMicros() : 0;
+
+    std::vector<std::vector<uint32_t>> results(texts.size());
+
+    if (texts.empty()) {
+        return results;
+    }
+
+    BpeEngine* engine = engine_.get();
+
+#if HAS_OPENMP
+    // One text per thread — no GIL, no callback, full fan-out
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < texts.size(); ++i) {
+        results[i] = engine->encode(texts[i]);
+    }
+#else
+    for (size_t i = 0; i < texts.size(); ++i) {
+        results[i] = engine->encode(texts[i]);
+    }
+#endif
+
+    if (config_.enable_stats) {
+        total_batch_encodes_.fetch_add(1, std::memory_order_relaxed);
+        native_encodes_.fetch_add(texts.size(), std::memory_order_relaxed);
+        size_t total_tokens = 0;
+        size_t total_bytes = 0;
+        for (size_t i = 0; i < texts.size(); ++i) {
+            total_tokens += results[i].size();
+            total_bytes += texts[i].size();
+        }
+        recordTiming(start_time, total_tokens, total_bytes);
+    }
+
+    return results;
+}
+
+// Streaming decoder
+StreamingDecoder::StreamingDecoder(std::shared_ptr<BpeEngine> engine)
+    : engine_(std::move(engine)) {
+    // Tail is at most 3 bytes, but token byte runs pass through here;
+    // reserve once so steady-state feed() never allocates
+    pending_.reserve(64);
+}
+
+std::string StreamingDecoder::feed(uint32_t token_id) {
+    const std::string& bytes = engine_->decodeToken(token_id);
+    ++tokens_fed_;
+
+    std::string out;
+    if (pending_.empty()) {
+        // Fast path: emit straight from the token's bytes
+        size_t safe = utf8SafePrefix(bytes.data(), bytes.size());
+        out.assign(bytes.data(), safe);
+        if (safe < bytes.size()) {
+            pending_.assign(bytes.data() + safe, bytes.size() - safe);
+        }
+        return out;
+    }
+
+    pending_.append(bytes);
+    size_t safe = utf8SafePrefix(pending_.data(), pending_.size());
+    if (safe > 0) {
+        out.assign(pending_.data(), safe);
+        pending_.erase(0, safe);
+    }
+    return out;
+}
+
+std::string StreamingDecoder::flush() {
+    // End of stream: emit the tail as-is rather than dropping it (the
+    // client's decoder gets to decide how to render a truncated char)
+    std::string out = std::move(pending_);
+    pending_.clear();
+    return out;
+}
+
+void StreamingDecoder::reset() {
+    pending_.clear();
+    tokens_fed_ = 0;
+}
+
+// Acquire a pooled streaming decoder
+std::shared_ptr<StreamingDecoder> ParallelTokenizer::acquireStreamDecoder() {
+    if (!hasNativeEngine()) {
+        throw std::runtime_error(
+            "ParallelTokenizer: no native vocabulary loaded (call loadVocabulary first)");
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(decoder_pool_mutex_);
+        if (!decoder_pool_.empty()) {
+            auto decoder = std::move(decoder_pool_.back());
+            decoder_pool_.pop_back();
+            decoder->reset();
+            return decoder;
+        }
+    }
+
+    return std::make_shared<StreamingDecoder>(engine_);
+}
+
+// Return a streaming decoder to the pool
+void ParallelTokenizer::releaseStreamDecoder(std::shared_ptr<StreamingDecoder> decoder) {
+    if (!decoder) return;
+
+    if (config_.enable_stats) {
+        stream_tokens_.fetch_add(decoder->tokensFed(), std::memory_order_relaxed);
+    }
+
+    // Drop decoders bound to a replaced vocabulary instead of pooling
+    if (decoder->engine_ != engine_) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(decoder_pool_mutex_);
+    decoder_pool_.push_back(std::move(decoder));
+}
+
 // Async encode
 std::future<std::vector<uint32_t>> ParallelTokenizer::encodeAsync(
     const std::string& text,
@@ -399,6 +641,35 @@ std::future<std::vector<uint32_t>> ParallelTokenizer::encodeAsync(
     return future;
 }
 
+// Async encode with completion callback
+void ParallelTokenizer::encodeAsyncCallback(
+    const std::string& text,
+    const std::function<std::vector<uint32_t>(const std::string&)>& tokenizer_fn,
+    EncodeCallback on_complete
+) {
+    submitTask([this, text, tokenizer_fn, on_complete]() {
+        try {
+            on_complete(encode(text, tokenizer_fn), nullptr);
+        } catch (...) {
+            on_complete({}, std::current_exception());
+        }
+    });
+}
+
+// Async native encode with completion callback
+void ParallelTokenizer::encodeNativeAsync(
+    const std::string& text,
+    EncodeCallback on_complete
+) {
+    submitTask([this, text, on_complete]() {
+        try {
+            on_complete(encodeNative(text), nullptr);
+        } catch (...) {
+            on_complete({}, std::current_exception());
+        }
+    });
+}
+
 // Get statistics
 ParallelTokenizerStatistics ParallelTokenizer::getStatistics() const {
     return {
@@ -409,7 +680,9 @@ ParallelTokenizerStatistics ParallelTokenizer::getStatistics() const {
         .total_encode_time_us = total_encode_time_us_.load(),
         .speedup_ratio = speedup_ratio_.load(),
         .active_threads = active_threads_.load(),
-        .accelerate_ops = accelerate_ops_.load()
+        .accelerate_ops = accelerate_ops_.load(),
+        .native_encodes = native_encodes_.load(),
+        .stream_tokens = stream_tokens_.load()
     };
 }
 
@@ -422,6 +695,8 @@ void ParallelTokenizer::resetStatistics() {
     total_encode_time_us_.store(0);
     speedup_ratio_.store(1.0);
     accelerate_ops_.store(0);
+    native_encodes_.store(0);
+    stream_tokens_.store(0);
 }
 
 } // namespace krserve
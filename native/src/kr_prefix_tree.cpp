@@ -0,0 +1,301 @@
+#include "../include/kr_prefix_tree.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace krserve {
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+PrefixTree::PrefixTree(KVBlockPool* pool)
+    : pool_(pool)
+{
+    if (!pool_) {
+        throw std::invalid_argument("pool must not be null");
+    }
+
+    block_tokens_ = pool_->getConfig().block_size_tokens;
+    root_ = std::make_unique<Node>();
+    node_count_ = 1;
+
+    std::cerr << "[PrefixTree] Initialized (block granularity: "
+              << block_tokens_ << " tokens)" << std::endl;
+}
+
+PrefixTree::~PrefixTree() {
+    clear();
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+std::vector<uint32_t> PrefixTree::chainForDepth(
+    const std::vector<uint32_t>& blocks, size_t depth) const {
+    size_t complete = depth / block_tokens_;
+    if (complete >= blocks.size()) {
+        return blocks;
+    }
+    return std::vector<uint32_t>(blocks.begin(), blocks.begin() + complete);
+}
+
+void PrefixTree::releaseSubtree(Node* node) {
+    for (auto& [first_token, child] : node->children) {
+        releaseSubtree(child.get());
+    }
+    if (!node->blocks.empty()) {
+        pool_->releaseBlocks(node->blocks);
+        node->blocks.clear();
+    }
+}
+
+// ============================================================================
+// Insert
+// ============================================================================
+
+void PrefixTree::insert(const std::vector<uint32_t>& tokens,
+                        const std::vector<uint32_t>& blocks) {
+    if (tokens.empty() || blocks.empty()) {
+        return;
+    }
+    if (blocks.size() < tokens.size() / block_tokens_) {
+        std::cerr << "[PrefixTree] Insert rejected: " << blocks.size()
+                  << " blocks cannot cover " << tokens.size() << " tokens"
+                  << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(tree_mutex_);
+    uint64_t now = ++access_clock_;
+
+    Node* node = root_.get();
+    size_t pos = 0;
+
+    while (true) {
+        node->last_access = now;
+
+        if (pos == tokens.size()) {
+            // Exact path already exists; first writer wins (identical KV)
+            if (node->blocks.empty()) {
+                node->blocks = chainForDepth(blocks, node->depth);
+                pool_->retainBlocks(node->blocks);
+            }
+            break;
+        }
+
+        auto it = node->children.find(tokens[pos]);
+        if (it == node->children.end()) {
+            // New leaf for the remaining tokens
+            auto leaf = std::make_unique<Node>();
+            leaf->edge.assign(tokens.begin() + pos, tokens.end());
+            leaf->depth = tokens.size();
+            leaf->blocks = chainForDepth(blocks, leaf->depth);
+            leaf->last_access = now;
+            pool_->retainBlocks(leaf->blocks);
+
+            node->children[tokens[pos]] = std::move(leaf);
+            node_count_++;
+            break;
+        }
+
+        Node* child = it->second.get();
+
+        // Longest common run between the edge label and remaining tokens
+        size_t common = 0;
+        size_t limit = std::min(child->edge.size(), tokens.size() - pos);
+        while (common < limit && child->edge[common] == tokens[pos + common]) {
+            common++;
+        }
+
+        if (common == child->edge.size()) {
+            // Whole edge matched — descend
+            node = child;
+            pos += common;
+            continue;
+        }
+
+        // Divergence mid-edge: split the edge at the common run
+        auto mid = std::make_unique<Node>();
+        mid->edge.assign(child->edge.begin(), child->edge.begin() + common);
+        mid->depth = child->depth - child->edge.size() + common;
+        mid->blocks = chainForDepth(child->blocks, mid->depth);
+        mid->last_access = now;
+        pool_->retainBlocks(mid->blocks);
+
+        child->edge.erase(child->edge.begin(), child->edge.begin() + common);
+
+        Node* mid_ptr = mid.get();
+        mid->children[child->edge[0]] = std::move(it->second);
+        it->second = std::move(mid);
+        node_count_++;
+
+        node = mid_ptr;
+        pos += common;
+        // Loop continues: either pos == tokens.size() (mid is the endpoint)
+        // or a new leaf hangs off mid on the next iteration
+    }
+
+    inserts_++;
+}
+
+// ============================================================================
+// Match
+// ============================================================================
+
+PrefixTree::MatchResult PrefixTree::matchLongestPrefix(
+    const std::vector<uint32_t>& tokens) {
+    MatchResult result;
+    lookups_++;
+
+    if (tokens.empty()) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(tree_mutex_);
+    uint64_t now = ++access_clock_;
+
+    Node* node = root_.get();
+    size_t pos = 0;
+    Node* best = nullptr;        // Deepest node whose chain covers `best_depth`
+    size_t best_depth = 0;       // Matched tokens at `best`
+
+    while (pos < tokens.size()) {
+        auto it = node->children.find(tokens[pos]);
+        if (it == node->children.end()) {
+            break;
+        }
+
+        Node* child = it->second.get();
+        size_t common = 0;
+        size_t limit = std::min(child->edge.size(), tokens.size() - pos);
+        while (common < limit && child->edge[common] == tokens[pos + common]) {
+            common++;
+        }
+
+        if (!child->blocks.empty()) {
+            // Even a partial edge match can cover more complete blocks
+            size_t matched_depth = child->depth - child->edge.size() + common;
+            if (matched_depth / block_tokens_ > best_depth / block_tokens_ ||
+                best == nullptr) {
+                best = child;
+                best_depth = matched_depth;
+            }
+        }
+
+        if (common < child->edge.size()) {
+            break;  // Diverged mid-edge
+        }
+
+        child->last_access = now;
+        node = child;
+        pos += common;
+    }
+
+    if (!best) {
+        return result;
+    }
+
+    result.blocks = chainForDepth(best->blocks, best_depth);
+    result.matched_tokens = result.blocks.size() * block_tokens_;
+
+    if (result.blocks.empty()) {
+        result.matched_tokens = 0;
+        result.blocks.clear();
+        return result;
+    }
+
+    // Hand the caller its own references
+    pool_->retainBlocks(result.blocks);
+
+    hits_++;
+    tokens_matched_ += result.matched_tokens;
+    return result;
+}
+
+// ============================================================================
+// Eviction
+// ============================================================================
+
+uint32_t PrefixTree::evictLeaves(uint32_t count) {
+    std::lock_guard<std::mutex> lock(tree_mutex_);
+
+    uint32_t evicted = 0;
+    while (evicted < count) {
+        // Find the least-recently-accessed leaf (full DFS — eviction runs
+        // off the request path, so clarity beats speed here)
+        Node* parent_of_victim = nullptr;
+        uint32_t victim_key = 0;
+        uint64_t oldest = UINT64_MAX;
+
+        std::vector<Node*> stack{root_.get()};
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            for (auto& [first_token, child] : node->children) {
+                if (child->children.empty()) {
+                    if (child->last_access < oldest) {
+                        oldest = child->last_access;
+                        parent_of_victim = node;
+                        victim_key = first_token;
+                    }
+                } else {
+                    stack.push_back(child.get());
+                }
+            }
+        }
+
+        if (!parent_of_victim) {
+            break;  // Tree is empty
+        }
+
+        auto it = parent_of_victim->children.find(victim_key);
+        if (!it->second->blocks.empty()) {
+            pool_->releaseBlocks(it->second->blocks);
+        }
+        parent_of_victim->children.erase(it);
+        node_count_--;
+        evicted++;
+        leaf_evictions_++;
+    }
+
+    return evicted;
+}
+
+void PrefixTree::clear() {
+    std::lock_guard<std::mutex> lock(tree_mutex_);
+    releaseSubtree(root_.get());
+    root_ = std::make_unique<Node>();
+    node_count_ = 1;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+PrefixTree::Statistics PrefixTree::getStatistics() const {
+    Statistics stats;
+    stats.inserts = inserts_.load();
+    stats.lookups = lookups_.load();
+    stats.hits = hits_.load();
+    stats.tokens_matched = tokens_matched_.load();
+    stats.leaf_evictions = leaf_evictions_.load();
+
+    {
+        std::lock_guard<std::mutex> lock(tree_mutex_);
+        stats.node_count = node_count_;
+    }
+
+    return stats;
+}
+
+void PrefixTree::resetStatistics() {
+    inserts_ = 0;
+    lookups_ = 0;
+    hits_ = 0;
+    tokens_matched_ = 0;
+    leaf_evictions_ = 0;
+}
+
+} // namespace krserve
@@ -0,0 +1,222 @@
+#include "kr_request_arena.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace krserve {
+
+namespace {
+
+// Every allocation is rounded to this so any object type fits the
+// returned pointer without per-call alignment bookkeeping
+constexpr size_t ARENA_ALIGNMENT = alignof(std::max_align_t);
+
+inline size_t alignUp(size_t bytes) {
+    return (bytes + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ArenaPool
+// ============================================================================
+
+ArenaPool::Block::Block(size_t block_capacity)
+    : data(new uint8_t[block_capacity]),
+      capacity(block_capacity) {}
+
+ArenaPool::ArenaPool(const Config& config)
+    : config_(config) {
+    validateConfig();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_blocks_.reserve(config_.max_pooled_blocks);
+    for (size_t i = 0; i < config_.initial_blocks; ++i) {
+        free_blocks_.push_back(std::make_unique<Block>(config_.block_size));
+        if (config_.enable_stats) {
+            blocks_created_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+ArenaPool::~ArenaPool() = default;
+
+void ArenaPool::validateConfig() const {
+    if (config_.block_size < 4096) {
+        throw std::invalid_argument("block_size must be >= 4096");
+    }
+    if (config_.max_pooled_blocks == 0) {
+        throw std::invalid_argument("max_pooled_blocks must be > 0");
+    }
+    if (config_.initial_blocks > config_.max_pooled_blocks) {
+        throw std::invalid_argument(
+            "initial_blocks must be <= max_pooled_blocks");
+    }
+}
+
+std::unique_ptr<ArenaPool::Block> ArenaPool::acquireBlock() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_blocks_.empty()) {
+            auto block = std::move(free_blocks_.back());
+            free_blocks_.pop_back();
+            if (config_.enable_stats) {
+                blocks_recycled_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return block;
+        }
+    }
+
+    if (config_.enable_stats) {
+        blocks_created_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::make_unique<Block>(config_.block_size);
+}
+
+std::unique_ptr<ArenaPool::Block> ArenaPool::createOversizeBlock(size_t bytes) {
+    if (config_.enable_stats) {
+        blocks_created_.fetch_add(1, std::memory_order_relaxed);
+        oversize_allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::make_unique<Block>(bytes);
+}
+
+void ArenaPool::releaseBlocks(std::vector<std::unique_ptr<Block>>& blocks) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& block : blocks) {
+        if (free_blocks_.size() < config_.max_pooled_blocks) {
+            block->used.store(0, std::memory_order_relaxed);
+            free_blocks_.push_back(std::move(block));
+        } else if (config_.enable_stats) {
+            blocks_dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    blocks.clear();
+}
+
+ArenaPool::Statistics ArenaPool::getStatistics() const {
+    size_t pooled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pooled = free_blocks_.size();
+    }
+    return Statistics{
+        .blocks_created = blocks_created_.load(std::memory_order_relaxed),
+        .blocks_recycled = blocks_recycled_.load(std::memory_order_relaxed),
+        .blocks_dropped = blocks_dropped_.load(std::memory_order_relaxed),
+        .arenas_created = arenas_created_.load(std::memory_order_relaxed),
+        .bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed),
+        .allocations = allocations_.load(std::memory_order_relaxed),
+        .oversize_allocations =
+            oversize_allocations_.load(std::memory_order_relaxed),
+        .blocks_pooled = pooled,
+    };
+}
+
+void ArenaPool::resetStatistics() {
+    blocks_created_.store(0, std::memory_order_relaxed);
+    blocks_recycled_.store(0, std::memory_order_relaxed);
+    blocks_dropped_.store(0, std::memory_order_relaxed);
+    arenas_created_.store(0, std::memory_order_relaxed);
+    bytes_allocated_.store(0, std::memory_order_relaxed);
+    allocations_.store(0, std::memory_order_relaxed);
+    oversize_allocations_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// RequestArena
+// ============================================================================
+
+RequestArena::RequestArena(ArenaPool* pool)
+    : pool_(pool) {
+    if (!pool_) {
+        throw std::invalid_argument("RequestArena requires a backing ArenaPool");
+    }
+
+    auto block = pool_->acquireBlock();
+    current_.store(block.get(), std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(blocks_mutex_);
+        blocks_.push_back(std::move(block));
+    }
+
+    if (pool_->config_.enable_stats) {
+        pool_->arenas_created_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RequestArena::~RequestArena() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    pool_->releaseBlocks(blocks_);
+    oversize_blocks_.clear();
+}
+
+void* RequestArena::allocate(size_t bytes) {
+    size_t rounded = alignUp(bytes == 0 ? 1 : bytes);
+
+    if (pool_->config_.enable_stats) {
+        pool_->allocations_.fetch_add(1, std::memory_order_relaxed);
+        pool_->bytes_allocated_.fetch_add(rounded, std::memory_order_relaxed);
+    }
+    bytes_allocated_.fetch_add(rounded, std::memory_order_relaxed);
+
+    // Fast path: one atomic bump on the current block. Losing a race
+    // here only wastes the overshoot bytes of the losing thread.
+    ArenaPool::Block* block = current_.load(std::memory_order_acquire);
+    size_t offset = block->used.fetch_add(rounded, std::memory_order_relaxed);
+    if (offset + rounded <= block->capacity) {
+        return block->data.get() + offset;
+    }
+
+    return allocateSlow(rounded);
+}
+
+void* RequestArena::allocateSlow(size_t rounded) {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+
+    // Oversize allocations get a dedicated block so they don't poison
+    // the bump block for everyone else
+    if (rounded > pool_->config_.block_size / 2) {
+        auto block = pool_->createOversizeBlock(rounded);
+        void* out = block->data.get();
+        oversize_blocks_.push_back(std::move(block));
+        return out;
+    }
+
+    // Another thread may have installed a fresh block while we waited
+    ArenaPool::Block* block = current_.load(std::memory_order_acquire);
+    size_t offset = block->used.fetch_add(rounded, std::memory_order_relaxed);
+    if (offset + rounded <= block->capacity) {
+        return block->data.get() + offset;
+    }
+
+    auto fresh = pool_->acquireBlock();
+    fresh->used.store(rounded, std::memory_order_relaxed);
+    void* out = fresh->data.get();
+    current_.store(fresh.get(), std::memory_order_release);
+    blocks_.push_back(std::move(fresh));
+    return out;
+}
+
+void RequestArena::reset() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+
+    // Keep one block hot for the next use, return the rest
+    auto keep = std::move(blocks_.back());
+    blocks_.pop_back();
+    pool_->releaseBlocks(blocks_);
+    oversize_blocks_.clear();
+
+    keep->used.store(0, std::memory_order_relaxed);
+    current_.store(keep.get(), std::memory_order_release);
+    blocks_.push_back(std::move(keep));
+
+    bytes_allocated_.store(0, std::memory_order_relaxed);
+}
+
+size_t RequestArena::blocksUsed() const {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    return blocks_.size() + oversize_blocks_.size();
+}
+
+} // namespace krserve
@@ -0,0 +1,401 @@
+#include "kr_sampling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+// Apple Accelerate framework (vDSP vectorized softmax)
+#ifdef __APPLE__
+#include <Accelerate/Accelerate.h>
+#define HAS_ACCELERATE 1
+#else
+#define HAS_ACCELERATE 0
+#endif
+
+namespace krserve {
+
+namespace {
+
+/**
+ * Get current time in microseconds
+ */
+uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+Sampler::Sampler(const Config& config) : config_(config) {
+    validateConfig();
+
+    probs_.resize(config_.vocab_size);
+    indices_.resize(config_.vocab_size);
+
+    uint64_t seed = config_.seed;
+    if (seed == 0) {
+        std::random_device rd;
+        seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }
+    rng_.seed(seed);
+
+    std::cerr << "[Sampler] Created: vocab_size=" << config_.vocab_size
+              << ", temperature=" << config_.temperature
+              << ", top_k=" << config_.top_k
+              << ", top_p=" << config_.top_p
+              << ", accelerate=" << (isAccelerateAvailable() ? "yes" : "no")
+              << std::endl;
+}
+
+Sampler::~Sampler() = default;
+
+void Sampler::validateConfig() const {
+    if (config_.vocab_size == 0) {
+        throw std::invalid_argument("vocab_size must be > 0");
+    }
+    if (config_.top_k > config_.vocab_size) {
+        throw std::invalid_argument("top_k must be <= vocab_size");
+    }
+    if (config_.top_p <= 0.0f || config_.top_p > 1.0f) {
+        throw std::invalid_argument("top_p must be in (0, 1]");
+    }
+}
+
+bool Sampler::isAccelerateAvailable() {
+    return HAS_ACCELERATE;
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+uint32_t Sampler::sample(const float* logits) {
+    return sample(logits, config_.temperature, config_.top_k, config_.top_p);
+}
+
+uint32_t Sampler::sample(const float* logits, float temperature,
+                         uint32_t top_k, float top_p) {
+    if (!logits) {
+        throw std::invalid_argument("logits must not be null");
+    }
+
+    uint64_t start = config_.enable_stats ? nowMicros() : 0;
+    uint32_t token;
+    {
+        std::lock_guard<std::mutex> lock(scratch_mutex_);
+        token = sampleLocked(logits, temperature, top_k, top_p);
+    }
+
+    if (config_.enable_stats) {
+        tokens_sampled_.fetch_add(1, std::memory_order_relaxed);
+        total_sample_time_us_.fetch_add(nowMicros() - start,
+                                        std::memory_order_relaxed);
+    }
+    return token;
+}
+
+std::vector<uint32_t> Sampler::sampleBatch(const float* logits,
+                                           size_t num_rows) {
+    if (!logits) {
+        throw std::invalid_argument("logits must not be null");
+    }
+
+    uint64_t start = config_.enable_stats ? nowMicros() : 0;
+    std::vector<uint32_t> tokens;
+    tokens.reserve(num_rows);
+    {
+        std::lock_guard<std::mutex> lock(scratch_mutex_);
+        for (size_t row = 0; row < num_rows; ++row) {
+            tokens.push_back(sampleLocked(logits + row * config_.vocab_size,
+                                          config_.temperature, config_.top_k,
+                                          config_.top_p));
+        }
+    }
+
+    if (config_.enable_stats) {
+        tokens_sampled_.fetch_add(num_rows, std::memory_order_relaxed);
+        total_sample_time_us_.fetch_add(nowMicros() - start,
+                                        std::memory_order_relaxed);
+    }
+    return tokens;
+}
+
+uint32_t Sampler::argmax(const float* logits) const {
+    const size_t n = config_.vocab_size;
+#if HAS_ACCELERATE
+    float max_value = 0.0f;
+    vDSP_Length max_index = 0;
+    vDSP_maxvi(logits, 1, &max_value, &max_index, n);
+    return static_cast<uint32_t>(max_index);
+#else
+    return static_cast<uint32_t>(
+        std::max_element(logits, logits + n) - logits);
+#endif
+}
+
+void Sampler::softmaxWithTemperature(const float* logits, float temperature) {
+    const size_t n = config_.vocab_size;
+    float* probs = probs_.data();
+
+#if HAS_ACCELERATE
+    // probs = logits / temperature
+    vDSP_vsdiv(logits, 1, &temperature, probs, 1, n);
+
+    // Subtract max for numeric stability
+    float max_value = 0.0f;
+    vDSP_maxv(probs, 1, &max_value, n);
+    float neg_max = -max_value;
+    vDSP_vsadd(probs, 1, &neg_max, probs, 1, n);
+
+    // Vectorized exp, then normalize by the sum
+    int count = static_cast<int>(n);
+    vvexpf(probs, probs, &count);
+    float sum = 0.0f;
+    vDSP_sve(probs, 1, &sum, n);
+    vDSP_vsdiv(probs, 1, &sum, probs, 1, n);
+#else
+    float max_value = logits[0];
+    for (size_t i = 1; i < n; ++i) {
+        max_value = std::max(max_value, logits[i]);
+    }
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        probs[i] = std::exp((logits[i] - max_value) / temperature);
+        sum += probs[i];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        probs[i] /= sum;
+    }
+#endif
+}
+
+uint32_t Sampler::sampleLocked(const float* logits, float temperature,
+                               uint32_t top_k, float top_p) {
+    // Greedy path: no softmax, no RNG
+    if (temperature <= 0.0f) {
+        if (config_.enable_stats) {
+            greedy_samples_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return argmax(logits);
+    }
+
+    const size_t n = config_.vocab_size;
+    softmaxWithTemperature(logits, temperature);
+
+    // Candidate set starts as the full vocab
+    std::iota(indices_.begin(), indices_.end(), 0u);
+    size_t candidates = n;
+    const float* probs = probs_.data();
+
+    // Top-k: partial select so cost scales with k, not vocab size
+    if (top_k > 0 && top_k < candidates) {
+        std::nth_element(indices_.begin(), indices_.begin() + top_k,
+                         indices_.begin() + candidates,
+                         [probs](uint32_t a, uint32_t b) {
+                             return probs[a] > probs[b];
+                         });
+        candidates = top_k;
+        if (config_.enable_stats) {
+            topk_truncations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Top-p: sort the (already truncated) candidates and cut at the
+    // nucleus boundary
+    if (top_p < 1.0f) {
+        std::sort(indices_.begin(), indices_.begin() + candidates,
+                  [probs](uint32_t a, uint32_t b) {
+                      return probs[a] > probs[b];
+                  });
+        float cumulative = 0.0f;
+        size_t kept = 0;
+        while (kept < candidates) {
+            cumulative += probs[indices_[kept]];
+            ++kept;
+            if (cumulative >= top_p) {
+                break;
+            }
+        }
+        if (config_.enable_stats && kept < candidates) {
+            topp_truncations_.fetch_add(1, std::memory_order_relaxed);
+        }
+        candidates = kept;
+    }
+
+    // Categorical draw over the surviving candidates (renormalized
+    // implicitly by drawing in [0, candidate mass))
+    float mass = 0.0f;
+    for (size_t i = 0; i < candidates; ++i) {
+        mass += probs[indices_[i]];
+    }
+    std::uniform_real_distribution<float> dist(0.0f, mass);
+    float draw = dist(rng_);
+    for (size_t i = 0; i < candidates; ++i) {
+        draw -= probs[indices_[i]];
+        if (draw <= 0.0f) {
+            return indices_[i];
+        }
+    }
+    return indices_[candidates - 1];  // Float round-off: take the last
+}
+
+// ============================================================================
+// Speculative verification
+// ============================================================================
+
+uint32_t Sampler::residualResample(const float* target_row,
+                                   const float* draft_row) {
+    const size_t n = config_.vocab_size;
+    float* probs = probs_.data();
+
+#if HAS_ACCELERATE
+    // probs = max(0, probs - draft_row)
+    vDSP_vsub(draft_row, 1, probs, 1, probs, 1, n);
+    float zero = 0.0f;
+    vDSP_vthres(probs, 1, &zero, probs, 1, n);
+    float mass = 0.0f;
+    vDSP_sve(probs, 1, &mass, n);
+#else
+    float mass = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        probs[i] = std::max(0.0f, probs[i] - draft_row[i]);
+        mass += probs[i];
+    }
+#endif
+
+    if (mass <= 0.0f) {
+        // Target and draft distributions coincide (up to round-off):
+        // any target draw is valid
+        return sampleLocked(target_row, config_.temperature, 0, 1.0f);
+    }
+
+    std::uniform_real_distribution<float> dist(0.0f, mass);
+    float draw = dist(rng_);
+    for (size_t i = 0; i < n; ++i) {
+        draw -= probs[i];
+        if (draw <= 0.0f) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    return static_cast<uint32_t>(n - 1);  // Float round-off: take the last
+}
+
+Sampler::VerificationResult Sampler::verifyDraft(const float* target_logits,
+                                                 const uint32_t* draft_tokens,
+                                                 size_t draft_len,
+                                                 const float* draft_probs) {
+    if (!target_logits || !draft_tokens) {
+        throw std::invalid_argument("target_logits and draft_tokens must not be null");
+    }
+    if (draft_len == 0) {
+        throw std::invalid_argument("draft_len must be > 0");
+    }
+
+    uint64_t start = config_.enable_stats ? nowMicros() : 0;
+    const size_t n = config_.vocab_size;
+    const float temperature = config_.temperature;
+    const bool greedy = (temperature <= 0.0f) || !draft_probs;
+
+    VerificationResult result{};
+    {
+        std::lock_guard<std::mutex> lock(scratch_mutex_);
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+        size_t accepted = 0;
+        bool rejected = false;
+        for (size_t i = 0; i < draft_len && !rejected; ++i) {
+            const float* row = target_logits + i * n;
+            uint32_t token = draft_tokens[i];
+
+            if (greedy) {
+                // Greedy verification: accept while the draft matches
+                // the target argmax
+                uint32_t top = argmax(row);
+                if (token == top) {
+                    ++accepted;
+                } else {
+                    rejected = true;
+                    result.next_token = top;
+                }
+                continue;
+            }
+
+            softmaxWithTemperature(row, temperature);
+            float p = (token < n) ? probs_[token] : 0.0f;
+            float q = (token < n) ? draft_probs[i * n + token] : 1.0f;
+
+            // Accept with probability min(1, p/q); rejection resamples
+            // from the residual so the output matches the target model
+            if (q > 0.0f && uniform(rng_) * q < p) {
+                ++accepted;
+            } else {
+                rejected = true;
+                result.next_token = residualResample(row, draft_probs + i * n);
+            }
+        }
+
+        result.accepted_len = static_cast<uint32_t>(accepted);
+        result.all_accepted = !rejected;
+        if (result.all_accepted) {
+            // Bonus token from the extra target row, with the full
+            // configured sampling parameters
+            result.next_token = sampleLocked(target_logits + draft_len * n,
+                                             temperature, config_.top_k,
+                                             config_.top_p);
+        }
+    }
+
+    if (config_.enable_stats) {
+        drafts_verified_.fetch_add(1, std::memory_order_relaxed);
+        draft_tokens_accepted_.fetch_add(result.accepted_len,
+                                         std::memory_order_relaxed);
+        if (!result.all_accepted) {
+            draft_tokens_rejected_.fetch_add(1, std::memory_order_relaxed);
+        }
+        tokens_sampled_.fetch_add(1, std::memory_order_relaxed);
+        total_sample_time_us_.fetch_add(nowMicros() - start,
+                                        std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+Sampler::Statistics Sampler::getStatistics() const {
+    return Statistics{
+        .tokens_sampled = tokens_sampled_.load(std::memory_order_relaxed),
+        .greedy_samples = greedy_samples_.load(std::memory_order_relaxed),
+        .topk_truncations = topk_truncations_.load(std::memory_order_relaxed),
+        .topp_truncations = topp_truncations_.load(std::memory_order_relaxed),
+        .total_sample_time_us =
+            total_sample_time_us_.load(std::memory_order_relaxed),
+        .drafts_verified = drafts_verified_.load(std::memory_order_relaxed),
+        .draft_tokens_accepted =
+            draft_tokens_accepted_.load(std::memory_order_relaxed),
+        .draft_tokens_rejected =
+            draft_tokens_rejected_.load(std::memory_order_relaxed),
+    };
+}
+
+void Sampler::resetStatistics() {
+    tokens_sampled_.store(0, std::memory_order_relaxed);
+    greedy_samples_.store(0, std::memory_order_relaxed);
+    topk_truncations_.store(0, std::memory_order_relaxed);
+    topp_truncations_.store(0, std::memory_order_relaxed);
+    total_sample_time_us_.store(0, std::memory_order_relaxed);
+    drafts_verified_.store(0, std::memory_order_relaxed);
+    draft_tokens_accepted_.store(0, std::memory_order_relaxed);
+    draft_tokens_rejected_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace krserve
@@ -0,0 +1,381 @@
+#include "../include/kr_shared_memory_channel.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+namespace krserve {
+
+namespace {
+
+// Magic prefix identifying a channel segment
+constexpr char CHANNEL_MAGIC[8] = {'K', 'R', 'S', 'H', 'M', 'C', '1', '\0'};
+constexpr uint32_t CHANNEL_VERSION = 1;
+
+} // namespace
+
+// ============================================================================
+// Shared segment layout
+// ============================================================================
+
+/**
+ * Header at the start of the shared segment
+ *
+ * The four counters are monotonic (never wrap) and live on separate
+ * cache lines split by owner: head/alloc_mark are written only by the
+ * producer, tail/retire_mark only by the consumer. uint64 atomics are
+ * address-free on our targets, so they work across process mappings.
+ */
+struct SharedMemoryChannel::ChannelHeader {
+    char magic[8] = {};
+    uint32_t version = 0;
+    uint32_t ring_slots = 0;
+    uint64_t payload_bytes = 0;
+
+    // Producer-owned
+    alignas(64) std::atomic<uint64_t> head{0};        // next publish index
+    alignas(64) std::atomic<uint64_t> alloc_mark{0};  // payload bytes reserved
+
+    // Consumer-owned
+    alignas(64) std::atomic<uint64_t> tail{0};        // next pop index
+    alignas(64) std::atomic<uint64_t> retire_mark{0}; // payload bytes retired
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "channel counters must be lock-free to be shared across processes");
+
+// ============================================================================
+// Construction / teardown
+// ============================================================================
+
+SharedMemoryChannel::SharedMemoryChannel(const SharedMemoryChannelConfig& config)
+    : config_(config) {
+    validateConfig();
+
+    if (config_.create) {
+        createSegment();
+    } else {
+        attachSegment();
+    }
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+    closeSegment();
+}
+
+void SharedMemoryChannel::validateConfig() const {
+    if (config_.name.empty() || config_.name[0] != '/') {
+        throw std::invalid_argument(
+            "SharedMemoryChannel: name must be a POSIX shm name starting with '/'");
+    }
+    if (config_.payload_mb == 0) {
+        throw std::invalid_argument("SharedMemoryChannel: payload_mb must be > 0");
+    }
+    if (config_.ring_slots == 0 ||
+        (config_.ring_slots & (config_.ring_slots - 1)) != 0) {
+        throw std::invalid_argument(
+            "SharedMemoryChannel: ring_slots must be a power of two");
+    }
+}
+
+void SharedMemoryChannel::createSegment() {
+    uint64_t payload_bytes = static_cast<uint64_t>(config_.payload_mb) * 1024 * 1024;
+    size_t total = sizeof(ChannelHeader) +
+                   static_cast<size_t>(config_.ring_slots) * sizeof(ShmDescriptor) +
+                   payload_bytes;
+
+    shm_fd_ = shm_open(config_.name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (shm_fd_ < 0) {
+        throw std::runtime_error("SharedMemoryChannel: shm_open('" + config_.name +
+                                 "') failed: " + std::strerror(errno));
+    }
+
+    if (ftruncate(shm_fd_, static_cast<off_t>(total)) != 0) {
+        int saved_errno = errno;
+        close(shm_fd_);
+        shm_fd_ = -1;
+        shm_unlink(config_.name.c_str());
+        throw std::runtime_error("SharedMemoryChannel: ftruncate failed: " +
+                                 std::string(std::strerror(saved_errno)));
+    }
+
+    void* mapped = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd_, 0);
+    if (mapped == MAP_FAILED) {
+        int saved_errno = errno;
+        close(shm_fd_);
+        shm_fd_ = -1;
+        shm_unlink(config_.name.c_str());
+        throw std::runtime_error("SharedMemoryChannel: mmap failed: " +
+                                 std::string(std::strerror(saved_errno)));
+    }
+
+    owner_ = true;
+    map_base_ = static_cast<uint8_t*>(mapped);
+    map_size_ = total;
+
+    // Initialize the header in place; counters start at zero
+    header_ = new (map_base_) ChannelHeader();
+    std::memcpy(header_->magic, CHANNEL_MAGIC, sizeof(CHANNEL_MAGIC));
+    header_->version = CHANNEL_VERSION;
+    header_->ring_slots = config_.ring_slots;
+    header_->payload_bytes = payload_bytes;
+
+    ring_ = reinterpret_cast<ShmDescriptor*>(map_base_ + sizeof(ChannelHeader));
+    payload_ = map_base_ + sizeof(ChannelHeader) +
+               static_cast<size_t>(config_.ring_slots) * sizeof(ShmDescriptor);
+    payload_bytes_ = payload_bytes;
+
+    std::cerr << "[SharedMemoryChannel] Created '" << config_.name << "': "
+              << config_.payload_mb << " MB payload, "
+              << config_.ring_slots << " ring slots" << std::endl;
+}
+
+void SharedMemoryChannel::attachSegment() {
+    shm_fd_ = shm_open(config_.name.c_str(), O_RDWR, 0);
+    if (shm_fd_ < 0) {
+        throw std::runtime_error("SharedMemoryChannel: shm_open('" + config_.name +
+                                 "') failed: " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(shm_fd_, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(ChannelHeader)) {
+        close(shm_fd_);
+        shm_fd_ = -1;
+        throw std::runtime_error(
+            "SharedMemoryChannel: segment too small for a channel header");
+    }
+
+    size_t total = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd_, 0);
+    if (mapped == MAP_FAILED) {
+        int saved_errno = errno;
+        close(shm_fd_);
+        shm_fd_ = -1;
+        throw std::runtime_error("SharedMemoryChannel: mmap failed: " +
+                                 std::string(std::strerror(saved_errno)));
+    }
+
+    map_base_ = static_cast<uint8_t*>(mapped);
+    map_size_ = total;
+    header_ = reinterpret_cast<ChannelHeader*>(map_base_);
+
+    if (std::memcmp(header_->magic, CHANNEL_MAGIC, sizeof(CHANNEL_MAGIC)) != 0 ||
+        header_->version != CHANNEL_VERSION) {
+        closeSegment();
+        throw std::runtime_error("SharedMemoryChannel: '" + config_.name +
+                                 "' is not a compatible channel segment");
+    }
+
+    // Geometry comes from the creator, not from our config
+    size_t expected = sizeof(ChannelHeader) +
+                      static_cast<size_t>(header_->ring_slots) * sizeof(ShmDescriptor) +
+                      header_->payload_bytes;
+    if (total < expected) {
+        closeSegment();
+        throw std::runtime_error("SharedMemoryChannel: truncated segment '" +
+                                 config_.name + "'");
+    }
+
+    ring_ = reinterpret_cast<ShmDescriptor*>(map_base_ + sizeof(ChannelHeader));
+    payload_ = map_base_ + sizeof(ChannelHeader) +
+               static_cast<size_t>(header_->ring_slots) * sizeof(ShmDescriptor);
+    payload_bytes_ = header_->payload_bytes;
+
+    std::cerr << "[SharedMemoryChannel] Attached '" << config_.name << "': "
+              << (payload_bytes_ / (1024 * 1024)) << " MB payload, "
+              << header_->ring_slots << " ring slots" << std::endl;
+}
+
+void SharedMemoryChannel::closeSegment() {
+    if (map_base_) {
+        munmap(map_base_, map_size_);
+        map_base_ = nullptr;
+        map_size_ = 0;
+        header_ = nullptr;
+        ring_ = nullptr;
+        payload_ = nullptr;
+    }
+    if (shm_fd_ >= 0) {
+        close(shm_fd_);
+        shm_fd_ = -1;
+    }
+    if (owner_ && config_.unlink_on_close) {
+        shm_unlink(config_.name.c_str());
+    }
+}
+
+// ============================================================================
+// Producer side
+// ============================================================================
+
+uint64_t SharedMemoryChannel::reserve(uint64_t size) {
+    if (size == 0 || size > payload_bytes_) {
+        if (config_.enable_stats) {
+            payload_full_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return INVALID_OFFSET;
+    }
+
+    uint64_t alloc = header_->alloc_mark.load(std::memory_order_relaxed);
+
+    // Keep every reservation contiguous in the mapping: skip the ring
+    // tail when the request would straddle the wrap point. The skipped
+    // gap is retired automatically when a later message is released.
+    uint64_t start = alloc;
+    uint64_t pos = alloc % payload_bytes_;
+    if (pos + size > payload_bytes_) {
+        start = alloc + (payload_bytes_ - pos);
+    }
+
+    uint64_t retired = header_->retire_mark.load(std::memory_order_acquire);
+    if (start + size - retired > payload_bytes_) {
+        if (config_.enable_stats) {
+            payload_full_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return INVALID_OFFSET;
+    }
+
+    header_->alloc_mark.store(start + size, std::memory_order_relaxed);
+    return start;
+}
+
+bool SharedMemoryChannel::publish(uint64_t offset, uint64_t length, uint32_t tag,
+                                  uint32_t flags, bool zero_copy) {
+    uint32_t slots = header_->ring_slots;
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    uint64_t tail = header_->tail.load(std::memory_order_acquire);
+
+    if (head - tail >= slots) {
+        if (config_.enable_stats) {
+            ring_full_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    ShmDescriptor& slot = ring_[head & (slots - 1)];
+    slot.offset = offset;
+    slot.length = length;
+    slot.tag = tag;
+    slot.flags = flags;
+    slot.sequence = head;
+    slot.retire_mark = offset + length;
+
+    // Release-publish: all payload writes above become visible to the
+    // consumer's acquire load of head
+    header_->head.store(head + 1, std::memory_order_release);
+
+    if (config_.enable_stats) {
+        messages_sent_.fetch_add(1, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(length, std::memory_order_relaxed);
+        if (zero_copy) {
+            zero_copy_sends_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+bool SharedMemoryChannel::commit(uint64_t offset, uint64_t length, uint32_t tag,
+                                 uint32_t flags) {
+    return publish(offset, length, tag, flags, true);
+}
+
+bool SharedMemoryChannel::trySend(const void* data, uint64_t size, uint32_t tag,
+                                  uint32_t flags) {
+    uint64_t alloc_before = header_->alloc_mark.load(std::memory_order_relaxed);
+
+    uint64_t offset = reserve(size);
+    if (offset == INVALID_OFFSET) {
+        return false;
+    }
+
+    std::memcpy(payloadAt(offset), data, size);
+
+    if (!publish(offset, size, tag, flags, false)) {
+        // Ring full: roll the reservation back (safe — single producer,
+        // nothing else reserved in between)
+        header_->alloc_mark.store(alloc_before, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Consumer side
+// ============================================================================
+
+bool SharedMemoryChannel::tryReceive(ShmDescriptor& out) {
+    uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    uint64_t head = header_->head.load(std::memory_order_acquire);
+
+    if (tail == head) {
+        return false;
+    }
+
+    out = ring_[tail & (header_->ring_slots - 1)];
+    header_->tail.store(tail + 1, std::memory_order_release);
+
+    if (config_.enable_stats) {
+        messages_received_.fetch_add(1, std::memory_order_relaxed);
+        bytes_received_.fetch_add(out.length, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void SharedMemoryChannel::release(const ShmDescriptor& descriptor) {
+    // Monotonic watermark: releasing in FIFO order also retires any
+    // wrap gap the producer skipped before this message
+    header_->retire_mark.store(descriptor.retire_mark, std::memory_order_release);
+}
+
+// ============================================================================
+// Introspection
+// ============================================================================
+
+uint8_t* SharedMemoryChannel::payloadAt(uint64_t offset) const {
+    return payload_ + (offset % payload_bytes_);
+}
+
+size_t SharedMemoryChannel::payloadCapacity() const {
+    return static_cast<size_t>(payload_bytes_);
+}
+
+size_t SharedMemoryChannel::pendingCount() const {
+    uint64_t tail = header_->tail.load(std::memory_order_acquire);
+    uint64_t head = header_->head.load(std::memory_order_acquire);
+    return static_cast<size_t>(head - tail);
+}
+
+void SharedMemoryChannel::unlinkSegment(const std::string& name) {
+    shm_unlink(name.c_str());
+}
+
+SharedMemoryChannelStatistics SharedMemoryChannel::getStatistics() const {
+    return {
+        .messages_sent = messages_sent_.load(),
+        .messages_received = messages_received_.load(),
+        .bytes_sent = bytes_sent_.load(),
+        .bytes_received = bytes_received_.load(),
+        .ring_full = ring_full_.load(),
+        .payload_full = payload_full_.load(),
+        .zero_copy_sends = zero_copy_sends_.load()
+    };
+}
+
+void SharedMemoryChannel::resetStatistics() {
+    messages_sent_ = 0;
+    messages_received_ = 0;
+    bytes_sent_ = 0;
+    bytes_received_ = 0;
+    ring_full_ = 0;
+    payload_full_ = 0;
+    zero_copy_sends_ = 0;
+}
+
+} // namespace krserve
@@ -0,0 +1,152 @@
+#include "../include/kr_stream_context_pool.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace krserve {
+
+// ============================================================================
+// Construction / teardown
+// ============================================================================
+
+StreamContextPool::StreamContextPool(const Config& config,
+                                     ParallelTokenizer* tokenizer)
+    : config_(config), tokenizer_(tokenizer), arena_pool_(config.arena) {
+    validateConfig();
+
+    free_contexts_.reserve(config_.max_pooled_contexts);
+    for (size_t i = 0; i < config_.initial_contexts; ++i) {
+        free_contexts_.push_back(std::shared_ptr<StreamContext>(
+            new StreamContext(&arena_pool_, config_.vocab_size)));
+        contexts_created_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::cerr << "[StreamContextPool] Initialized: vocab_size="
+              << config_.vocab_size
+              << ", warm=" << config_.initial_contexts
+              << ", max_pooled=" << config_.max_pooled_contexts
+              << ", tokenizer=" << (tokenizer_ ? "attached" : "none")
+              << std::endl;
+}
+
+StreamContextPool::~StreamContextPool() = default;
+
+void StreamContextPool::validateConfig() const {
+    if (config_.vocab_size == 0) {
+        throw std::invalid_argument("StreamContextPool: vocab_size must be > 0");
+    }
+    if (config_.max_pooled_contexts == 0) {
+        throw std::invalid_argument(
+            "StreamContextPool: max_pooled_contexts must be > 0");
+    }
+    if (config_.initial_contexts > config_.max_pooled_contexts) {
+        throw std::invalid_argument(
+            "StreamContextPool: initial_contexts exceeds max_pooled_contexts");
+    }
+}
+
+// ============================================================================
+// Acquire / release
+// ============================================================================
+
+std::shared_ptr<StreamContext> StreamContextPool::acquireContext() {
+    std::shared_ptr<StreamContext> context;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!free_contexts_.empty()) {
+            context = std::move(free_contexts_.back());
+            free_contexts_.pop_back();
+        }
+    }
+
+    if (context) {
+        if (config_.enable_stats) {
+            freelist_hits_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        context = std::shared_ptr<StreamContext>(
+            new StreamContext(&arena_pool_, config_.vocab_size));
+        if (config_.enable_stats) {
+            contexts_created_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    context->stream_id_ = next_stream_id_.fetch_add(1, std::memory_order_relaxed);
+
+    // Pooled detokenizer, handed out reset by the tokenizer
+    if (tokenizer_ && tokenizer_->hasNativeEngine()) {
+        context->decoder_ = tokenizer_->acquireStreamDecoder();
+    }
+
+    if (config_.enable_stats) {
+        acquires_.fetch_add(1, std::memory_order_relaxed);
+        contexts_active_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return context;
+}
+
+void StreamContextPool::releaseContext(std::shared_ptr<StreamContext> context) {
+    if (!context) return;
+
+    // Return the decoder through the tokenizer's pool so stream-token
+    // stats fold in and vocabulary-swap checks apply
+    if (context->decoder_) {
+        if (tokenizer_) {
+            tokenizer_->releaseStreamDecoder(std::move(context->decoder_));
+        }
+        context->decoder_ = nullptr;
+    }
+
+    context->resetForReuse();
+
+    if (config_.enable_stats) {
+        releases_.fetch_add(1, std::memory_order_relaxed);
+        contexts_active_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (free_contexts_.size() < config_.max_pooled_contexts) {
+            free_contexts_.push_back(std::move(context));
+            return;
+        }
+    }
+
+    // Freelist full: drop the context (its arena blocks already
+    // recycled through the arena pool in resetForReuse)
+    if (config_.enable_stats) {
+        contexts_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Introspection
+// ============================================================================
+
+size_t StreamContextPool::pooledCount() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return free_contexts_.size();
+}
+
+StreamContextPool::Statistics StreamContextPool::getStatistics() const {
+    return {
+        .contexts_created = contexts_created_.load(),
+        .acquires = acquires_.load(),
+        .releases = releases_.load(),
+        .freelist_hits = freelist_hits_.load(),
+        .contexts_dropped = contexts_dropped_.load(),
+        .contexts_pooled = pooledCount(),
+        .contexts_active = static_cast<size_t>(contexts_active_.load())
+    };
+}
+
+void StreamContextPool::resetStatistics() {
+    contexts_created_ = 0;
+    acquires_ = 0;
+    releases_ = 0;
+    freelist_hits_ = 0;
+    contexts_dropped_ = 0;
+}
+
+} // namespace krserve
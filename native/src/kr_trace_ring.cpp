@@ -0,0 +1,335 @@
+#include "kr_trace_ring.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+// mach_absolute_time (monotonic, ~40ns to read on Apple Silicon)
+#ifdef __APPLE__
+#include <mach/mach_time.h>
+#define HAS_MACH_TIME 1
+#else
+#define HAS_MACH_TIME 0
+#endif
+
+namespace krserve {
+
+namespace {
+
+/**
+ * Round up to the next power of two (minimum 2)
+ */
+uint32_t nextPowerOfTwo(uint32_t v) {
+    if (v < 2) return 2;
+    --v;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return v + 1;
+}
+
+} // namespace
+
+// ============================================================================
+// Timestamps
+// ============================================================================
+
+uint64_t TraceRing::nowNanos() {
+#if HAS_MACH_TIME
+    static mach_timebase_info_data_t timebase = [] {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return info;
+    }();
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TraceRing& TraceRing::instance() {
+    // Leaked intentionally: emitting threads may outlive static destructors
+    static TraceRing* ring = new TraceRing();
+    return *ring;
+}
+
+TraceRing::TraceRing() = default;
+
+TraceRing::~TraceRing() {
+    stopDraining();
+}
+
+TraceRing::ThreadRing::ThreadRing(uint32_t capacity_pow2, uint32_t index)
+    : events(new Event[capacity_pow2]),
+      capacity(capacity_pow2),
+      thread_index(index) {}
+
+void TraceRing::configure(const Config& config) {
+    if (config.events_per_thread == 0) {
+        throw std::invalid_argument("events_per_thread must be > 0");
+    }
+    if (config.max_buffered_events == 0) {
+        throw std::invalid_argument("max_buffered_events must be > 0");
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    config_ = config;
+    config_.events_per_thread = nextPowerOfTwo(config.events_per_thread);
+}
+
+TraceRing::Config TraceRing::getConfig() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return config_;
+}
+
+void TraceRing::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Emit path (lock-free)
+// ============================================================================
+
+TraceRing::ThreadRing* TraceRing::localRing() {
+    static thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        auto owned = std::make_unique<ThreadRing>(
+            nextPowerOfTwo(config_.events_per_thread),
+            static_cast<uint32_t>(rings_.size()));
+        ring = owned.get();
+        rings_.push_back(std::move(owned));
+    }
+    return ring;
+}
+
+void TraceRing::emit(const char* name, const char* category,
+                     uint64_t request_id, Phase phase) {
+    ThreadRing* ring = localRing();
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail >= ring->capacity) {
+        // Ring full: drop rather than stall or overwrite in-flight reads
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& slot = ring->events[head & (ring->capacity - 1)];
+    slot.timestamp_ns = nowNanos();
+    slot.request_id = request_id;
+    slot.name = name;
+    slot.category = category;
+    slot.phase = phase;
+
+    ring->head.store(head + 1, std::memory_order_release);
+    ring->emitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TraceRing::beginSpan(const char* name, const char* category,
+                          uint64_t request_id) {
+    if (!isEnabled()) return;
+    emit(name, category, request_id, Phase::Begin);
+}
+
+void TraceRing::endSpan(const char* name, const char* category,
+                        uint64_t request_id) {
+    if (!isEnabled()) return;
+    emit(name, category, request_id, Phase::End);
+}
+
+void TraceRing::instant(const char* name, const char* category,
+                        uint64_t request_id) {
+    if (!isEnabled()) return;
+    emit(name, category, request_id, Phase::Instant);
+}
+
+void TraceRing::beginAsync(const char* name, const char* category,
+                           uint64_t request_id) {
+    if (!isEnabled()) return;
+    emit(name, category, request_id, Phase::AsyncBegin);
+}
+
+void TraceRing::endAsync(const char* name, const char* category,
+                         uint64_t request_id) {
+    if (!isEnabled()) return;
+    emit(name, category, request_id, Phase::AsyncEnd);
+}
+
+// ============================================================================
+// Draining
+// ============================================================================
+
+void TraceRing::drainAll() {
+    std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+
+    for (auto& ring : rings_) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+
+        while (tail < head) {
+            if (buffered_.size() >= config_.max_buffered_events) {
+                // Export buffer full: drop oldest to keep the tail of
+                // the capture (the interesting end for stall hunting)
+                size_t drop = buffered_.size() / 2;
+                buffered_.erase(buffered_.begin(),
+                                buffered_.begin() + drop);
+                buffer_overflow_drops_ += drop;
+            }
+            BufferedEvent out;
+            out.event = ring->events[tail & (ring->capacity - 1)];
+            out.thread_index = ring->thread_index;
+            buffered_.push_back(out);
+            ++tail;
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void TraceRing::drainLoop() {
+    while (drain_running_.load(std::memory_order_relaxed)) {
+        drainAll();
+
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        drain_cv_.wait_for(lock,
+                           std::chrono::milliseconds(getConfig().drain_interval_ms),
+                           [this]() {
+                               return !drain_running_.load(std::memory_order_relaxed);
+                           });
+    }
+}
+
+void TraceRing::startDraining() {
+    bool expected = false;
+    if (!drain_running_.compare_exchange_strong(expected, true)) {
+        return;  // Already running
+    }
+    drain_thread_ = std::thread([this]() { drainLoop(); });
+    std::cerr << "[TraceRing] Drain thread started" << std::endl;
+}
+
+void TraceRing::stopDraining() {
+    if (!drain_running_.exchange(false)) {
+        return;
+    }
+    drain_cv_.notify_all();
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+    std::cerr << "[TraceRing] Drain thread stopped" << std::endl;
+}
+
+// ============================================================================
+// Export
+// ============================================================================
+
+std::string TraceRing::exportChromeTrace() {
+    drainAll();
+
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+
+    std::string json;
+    json.reserve(buffered_.size() * 128 + 64);
+    json += "{\"traceEvents\":[";
+
+    bool first = true;
+    char entry[256];
+    for (const auto& buffered : buffered_) {
+        const Event& e = buffered.event;
+        const char* phase = "i";
+        bool is_async = false;
+        switch (e.phase) {
+            case Phase::Begin: phase = "B"; break;
+            case Phase::End: phase = "E"; break;
+            case Phase::Instant: phase = "i"; break;
+            case Phase::AsyncBegin: phase = "b"; is_async = true; break;
+            case Phase::AsyncEnd: phase = "e"; is_async = true; break;
+        }
+
+        // Chrome trace timestamps are microseconds; async spans carry an
+        // "id" so begin/end pair across threads
+        double ts_us = static_cast<double>(e.timestamp_ns) / 1000.0;
+        char id_field[32] = "";
+        if (is_async) {
+            snprintf(id_field, sizeof(id_field), ",\"id\":%llu",
+                     static_cast<unsigned long long>(e.request_id));
+        }
+
+        int written = snprintf(
+            entry, sizeof(entry),
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,"
+            "\"pid\":1,\"tid\":%u%s,\"args\":{\"request_id\":%llu}%s}",
+            first ? "" : ",",
+            e.name ? e.name : "?",
+            e.category ? e.category : "?",
+            phase, ts_us, buffered.thread_index, id_field,
+            static_cast<unsigned long long>(e.request_id),
+            e.phase == Phase::Instant ? ",\"s\":\"t\"" : "");
+        if (written > 0) {
+            json.append(entry, static_cast<size_t>(written));
+        }
+        first = false;
+    }
+
+    json += "]}";
+    return json;
+}
+
+void TraceRing::clear() {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (auto& ring : rings_) {
+            ring->tail.store(ring->head.load(std::memory_order_acquire),
+                             std::memory_order_release);
+        }
+    }
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    buffered_.clear();
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+TraceRing::Statistics TraceRing::getStatistics() const {
+    uint64_t emitted = 0;
+    uint64_t dropped = 0;
+    uint32_t threads = 0;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        threads = static_cast<uint32_t>(rings_.size());
+        for (const auto& ring : rings_) {
+            emitted += ring->emitted.load(std::memory_order_relaxed);
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t buffered;
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        buffered = buffered_.size();
+        dropped += buffer_overflow_drops_;
+    }
+
+    return Statistics{
+        .events_emitted = emitted,
+        .events_dropped = dropped,
+        .events_buffered = buffered,
+        .threads_registered = threads,
+        .enabled = enabled_.load(std::memory_order_relaxed),
+        .draining = drain_running_.load(std::memory_order_relaxed),
+    };
+}
+
+} // namespace krserve
@@ -1,12 +1,16 @@
 #include "../include/kr_weight_manager.h"
+#include <Accelerate/Accelerate.h>
 #include <sys/mman.h>
 #include <sys/resource.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <cstring>
+#include <cctype>
+#include <stdexcept>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 namespace krserve {
 
@@ -232,11 +236,32 @@ void WeightManager::prefetchLayer(int layer_index, const std::vector<id<MTLBuffe
         return;
     }
 
-    // Prefetch next 1-2 layers in background
-    int num_to_prefetch = 2;
-    for (int next = layer_index + 1;
-         next <= layer_index + num_to_prefetch && next < static_cast<int>(weights.size());
-         ++next) {
+    // Decide which layers to prefetch: learned predictions when the
+    // transition table has seen this layer, sequential next-layer otherwise
+    std::vector<int> targets;
+    if (config_.adaptive_prefetch) {
+        targets = predictNextLayers(layer_index, config_.prefetch_candidates);
+    }
+
+    if (targets.empty()) {
+        // Sequential fallback: next 1-2 layers (dense models, cold table)
+        if (config_.adaptive_prefetch) {
+            sequential_fallbacks_++;
+        }
+        int num_to_prefetch = 2;
+        for (int next = layer_index + 1;
+             next <= layer_index + num_to_prefetch && next < static_cast<int>(weights.size());
+             ++next) {
+            targets.push_back(next);
+        }
+    } else {
+        predicted_prefetches_ += targets.size();
+    }
+
+    for (int next : targets) {
+        if (next < 0 || next >= static_cast<int>(weights.size())) {
+            continue;
+        }
 
         id<MTLBuffer> buffer = weights[next];
         if (!buffer) {
@@ -256,6 +281,56 @@ void WeightManager::prefetchLayer(int layer_index, const std::vector<id<MTLBuffe
     }
 }
 
+void WeightManager::recordLayerAccess(int layer_index) {
+    if (!config_.adaptive_prefetch || layer_index < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(transitions_mutex_);
+    if (last_accessed_layer_ >= 0 && last_accessed_layer_ != layer_index) {
+        transitions_[last_accessed_layer_][layer_index]++;
+        accesses_recorded_++;
+    }
+    last_accessed_layer_ = layer_index;
+}
+
+void WeightManager::resetAccessPattern() {
+    std::lock_guard<std::mutex> lock(transitions_mutex_);
+    transitions_.clear();
+    last_accessed_layer_ = -1;
+
+    std::cerr << "[WeightManager] Access pattern reset" << std::endl;
+}
+
+std::vector<int> WeightManager::predictNextLayers(int layer_index,
+                                                  uint32_t max_candidates) const {
+    std::vector<int> predictions;
+    if (max_candidates == 0) {
+        return predictions;
+    }
+
+    std::lock_guard<std::mutex> lock(transitions_mutex_);
+
+    auto it = transitions_.find(layer_index);
+    if (it == transitions_.end() || it->second.empty()) {
+        return predictions;
+    }
+
+    // Rank observed successors by frequency, take the top max_candidates
+    std::vector<std::pair<int, uint64_t>> successors(it->second.begin(),
+                                                     it->second.end());
+    std::sort(successors.begin(), successors.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    for (const auto& [layer, count] : successors) {
+        predictions.push_back(layer);
+        if (predictions.size() >= max_candidates) {
+            break;
+        }
+    }
+    return predictions;
+}
+
 void WeightManager::warmupModel(size_t buffer_size_mb) {
     if (!config_.warmup_on_load) {
         return;
@@ -367,6 +442,485 @@ id<MTLBuffer> WeightManager::loadWeightsMapped(const std::string& path, id<MTLDe
     return buffer;
 }
 
+namespace {
+
+/**
+ * Minimal scanner for the safetensors JSON header
+ *
+ * The header is a flat object: {"name": {"dtype": "...", "shape": [...],
+ * "data_offsets": [begin, end]}, ..., "__metadata__": {...}}. We only need
+ * those three fields, so a positional scan is enough — no JSON library.
+ */
+class SafetensorsHeaderParser {
+public:
+    SafetensorsHeaderParser(const char* json, size_t len)
+        : json_(json), len_(len), pos_(0) {}
+
+    void parse(std::unordered_map<std::string, SafetensorsTensorView>& out) {
+        expect('{');
+
+        while (true) {
+            skipWhitespace();
+            if (pos_ >= len_ || json_[pos_] == '}') {
+                break;
+            }
+
+            std::string key = parseString();
+            skipWhitespace();
+            expect(':');
+
+            if (key == "__metadata__") {
+                skipValue();
+            } else {
+                out[key] = parseTensorEntry();
+            }
+
+            skipWhitespace();
+            if (pos_ < len_ && json_[pos_] == ',') {
+                ++pos_;
+            }
+        }
+    }
+
+private:
+    const char* json_;
+    size_t len_;
+    size_t pos_;
+
+    void skipWhitespace() {
+        while (pos_ < len_ && std::isspace(static_cast<unsigned char>(json_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    void expect(char c) {
+        skipWhitespace();
+        if (pos_ >= len_ || json_[pos_] != c) {
+            throw std::runtime_error(
+                std::string("Safetensors header: expected '") + c + "'");
+        }
+        ++pos_;
+    }
+
+    std::string parseString() {
+        skipWhitespace();
+        if (pos_ >= len_ || json_[pos_] != '"') {
+            throw std::runtime_error("Safetensors header: expected string");
+        }
+        ++pos_;
+
+        std::string out;
+        while (pos_ < len_ && json_[pos_] != '"') {
+            if (json_[pos_] == '\\' && pos_ + 1 < len_) {
+                // Header keys/dtypes are plain ASCII; keep escapes verbatim
+                out += json_[pos_ + 1];
+                pos_ += 2;
+            } else {
+                out += json_[pos_];
+                ++pos_;
+            }
+        }
+        ++pos_; // closing quote
+        return out;
+    }
+
+    size_t parseInteger() {
+        skipWhitespace();
+        size_t start = pos_;
+        while (pos_ < len_ && std::isdigit(static_cast<unsigned char>(json_[pos_]))) {
+            ++pos_;
+        }
+        if (pos_ == start) {
+            throw std::runtime_error("Safetensors header: expected integer");
+        }
+        return static_cast<size_t>(
+            std::stoull(std::string(json_ + start, pos_ - start)));
+    }
+
+    std::vector<size_t> parseIntegerArray() {
+        std::vector<size_t> out;
+        expect('[');
+        skipWhitespace();
+        while (pos_ < len_ && json_[pos_] != ']') {
+            out.push_back(parseInteger());
+            skipWhitespace();
+            if (pos_ < len_ && json_[pos_] == ',') {
+                ++pos_;
+            }
+        }
+        expect(']');
+        return out;
+    }
+
+    SafetensorsTensorView parseTensorEntry() {
+        SafetensorsTensorView view;
+        size_t begin = 0;
+        size_t end = 0;
+
+        expect('{');
+        while (true) {
+            skipWhitespace();
+            if (pos_ >= len_ || json_[pos_] == '}') {
+                break;
+            }
+
+            std::string field = parseString();
+            expect(':');
+
+            if (field == "dtype") {
+                view.dtype = parseString();
+            } else if (field == "shape") {
+                for (size_t dim : parseIntegerArray()) {
+                    view.shape.push_back(dim);
+                }
+            } else if (field == "data_offsets") {
+                auto offsets = parseIntegerArray();
+                if (offsets.size() != 2) {
+                    throw std::runtime_error(
+                        "Safetensors header: data_offsets must have 2 entries");
+                }
+                begin = offsets[0];
+                end = offsets[1];
+            } else {
+                skipValue();
+            }
+
+            skipWhitespace();
+            if (pos_ < len_ && json_[pos_] == ',') {
+                ++pos_;
+            }
+        }
+        expect('}');
+
+        if (end < begin) {
+            throw std::runtime_error("Safetensors header: invalid data_offsets");
+        }
+        view.offset = begin;
+        view.length = end - begin;
+        return view;
+    }
+
+    // Skip any JSON value (balanced braces/brackets, strings respected)
+    void skipValue() {
+        skipWhitespace();
+        if (pos_ >= len_) return;
+
+        char c = json_[pos_];
+        if (c == '{' || c == '[') {
+            char open = c;
+            char close = (c == '{') ? '}' : ']';
+            int depth = 0;
+            while (pos_ < len_) {
+                char cur = json_[pos_];
+                if (cur == '"') {
+                    parseString();
+                    continue;
+                }
+                if (cur == open) ++depth;
+                if (cur == close) {
+                    --depth;
+                    if (depth == 0) {
+                        ++pos_;
+                        return;
+                    }
+                }
+                ++pos_;
+            }
+        } else if (c == '"') {
+            parseString();
+        } else {
+            // Number / literal: scan to delimiter
+            while (pos_ < len_ && json_[pos_] != ',' &&
+                   json_[pos_] != '}' && json_[pos_] != ']') {
+                ++pos_;
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+SafetensorsModel WeightManager::loadSafetensorsMapped(
+    const std::string& path,
+    id<MTLDevice> device
+) {
+    SafetensorsModel model;
+
+    // Map the whole file via the existing zero-copy path
+    model.buffer = loadWeightsMapped(path, device);
+    if (!model.buffer) {
+        throw std::runtime_error("Failed to map safetensors file: " + path);
+    }
+
+    model.file_size = [model.buffer length];
+
+    const char* base = static_cast<const char*>([model.buffer contents]);
+
+    // First 8 bytes: little-endian u64 header length
+    if (model.file_size < 8) {
+        throw std::runtime_error("Safetensors file too small: " + path);
+    }
+
+    uint64_t header_len = 0;
+    memcpy(&header_len, base, sizeof(header_len));
+
+    if (header_len == 0 || 8 + header_len > model.file_size) {
+        throw std::runtime_error("Safetensors header length out of bounds: " + path);
+    }
+
+    model.data_offset = 8 + static_cast<size_t>(header_len);
+
+    // Parse header and rebase tensor offsets to absolute buffer offsets
+    SafetensorsHeaderParser parser(base + 8, static_cast<size_t>(header_len));
+    parser.parse(model.tensors);
+
+    for (auto& entry : model.tensors) {
+        SafetensorsTensorView& view = entry.second;
+        view.offset += model.data_offset;
+
+        if (view.offset + view.length > model.file_size) {
+            throw std::runtime_error(
+                "Safetensors tensor out of bounds: " + entry.first);
+        }
+    }
+
+    std::cerr << "[WeightManager] Safetensors mapped: " << path << " ("
+              << model.tensors.size() << " tensors, "
+              << (model.file_size / (1024 * 1024)) << " MB, zero-copy)"
+              << std::endl;
+
+    return model;
+}
+
+void WeightManager::warmSafetensorsParallel(
+    const SafetensorsModel& model,
+    const std::vector<id<MTLBuffer>>& critical_layers
+) {
+    if (!model.buffer || model.file_size == 0) {
+        std::cerr << "[WeightManager] warmSafetensorsParallel: model not mapped" << std::endl;
+        return;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    char* base = static_cast<char*>([model.buffer contents]);
+    size_t page_size = getpagesize();  // 16KB on Apple Silicon
+
+    // Warm the tensor data section (the header was already read by the
+    // parser), page-aligned so shard madvise calls don't overlap
+    size_t warm_start = (model.data_offset / page_size) * page_size;
+    size_t warm_bytes = model.file_size - warm_start;
+
+    uint32_t num_shards = config_.prefetch_threads > 0 ? config_.prefetch_threads : 1;
+    size_t shard_bytes = (warm_bytes + num_shards - 1) / num_shards;
+    shard_bytes = ((shard_bytes + page_size - 1) / page_size) * page_size;
+
+    // Completion tracking shared with the workers
+    struct WarmSync {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint32_t remaining = 0;
+    };
+    auto sync = std::make_shared<WarmSync>();
+
+    // Retain the mapped buffer for the workers (ARC management)
+    id<MTLBuffer> retained_buffer = model.buffer;
+
+    uint32_t shards_launched = 0;
+    for (size_t offset = warm_start; offset < model.file_size; offset += shard_bytes) {
+        size_t length = std::min(shard_bytes, model.file_size - offset);
+        ++shards_launched;
+
+        auto task = [this, sync, retained_buffer, base, offset, length, page_size]() {
+            char* shard = base + offset;
+
+            // Sequential readahead: the kernel streams each shard while
+            // the touch loop confirms residency behind it
+            madvise(shard, length, MADV_SEQUENTIAL);
+            madvise(shard, length, MADV_WILLNEED);
+
+            for (size_t pos = 0; pos < length; pos += page_size) {
+                volatile char dummy = shard[pos];
+                (void)dummy;
+            }
+
+            this->bytes_prefetched_ += length;
+            this->prefetch_ops_++;
+
+            {
+                std::lock_guard<std::mutex> lock(sync->mutex);
+                --sync->remaining;
+            }
+            sync->cv.notify_one();
+        };
+
+        if (thread_pool_) {
+            {
+                std::lock_guard<std::mutex> lock(sync->mutex);
+                ++sync->remaining;
+            }
+            thread_pool_->enqueue(std::move(task));
+        } else {
+            task();  // No pool: degrade to serial warm-in
+        }
+    }
+
+    // Overlap: pin critical layers on the calling thread while the
+    // workers stream pages in
+    if (config_.pin_critical_weights && !critical_layers.empty()) {
+        pinLayers(critical_layers, static_cast<int>(config_.critical_layers));
+    }
+
+    // Wait for all shards to become resident
+    {
+        std::unique_lock<std::mutex> lock(sync->mutex);
+        sync->cv.wait(lock, [&sync]() { return sync->remaining == 0; });
+    }
+
+    parallel_loads_++;
+
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    std::cerr << "[WeightManager] Parallel warm-in: "
+              << (warm_bytes / (1024 * 1024)) << " MB across "
+              << shards_launched << " shards in " << elapsed_ms << " ms"
+              << std::endl;
+}
+
+size_t WeightManager::dequantizeInt4ToFp16(
+    const void* packed,
+    size_t element_count,
+    const void* scales,
+    const void* biases,
+    size_t group_size,
+    id<MTLBuffer> dest,
+    size_t dest_offset
+) {
+    if (!packed || !scales || !biases || !dest) {
+        throw std::invalid_argument("dequantizeInt4ToFp16: null input");
+    }
+    if (element_count == 0) {
+        return 0;
+    }
+    if (group_size == 0 || group_size % 2 != 0) {
+        throw std::invalid_argument(
+            "dequantizeInt4ToFp16: group_size must be even and non-zero");
+    }
+    if (element_count % group_size != 0) {
+        throw std::invalid_argument(
+            "dequantizeInt4ToFp16: element_count must be a multiple of group_size");
+    }
+
+    size_t out_bytes = element_count * sizeof(uint16_t);
+    if (dest_offset + out_bytes > [dest length]) {
+        throw std::invalid_argument(
+            "dequantizeInt4ToFp16: destination buffer too small");
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    const uint8_t* src = static_cast<const uint8_t*>(packed);
+    const __fp16* scale16 = static_cast<const __fp16*>(scales);
+    const __fp16* bias16 = static_cast<const __fp16*>(biases);
+    uint16_t* out = reinterpret_cast<uint16_t*>(
+        static_cast<char*>([dest contents]) + dest_offset);
+
+    // Chunk boundaries land on group boundaries so every worker reads
+    // only its own scales/biases
+    size_t chunk_kb = config_.dequant_chunk_kb > 0 ? config_.dequant_chunk_kb : 512;
+    size_t chunk_elems = chunk_kb * 1024 * 2;  // two elements per source byte
+    chunk_elems = (chunk_elems / group_size) * group_size;
+    if (chunk_elems == 0) {
+        chunk_elems = group_size;
+    }
+
+    // Completion tracking shared with the workers
+    struct DequantSync {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint32_t remaining = 0;
+    };
+    auto sync = std::make_shared<DequantSync>();
+
+    // Retain the destination buffer for the workers (ARC management)
+    id<MTLBuffer> retained_dest = dest;
+    size_t page_size = getpagesize();
+
+    uint32_t chunks_launched = 0;
+    for (size_t first = 0; first < element_count; first += chunk_elems) {
+        size_t count = std::min(chunk_elems, element_count - first);
+        ++chunks_launched;
+
+        auto task = [this, sync, retained_dest, src, scale16, bias16, out,
+                     first, count, group_size, page_size]() {
+            // Kick off page-in for this slice up front: the kernel reads
+            // ahead while earlier chunks are still expanding
+            uintptr_t slice = reinterpret_cast<uintptr_t>(src + first / 2);
+            uintptr_t aligned = slice & ~static_cast<uintptr_t>(page_size - 1);
+            madvise(reinterpret_cast<void*>(aligned),
+                    count / 2 + (slice - aligned), MADV_WILLNEED);
+
+            // Unpack + scale into a chunk-sized float scratch buffer
+            // (this loop auto-vectorizes; memory stays bounded at one
+            // chunk per worker)
+            std::vector<float> scratch(count);
+            for (size_t g = 0; g < count; g += group_size) {
+                size_t group_index = (first + g) / group_size;
+                float scale = static_cast<float>(scale16[group_index]);
+                float bias = static_cast<float>(bias16[group_index]);
+                const uint8_t* bytes = src + (first + g) / 2;
+
+                for (size_t i = 0; i < group_size; i += 2) {
+                    uint8_t b = bytes[i / 2];
+                    scratch[g + i] = scale * static_cast<float>(b & 0x0F) + bias;
+                    scratch[g + i + 1] = scale * static_cast<float>(b >> 4) + bias;
+                }
+            }
+
+            // Vectorized float -> fp16 narrowing straight into dest
+            vImage_Buffer src_buf{scratch.data(), 1, count, count * sizeof(float)};
+            vImage_Buffer dst_buf{out + first, 1, count, count * sizeof(uint16_t)};
+            vImageConvert_PlanarFtoPlanar16F(&src_buf, &dst_buf, kvImageNoFlags);
+
+            this->dequant_chunks_++;
+
+            {
+                std::lock_guard<std::mutex> lock(sync->mutex);
+                --sync->remaining;
+            }
+            sync->cv.notify_one();
+        };
+
+        if (thread_pool_) {
+            {
+                std::lock_guard<std::mutex> lock(sync->mutex);
+                ++sync->remaining;
+            }
+            thread_pool_->enqueue(std::move(task));
+        } else {
+            task();  // No pool: degrade to serial dequantization
+        }
+    }
+
+    // Wait for the whole tensor to be expanded
+    {
+        std::unique_lock<std::mutex> lock(sync->mutex);
+        sync->cv.wait(lock, [&sync]() { return sync->remaining == 0; });
+    }
+
+    dequant_ops_++;
+    dequant_bytes_out_ += out_bytes;
+
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    std::cerr << "[WeightManager] Streaming dequant: "
+              << (out_bytes / (1024 * 1024)) << " MB fp16 across "
+              << chunks_launched << " chunks in " << elapsed_ms << " ms"
+              << std::endl;
+
+    return out_bytes;
+}
+
 WeightManagerStatistics WeightManager::getStatistics() const {
     WeightManagerStatistics stats;
     stats.weights_pinned = weights_pinned_.load();
@@ -379,6 +933,13 @@ WeightManagerStatistics WeightManager::getStatistics() const {
     stats.prefetch_ops = prefetch_ops_.load();
     stats.pin_failures = pin_failures_.load();
     stats.active_prefetch_tasks = active_prefetch_tasks_.load();
+    stats.accesses_recorded = accesses_recorded_.load();
+    stats.predicted_prefetches = predicted_prefetches_.load();
+    stats.sequential_fallbacks = sequential_fallbacks_.load();
+    stats.parallel_loads = parallel_loads_.load();
+    stats.dequant_ops = dequant_ops_.load();
+    stats.dequant_chunks = dequant_chunks_.load();
+    stats.dequant_bytes_out = dequant_bytes_out_.load();
     return stats;
 }
 
@@ -393,6 +954,13 @@ void WeightManager::resetStatistics() {
     prefetch_ops_ = 0;
     pin_failures_ = 0;
     active_prefetch_tasks_ = 0;
+    accesses_recorded_ = 0;
+    predicted_prefetches_ = 0;
+    sequential_fallbacks_ = 0;
+    parallel_loads_ = 0;
+    dequant_ops_ = 0;
+    dequant_chunks_ = 0;
+    dequant_bytes_out_ = 0;
 
     std::cerr << "[WeightManager] Statistics reset" << std::endl;
 }
@@ -521,6 +1089,13 @@ void WeightManager::prefetchAsync(id<MTLBuffer> buffer) {
 
     // Enqueue prefetch task
     thread_pool_->enqueue([this, retained_buffer]() {
+        // Ask the kernel to start paging the range in before we touch it
+        void* ptr = [retained_buffer contents];
+        size_t length = [retained_buffer length];
+        if (ptr && length > 0) {
+            madvise(ptr, length, MADV_WILLNEED);
+        }
+
         this->touchPages(retained_buffer);
         this->prefetch_ops_++;
     });
@@ -1,5 +1,4 @@
 #include "../include/kr_metrics_collector.h"
-#include <algorithm>
 #include <chrono>
 #include <cmath>
 
@@ -7,125 +6,163 @@ namespace krserve {
 
 using namespace std::chrono;
 
+namespace {
+
+uint64_t nowNs() {
+    return duration_cast<nanoseconds>(
+        system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 MetricsCollector::MetricsCollector()
-    : latency_samples_()
-    , throughput_window_start_ns_(duration_cast<nanoseconds>(
-          system_clock::now().time_since_epoch()).count())
-    , throughput_requests_(0)
+    : throughput_window_start_ns_(nowNs())
 {
-    latency_samples_.reserve(MAX_SAMPLES);
 }
 
 MetricsCollector::~MetricsCollector() = default;
 
+MetricsCollector::Shard& MetricsCollector::localShard() {
+    // Each thread claims a shard once; NUM_SHARDS is a power of two so the
+    // round-robin counter wraps cleanly when threads outnumber shards
+    thread_local size_t shard_index =
+        next_shard_.fetch_add(1, std::memory_order_relaxed) & (NUM_SHARDS - 1);
+    return shards_[shard_index];
+}
+
+size_t MetricsCollector::bucketFor(uint64_t latency_ns) {
+    if (latency_ns < SUB_BUCKETS) {
+        // Small values: bucket index is the value itself (exact)
+        return static_cast<size_t>(latency_ns);
+    }
+
+    // Major bucket = floor(log2), sub-bucket = next SUB_BUCKET_BITS bits
+    size_t exp = 63 - static_cast<size_t>(__builtin_clzll(latency_ns));
+    size_t sub = (latency_ns >> (exp - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return exp * SUB_BUCKETS + sub;
+}
+
+double MetricsCollector::bucketMidpointMs(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<double>(bucket) / 1e6;
+    }
+
+    size_t exp = bucket / SUB_BUCKETS;
+    size_t sub = bucket % SUB_BUCKETS;
+
+    // Bucket spans [lower, lower + width); report the midpoint
+    double lower = std::ldexp(1.0 + static_cast<double>(sub) / SUB_BUCKETS,
+                              static_cast<int>(exp));
+    double width = std::ldexp(1.0 / SUB_BUCKETS, static_cast<int>(exp));
+    return (lower + width * 0.5) / 1e6;
+}
+
 void MetricsCollector::recordRequest() {
-    total_requests_.fetch_add(1, std::memory_order_relaxed);
+    localShard().total_requests.fetch_add(1, std::memory_order_relaxed);
 }
 
 void MetricsCollector::recordCompletion(double latency_ms) {
-    completed_requests_.fetch_add(1, std::memory_order_relaxed);
+    Shard& shard = localShard();
+
+    shard.completed_requests.fetch_add(1, std::memory_order_relaxed);
 
     // Convert to nanoseconds for precision
     uint64_t latency_ns = static_cast<uint64_t>(latency_ms * 1000000.0);
-    sum_latency_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+    shard.sum_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
 
-    // Store sample for percentile calculation
-    {
-        std::lock_guard<std::mutex> lock(samples_mutex_);
-        latency_samples_.push_back(latency_ms);
-
-        // Keep only recent samples (rolling window)
-        if (latency_samples_.size() > MAX_SAMPLES) {
-            latency_samples_.erase(latency_samples_.begin());
-        }
-    }
-
-    // Update throughput counter
-    {
-        std::lock_guard<std::mutex> lock(throughput_mutex_);
-        throughput_requests_++;
-    }
+    shard.histogram[bucketFor(latency_ns)].fetch_add(1, std::memory_order_relaxed);
 }
 
 void MetricsCollector::recordFailure() {
-    failed_requests_.fetch_add(1, std::memory_order_relaxed);
+    localShard().failed_requests.fetch_add(1, std::memory_order_relaxed);
 }
 
 MetricsCollector::Metrics MetricsCollector::getMetrics() const {
     Metrics m;
 
-    m.total_requests = total_requests_.load(std::memory_order_relaxed);
-    m.completed_requests = completed_requests_.load(std::memory_order_relaxed);
-    m.failed_requests = failed_requests_.load(std::memory_order_relaxed);
+    // Merge shard counters and histograms (reader-side cost only)
+    uint64_t total = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t sum_ns = 0;
+    std::array<uint64_t, NUM_BUCKETS> merged{};
+
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        const Shard& shard = shardAt(s);
+        total += shard.total_requests.load(std::memory_order_relaxed);
+        completed += shard.completed_requests.load(std::memory_order_relaxed);
+        failed += shard.failed_requests.load(std::memory_order_relaxed);
+        sum_ns += shard.sum_latency_ns.load(std::memory_order_relaxed);
+
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            merged[b] += shard.histogram[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    m.total_requests = total;
+    m.completed_requests = completed;
+    m.failed_requests = failed;
 
     // Calculate average latency
-    if (m.completed_requests > 0) {
-        uint64_t sum_ns = sum_latency_ns_.load(std::memory_order_relaxed);
-        m.avg_latency_ms = static_cast<double>(sum_ns) / 1000000.0 / m.completed_requests;
+    if (completed > 0) {
+        m.avg_latency_ms = static_cast<double>(sum_ns) / 1000000.0 / completed;
     } else {
         m.avg_latency_ms = 0.0;
     }
 
-    // Calculate percentiles
-    {
-        std::lock_guard<std::mutex> lock(samples_mutex_);
-
-        if (!latency_samples_.empty()) {
-            std::vector<double> sorted = latency_samples_;
-            std::sort(sorted.begin(), sorted.end());
-
-            auto percentile = [&sorted](double p) -> double {
-                size_t idx = static_cast<size_t>(sorted.size() * p);
-                if (idx >= sorted.size()) idx = sorted.size() - 1;
-                return sorted[idx];
-            };
-
-            m.p50_latency_ms = percentile(0.50);
-            m.p95_latency_ms = percentile(0.95);
-            m.p99_latency_ms = percentile(0.99);
-        } else {
-            m.p50_latency_ms = 0.0;
-            m.p95_latency_ms = 0.0;
-            m.p99_latency_ms = 0.0;
-        }
+    // Percentiles: walk the merged histogram to the target rank
+    if (completed > 0) {
+        auto percentile = [&merged, completed](double p) -> double {
+            uint64_t rank = static_cast<uint64_t>(
+                std::ceil(p * static_cast<double>(completed)));
+            if (rank == 0) rank = 1;
+
+            uint64_t seen = 0;
+            for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+                seen += merged[b];
+                if (seen >= rank) {
+                    return bucketMidpointMs(b);
+                }
+            }
+            return bucketMidpointMs(NUM_BUCKETS - 1);
+        };
+
+        m.p50_latency_ms = percentile(0.50);
+        m.p95_latency_ms = percentile(0.95);
+        m.p99_latency_ms = percentile(0.99);
+    } else {
+        m.p50_latency_ms = 0.0;
+        m.p95_latency_ms = 0.0;
+        m.p99_latency_ms = 0.0;
     }
 
-    // Calculate throughput (requests per second)
-    {
-        std::lock_guard<std::mutex> lock(throughput_mutex_);
-
-        uint64_t now_ns = duration_cast<nanoseconds>(
-            system_clock::now().time_since_epoch()).count();
-
-        double window_sec = static_cast<double>(now_ns - throughput_window_start_ns_) / 1e9;
+    // Calculate throughput (completions per second over the window)
+    uint64_t window_start = throughput_window_start_ns_.load(std::memory_order_relaxed);
+    double window_sec = static_cast<double>(nowNs() - window_start) / 1e9;
 
-        if (window_sec > 0.0) {
-            m.throughput_rps = throughput_requests_ / window_sec;
-        } else {
-            m.throughput_rps = 0.0;
-        }
+    if (window_sec > 0.0) {
+        m.throughput_rps = static_cast<double>(completed) / window_sec;
+    } else {
+        m.throughput_rps = 0.0;
     }
 
     return m;
 }
 
 void MetricsCollector::reset() {
-    total_requests_.store(0, std::memory_order_relaxed);
-    completed_requests_.store(0, std::memory_order_relaxed);
-    failed_requests_.store(0, std::memory_order_relaxed);
-    sum_latency_ns_.store(0, std::memory_order_relaxed);
-
-    {
-        std::lock_guard<std::mutex> lock(samples_mutex_);
-        latency_samples_.clear();
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        Shard& shard = shards_[s];
+        shard.total_requests.store(0, std::memory_order_relaxed);
+        shard.completed_requests.store(0, std::memory_order_relaxed);
+        shard.failed_requests.store(0, std::memory_order_relaxed);
+        shard.sum_latency_ns.store(0, std::memory_order_relaxed);
+
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            shard.histogram[b].store(0, std::memory_order_relaxed);
+        }
     }
 
-    {
-        std::lock_guard<std::mutex> lock(throughput_mutex_);
-        throughput_window_start_ns_ = duration_cast<nanoseconds>(
-            system_clock::now().time_since_epoch()).count();
-        throughput_requests_ = 0;
-    }
+    throughput_window_start_ns_.store(nowNs(), std::memory_order_relaxed);
 }
 
 } // namespace krserve
@@ -0,0 +1,172 @@
+// Freelist lifecycle test for StreamContextPool
+//
+// Exercises warm construction, freelist hit/miss accounting, O(1)
+// reset between streams (arena recycling, counter zeroing), never-
+// reused stream ids, the max_pooled_contexts drop path, and scratch
+// array sizing. Runs without a tokenizer attached — the decoder
+// handoff is covered by the tokenizer's own pooling.
+
+#include "../include/kr_stream_context_pool.h"
+
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::cerr << "FAIL " << __FILE__ << ":" << __LINE__            \
+                      << ": " << #cond << std::endl;                       \
+            ++failures;                                                    \
+        }                                                                  \
+    } while (0)
+
+void testWarmStartAndHits() {
+    krserve::StreamContextPool::Config config;
+    config.vocab_size = 1024;
+    config.initial_contexts = 2;
+    config.max_pooled_contexts = 8;
+
+    krserve::StreamContextPool pool(config);
+    CHECK(pool.pooledCount() == 2);
+
+    // Two warm acquires hit the freelist; a third constructs
+    auto a = pool.acquireContext();
+    auto b = pool.acquireContext();
+    auto c = pool.acquireContext();
+    CHECK(a && b && c);
+    CHECK(pool.pooledCount() == 0);
+
+    auto stats = pool.getStatistics();
+    CHECK(stats.contexts_created == 3);  // 2 warm + 1 miss
+    CHECK(stats.acquires == 3);
+    CHECK(stats.freelist_hits == 2);
+    CHECK(stats.contexts_active == 3);
+
+    // No decoder without a tokenizer; scratch is vocab-sized
+    CHECK(a->decoder() == nullptr);
+    CHECK(a->samplingScratchSize() == config.vocab_size);
+    CHECK(a->samplingScratch() != nullptr);
+
+    pool.releaseContext(std::move(a));
+    pool.releaseContext(std::move(b));
+    pool.releaseContext(std::move(c));
+
+    stats = pool.getStatistics();
+    CHECK(stats.releases == 3);
+    CHECK(stats.contexts_pooled == 3);
+    CHECK(stats.contexts_active == 0);
+    CHECK(stats.getHitRate() > 0.6 && stats.getHitRate() < 0.7);  // 2/3
+}
+
+void testResetBetweenStreams() {
+    krserve::StreamContextPool::Config config;
+    config.vocab_size = 256;
+    config.initial_contexts = 1;
+
+    krserve::StreamContextPool pool(config);
+
+    auto ctx = pool.acquireContext();
+    const uint64_t first_id = ctx->streamId();
+    CHECK(first_id != 0);
+
+    ctx->recordTokens(17);
+    ctx->recordTokens(3);
+    CHECK(ctx->tokensGenerated() == 20);
+
+    void* block = ctx->arena().allocate(4096);
+    CHECK(block != nullptr);
+    std::memset(block, 0xAB, 4096);
+    CHECK(ctx->arena().bytesAllocated() >= 4096);
+
+    pool.releaseContext(std::move(ctx));
+
+    // Same pooled object comes back wiped, under a fresh id
+    auto reused = pool.acquireContext();
+    CHECK(reused->streamId() > first_id);  // Ids are never reused
+    CHECK(reused->tokensGenerated() == 0);
+    CHECK(reused->arena().bytesAllocated() == 0);
+
+    auto stats = pool.getStatistics();
+    CHECK(stats.contexts_created == 1);  // One context served both streams
+    CHECK(stats.freelist_hits == 2);
+    pool.releaseContext(std::move(reused));
+}
+
+void testUniqueStreamIds() {
+    krserve::StreamContextPool pool;
+
+    std::set<uint64_t> ids;
+    for (int round = 0; round < 4; ++round) {
+        std::vector<std::shared_ptr<krserve::StreamContext>> held;
+        for (int i = 0; i < 16; ++i) {
+            auto ctx = pool.acquireContext();
+            CHECK(ids.insert(ctx->streamId()).second);  // Globally unique
+            held.push_back(std::move(ctx));
+        }
+        for (auto& ctx : held) {
+            pool.releaseContext(std::move(ctx));
+        }
+    }
+    CHECK(ids.size() == 64);
+}
+
+void testDropBeyondMaxPooled() {
+    krserve::StreamContextPool::Config config;
+    config.vocab_size = 128;
+    config.max_pooled_contexts = 2;
+
+    krserve::StreamContextPool pool(config);
+
+    std::vector<std::shared_ptr<krserve::StreamContext>> held;
+    for (int i = 0; i < 5; ++i) {
+        held.push_back(pool.acquireContext());
+    }
+    for (auto& ctx : held) {
+        pool.releaseContext(std::move(ctx));
+    }
+
+    // Freelist keeps two; the other three are freed
+    CHECK(pool.pooledCount() == 2);
+    auto stats = pool.getStatistics();
+    CHECK(stats.contexts_dropped == 3);
+    CHECK(stats.contexts_pooled == 2);
+}
+
+void testStatisticsReset() {
+    krserve::StreamContextPool pool;
+
+    auto ctx = pool.acquireContext();
+    pool.releaseContext(std::move(ctx));
+    pool.resetStatistics();
+
+    auto stats = pool.getStatistics();
+    CHECK(stats.acquires == 0);
+    CHECK(stats.releases == 0);
+    CHECK(stats.freelist_hits == 0);
+    CHECK(stats.getHitRate() == 0.0);
+    CHECK(stats.contexts_pooled == 1);  // Gauges survive the reset
+}
+
+} // anonymous namespace
+
+int main() {
+    testWarmStartAndHits();
+    testResetBetweenStreams();
+    testUniqueStreamIds();
+    testDropBeyondMaxPooled();
+    testStatisticsReset();
+
+    if (failures == 0) {
+        std::cout << "test_stream_context_pool: all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << "test_stream_context_pool: " << failures
+              << " check(s) failed" << std::endl;
+    return 1;
+}